@@ -113,35 +113,56 @@ void FrameBuffer::renderOutput(IG::MutablePixmapView pix, TIA &tia)
 	assumeExpr(pix.size() == framePix.size());
 	assumeExpr(pix.format().bytesPerPixel() == outputBits / 8);
 	assumeExpr(framePix.format().bytesPerPixel() == 1);
+	using Pixel = std::conditional_t<outputBits == 16, uint16_t, uint32_t>;
+	auto getRGBPhosphor = [this](uInt32 c, uInt32 p)
+	{
+		if constexpr(outputBits == 16)
+			return getRGBPhosphor16(c, p);
+		else
+			return getRGBPhosphor32(c, p);
+	};
 	if(myUsePhosphor)
 	{
-		uint8_t* prevFrame = prevFramebuffer.data();
-		pix.writeTransformed([this, &prevFrame](uint8_t p)
+		// Most pixels don't change between frames, so expand them all as if unchanged
+		// using the fast indexed path, then blend the ones that differ
+		std::array<Pixel, 256> unchangedColorMap;
+		for(auto i : IG::iotaCount(256))
+		{
+			unchangedColorMap[i] = getRGBPhosphor(tiaColorMap32[i], tiaColorMap32[i]);
+		}
+		pix.writeIndexed(unchangedColorMap, framePix);
+		auto destPix = pix.mdspan<Pixel>();
+		auto framePtr = tia.frameBuffer();
+		auto prevFramePtr = prevFramebuffer.data();
+		const int w = framePix.w();
+		for(auto y : IG::iotaCount(framePix.h()))
+		{
+			auto blendPixel = [&](int x)
+			{
+				if(auto c = framePtr[x], p = prevFramePtr[x]; c != p)
+					destPix[y, x] = getRGBPhosphor(tiaColorMap32[c], tiaColorMap32[p]);
+			};
+			int x = 0;
+			for(; x + 8 <= w; x += 8)
 			{
-				if constexpr(outputBits == 16)
-				{
-					return getRGBPhosphor16(tiaColorMap32[p], tiaColorMap32[*prevFrame++]);
-				}
-				else
-				{
-					return getRGBPhosphor32(tiaColorMap32[p], tiaColorMap32[*prevFrame++]);
-				}
-			}, framePix);
+				if(!memcmp(framePtr + x, prevFramePtr + x, 8))
+					continue;
+				for(auto i : IG::iotaCount(8))
+					blendPixel(x + i);
+			}
+			for(; x < w; x++)
+				blendPixel(x);
+			framePtr += w;
+			prevFramePtr += w;
+		}
 		memcpy(prevFramebuffer.data(), tia.frameBuffer(), sizeof(prevFramebuffer));
 	}
 	else
 	{
-		pix.writeTransformed([this](uint8_t p)
-			{
-				if constexpr(outputBits == 16)
-				{
-					return tiaColorMap16[p];
-				}
-				else
-				{
-					return tiaColorMap32[p];
-				}
-			}, framePix);
+		if constexpr(outputBits == 16)
+			pix.writeIndexed(tiaColorMap16, framePix);
+		else
+			pix.writeIndexed(tiaColorMap32, framePix);
 	}
 }
 
@@ -16,7 +16,6 @@
 #define LOGTAG "main"
 #include <emuframework/EmuAppInlines.hh>
 #include <emuframework/EmuSystemInlines.hh>
-#include <imagine/thread/Semaphore.hh>
 #include <imagine/gui/AlertView.hh>
 #include <imagine/util/format.hh>
 #include <imagine/util/string.h>
@@ -82,17 +81,16 @@ C64App::C64App(ApplicationInitParams initParams, ApplicationContext &ctx):
 }
 
 C64System::C64System(ApplicationContext ctx):
-	EmuSystem{ctx}
-{
-	makeDetachedThread(
+	EmuSystem{ctx},
+	viceFiber
+	{
 		[this]()
 		{
-			emuThreadId = thisThreadId();
-			execSem.acquire();
 			log.info("starting maincpu_mainloop()");
 			plugin.maincpu_mainloop();
-		});
-
+		}
+	}
+{
 	if(sysFilePath.size() == 3)
 	{
 		sysFilePath[1] = "~/.local/share/C64.emu";
@@ -220,21 +218,29 @@ FS::FileString C64System::stateFilename(int slot, std::string_view name) const
 	return IG::format<FS::FileString>("{}.{}.vsf", name, saveSlotChar(slot));
 }
 
+// The fiber's stack must only ever run on one thread, so resumes from the main or
+// loader threads are forwarded to the emulation thread
+void C64System::resumeVice()
+{
+	assert(!viceFiber.isRunning());
+	EmuApp::get(appContext()).runOnEmuThread([this]{ viceFiber.resume(); });
+}
+
 void C64System::enterCPUTrap()
 {
-	assert(emuThreadId);
+	assert(viceFiber);
 	if(inCPUTrap)
 		return;
 	plugin.interrupt_maincpu_trigger_trap([](uint16_t, void *data)
 	{
 		auto &sys = *((C64System*)data);
 		sys.inCPUTrap = true;
-		sys.signalEmuTaskThreadAndWait();
+		sys.yieldFromVice();
 		sys.inCPUTrap = false;
 	}, (void*)this);
 	while(!inCPUTrap)
 	{
-		signalViceThreadAndWait();
+		resumeVice();
 	}
 }
 
@@ -295,14 +301,14 @@ size_t C64System::stateSize()
 
 void C64System::readState(EmuApp &app, std::span<uint8_t> buff)
 {
-	signalViceThreadAndWait();
+	resumeVice();
 	enterCPUTrap();
 	plugin.vsync_set_warp_mode(0);
 	SnapshotData data{.buffData = buff.data(), .buffSize = buff.size()};
 	if(!loadSnapshot(plugin, data))
 		throw std::runtime_error("Invalid state data");
 	// reload snapshot in case last load caused a reboot due to model change
-	signalViceThreadAndWait();
+	resumeVice();
 	enterCPUTrap();
 	if(!loadSnapshot(plugin, data))
 		throw std::runtime_error("Invalid state data");
@@ -495,7 +501,7 @@ void C64System::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio
 {
 	audioPtr = audio;
 	setCanvasSkipFrame(!video);
-	signalViceThreadAndWait();
+	resumeVice();
 	if(video)
 	{
 		video->startFrameWithAltFormat(taskCtx, canvasSrcPix);
@@ -16,9 +16,8 @@
 	along with C64.emu.  If not, see <http://www.gnu.org/licenses/> */
 
 #include "VicePlugin.hh"
-#include <imagine/thread/Semaphore.hh>
 #include <imagine/pixmap/Pixmap.hh>
-#include <imagine/thread/Thread.hh>
+#include <imagine/thread/Fiber.hh>
 #include <imagine/fs/FS.hh>
 #include <imagine/fs/ArchiveFS.hh>
 #include <emuframework/EmuSystem.hh>
@@ -120,19 +119,17 @@ class C64System final: public EmuSystem
 {
 public:
 	double systemFrameRate{60.};
-	std::binary_semaphore execSem{0}, execDoneSem{0};
 	EmuAudio *audioPtr{};
 	struct video_canvas_s *activeCanvas{};
 	const char *sysFileDir{};
-	ThreadId emuThreadId{};
 	VicePlugin plugin{};
+	Fiber viceFiber; // runs maincpu_mainloop() on the emulation thread until the next vsync or trap
 	mutable ArchiveIO firmwareArch;
 	std::string defaultPaletteName{};
 	std::string lastMissingSysFile;
 	IG::PixmapView canvasSrcPix{};
 	PixelFormat pixFmt{};
 	ViceSystem currSystem{};
-	bool viceThreadSignaled{};
 	bool inCPUTrap{};
 	Property<JoystickMode, CFGKEY_DEFAULT_JOYSTICK_MODE,
 		PropertyDesc<JoystickMode>{.defaultValue = JoystickMode::Port2}> defaultJoystickMode;
@@ -202,26 +199,16 @@ public:
 	ArchiveIO &firmwareArchive(CStringView path) const;
 	void setSystemFilesPath(CStringView path, FS::file_type);
 	void enterCPUTrap();
+	void resumeVice();
 
-	void signalViceThreadAndWait()
+	bool yieldFromVice()
 	{
-		assert(!viceThreadSignaled);
-		viceThreadSignaled = true;
-		execSem.release();
-		execDoneSem.acquire();
-	}
-
-	bool signalEmuTaskThreadAndWait()
-	{
-		if(!viceThreadSignaled)
+		if(!viceFiber.isRunning())
 			return false;
-		viceThreadSignaled = false;
-		execDoneSem.release();
-		execSem.acquire();
+		viceFiber.yield();
 		return true;
 	}
 
-
 	// required API functions
 	void loadContent(IO &, EmuSystemCreateParams, OnLoadProgressDelegate);
 	[[gnu::hot]] void runFrame(EmuSystemTaskContext task, EmuVideo *video, EmuAudio *audio);
@@ -252,7 +239,6 @@ public:
 	void renderFramebuffer(EmuVideo &);
 	bool shouldFastForward() const;
 	bool onVideoRenderFormatChange(EmuVideo &, PixelFormat);
-	void addThreadGroupIds(std::vector<ThreadId> &ids) const { ids.emplace_back(emuThreadId); }
 
 protected:
 	void initC64(EmuApp &app);
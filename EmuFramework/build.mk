@@ -1,6 +1,8 @@
 include $(IMAGINE_PATH)/make/imagineStaticLibBase.mk
 
 SRC += \
+ArchiveCache.cc \
+AudioResampler.cc \
 AutosaveManager.cc \
 ConfigFile.cc \
 EmuApp.cc \
@@ -12,6 +14,8 @@ EmuSystemTask.cc \
 EmuTiming.cc \
 EmuVideo.cc \
 EmuVideoLayer.cc \
+FrameTimeRecorder.cc \
+HeadlessBenchmark.cc \
 InputDeviceConfig.cc \
 InputDeviceData.cc \
 KeyConfig.cc \
@@ -19,6 +23,8 @@ OutputTimingManager.cc \
 pathUtils.cc \
 RecentContent.cc \
 RewindManager.cc \
+StateCodec.cc \
+StateWriter.cc \
 ToggleInput.cc \
 TurboInput.cc \
 VideoImageEffect.cc \
@@ -0,0 +1,67 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	EmuFramework is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	EmuFramework is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/base/ApplicationContext.hh>
+#include <imagine/io/IO.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <imagine/util/DelegateFunc.hh>
+#include <imagine/util/string/CStringView.hh>
+#include <cstdint>
+#include <string_view>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+struct ArchiveCacheEntry
+{
+	IO io;
+	FS::FileString name;
+
+	explicit operator bool() const { return bool(io); }
+};
+
+// Keeps extracted archive entries in the app's cache directory so re-opening the same archive
+// maps the file directly instead of decompressing it again. Entries are keyed by the archive's
+// path, size, & modification time plus the entry name, and the least recently used ones are
+// removed once the total size goes over maxSize. An index per archive records its file names in
+// order so a cache hit resolves to the same entry as scanning the archive.
+class ArchiveCache
+{
+public:
+	using EntryFilter = DelegateFunc<bool(std::string_view name)>;
+	static constexpr uint64_t defaultMaxSize = 1024 * 1024 * 1024;
+
+	ArchiveCache(ApplicationContext, uint64_t maxSize = defaultMaxSize);
+
+	// Returns the first regular file in the archive accepted by filter, extracting it
+	// to the cache if needed, or an empty entry if none match. archive may be an already
+	// opened IO of the file at path.
+	ArchiveCacheEntry openEntry(CStringView path, EntryFilter filter, IO archive = {});
+
+private:
+	ApplicationContext ctx;
+	FS::PathString dir;
+	uint64_t maxSize;
+
+	ArchiveCacheEntry extractEntry(CStringView path, IO archive, std::string_view keyPrefix,
+		CStringView indexPath, size_t indexedNames, EntryFilter);
+	void trim(uint64_t reserveSize);
+};
+
+}
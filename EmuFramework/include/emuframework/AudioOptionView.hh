@@ -42,13 +42,16 @@ protected:
 	TextMenuItem soundBuffersItem[7];
 	MultiChoiceMenuItem soundBuffers;
 	BoolMenuItem addSoundBuffersOnUnderrun;
+	BoolMenuItem dynamicRateControl;
 	StaticArrayList<TextMenuItem, 5> audioRateItem;
 	MultiChoiceMenuItem audioRate;
+	TextMenuItem resamplerQualityItem[3];
+	MultiChoiceMenuItem resamplerQuality;
 	ConditionalMember<IG::Audio::Manager::HAS_SOLO_MIX, BoolMenuItem> audioSoloMix;
 	using ApiItemContainer = StaticArrayList<TextMenuItem, Audio::systemApis.size() + 1>;
 	ConditionalMember<IG::Audio::Config::MULTIPLE_SYSTEM_APIS, ApiItemContainer> apiItem;
 	ConditionalMember<IG::Audio::Config::MULTIPLE_SYSTEM_APIS, MultiChoiceMenuItem> api;
-	StaticArrayList<MenuItem*, 22> item;
+	StaticArrayList<MenuItem*, 24> item;
 };
 
 }
@@ -0,0 +1,70 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/audio/Format.hh>
+#include <imagine/util/enum.hh>
+#include <array>
+#include <vector>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+WISE_ENUM_CLASS((AudioResamplerQuality, uint8_t),
+	Low,
+	Medium,
+	High);
+
+// Converts interleaved i16/f32 frames by an arbitrary ratio, keeping the
+// input history and phase between calls so consecutive blocks join smoothly.
+// Low uses linear interpolation, Medium cubic, and High a 16-tap windowed sinc.
+class AudioResampler
+{
+public:
+	static constexpr int maxTaps = 16;
+
+	AudioResampler() { reset(); }
+	// srcStep is the number of source frames consumed per destination frame
+	size_t resample(void *dest, size_t maxDestFrames, const void *src, size_t srcFrames, double srcStep, Audio::Format);
+	// records frames that were output without resampling so the next resample() continues from them
+	void prime(const void *src, size_t srcFrames, Audio::Format);
+	void reset();
+	void setQuality(AudioResamplerQuality);
+	AudioResamplerQuality quality() const { return quality_; }
+	// true once resample() has run since the last reset, after which the input has a
+	// fixed delay and must keep going through the resampler to avoid discontinuities
+	bool isActive() const { return active; }
+
+private:
+	std::array<std::vector<float>, 2> chanBuff;
+	std::vector<float> sincTable;
+	double pos{};
+	float sincCutoff{};
+	AudioResamplerQuality quality_{AudioResamplerQuality::Medium};
+	int8_t channels{};
+	bool active{};
+
+	int taps() const;
+	void setChannels(int8_t);
+	void appendInput(const void *src, size_t srcFrames, Audio::Format);
+	void consumeInput(size_t srcFrames);
+	void updateSincTable(float cutoff);
+	const float *coeffsForPhase(float frac, float *coeffs) const;
+};
+
+}
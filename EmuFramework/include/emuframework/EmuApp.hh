@@ -27,6 +27,9 @@
 #include <emuframework/OutputTimingManager.hh>
 #include <emuframework/RecentContent.hh>
 #include <emuframework/RewindManager.hh>
+#include <emuframework/StateWriter.hh>
+#include <emuframework/HeadlessBenchmark.hh>
+#include <emuframework/FrameTimeRecorder.hh>
 #include <imagine/input/inputDefs.hh>
 #include <imagine/gui/ViewManager.hh>
 #include <imagine/gui/ToastView.hh>
@@ -196,8 +199,8 @@ public:
 	void readState(std::span<uint8_t> buff);
 	size_t writeState(std::span<uint8_t> buff, SaveStateFlags = {});
 	DynArray<uint8_t> saveState();
-	bool saveState(CStringView path);
-	bool saveStateWithSlot(int slot);
+	bool saveState(CStringView path, StateCompression, bool notify = false);
+	bool saveStateWithSlot(int slot, StateCompression, bool notify = false);
 	bool loadState(CStringView path);
 	bool loadStateWithSlot(int slot);
 	bool shouldOverwriteExistingState() const;
@@ -219,6 +222,7 @@ public:
 	bool hasSavedSessionOptions();
 	void deleteSessionOptions();
 	void syncEmulationThread();
+	int runHeadlessBenchmark(const HeadlessBenchmarkParams &);
 	void startAudio();
 	EmuViewController &viewController();
 	const EmuViewController &viewController() const;
@@ -255,6 +259,7 @@ public:
 	IG::Viewport makeViewport(const Window &win) const;
 	void setEmuViewOnExtraWindow(bool on, IG::Screen &);
 	void record(FrameTimeStatEvent, SteadyClockTimePoint t = {});
+	bool exportFrameTimeRecord();
 	void setIntendedFrameRate(Window &, FrameTimeConfig);
 	static std::u16string_view mainViewName();
 	void runBenchmarkOneShot(EmuVideo &);
@@ -267,6 +272,7 @@ public:
 	ApplicationContext appContext() const { return system().appContext(); }
 	static EmuApp &get(ApplicationContext);
 	MainWindowData &mainWindowData() const;
+	void runOnEmuThread(DelegateFunc<void()> func) { emuSystemTask.run(func); }
 
 	// Video Options
 	bool setWindowDrawableConfig(Gfx::DrawableConfig);
@@ -358,10 +364,12 @@ public:
 	EmuVideo video;
 	EmuVideoLayer videoLayer;
 	AutosaveManager autosaveManager{*this};
+	StateWriter stateWriter{*this};
 	InputManager inputManager;
 	OutputTimingManager outputTimingManager;
 	RewindManager rewindManager{*this};
 	ConditionalMember<enableFrameTimeStats, FrameTimeStats> frameTimeStats;
+	ConditionalMember<enableFrameTimeStats, FrameTimeRecorder> frameTimeRecorder;
 	[[no_unique_address]] IG::VibrationManager vibrationManager;
 protected:
 	EmuSystemTask emuSystemTask{*this};
@@ -15,6 +15,7 @@
 	You should have received a copy of the GNU General Public License
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
+#include <emuframework/AudioResampler.hh>
 #include <imagine/audio/OutputStream.hh>
 #include <imagine/audio/Manager.hh>
 #include <imagine/time/Time.hh>
@@ -45,6 +46,9 @@ struct AudioFlags
 
 constexpr AudioFlags defaultAudioFlags{.enabled = 1, .enabledDuringAltSpeed = 1};
 
+// max deviation from the nominal rate applied by dynamic rate control
+constexpr double maxRateControlDelta = .005;
+
 class EmuAudio
 {
 public:
@@ -59,6 +63,8 @@ public:
 	EmuAudio(IG::ApplicationContext);
 	void open();
 	void start(FloatSeconds bufferDuration);
+	void startHeadless(FloatSeconds bufferDuration);
+	void discardFrames();
 	void stop();
 	void close();
 	void flush();
@@ -73,10 +79,13 @@ public:
 	int8_t maxVolume() const { return std::round(maxVolume_ * 100.f); }
 	void setOutputAPI(IG::Audio::Api);
 	IG::Audio::Api outputAPI() const { return audioAPI; }
+	void setResamplerQuality(AudioResamplerQuality q) { resampler.setQuality(q); }
+	AudioResamplerQuality resamplerQuality() const { return resampler.quality(); }
 	void setEnabled(bool on);
 	bool isEnabled() const;
 	void setEnabledDuringAltSpeed(bool on);
 	bool isEnabledDuringAltSpeed() const;
+	unsigned underruns() const { return underrunCount; }
 	IG::Audio::Format format() const;
 	explicit operator bool() const { return bool(rBuff); }
 	void writeConfig(FileIO &) const;
@@ -86,6 +95,7 @@ public:
 protected:
 	IG::Audio::OutputStream audioStream;
 	RingBuffer rBuff;
+	AudioResampler resampler;
 	SteadyClockTimePoint lastUnderrunTime{};
 	double speedMultiplier{1.};
 	size_t targetBufferFillBytes{};
@@ -95,12 +105,14 @@ protected:
 	float maxVolume_{1.};
 	float currentVolume{1.};
 	std::atomic<AudioWriteState> audioWriteState{AudioWriteState::BUFFER};
+	std::atomic_uint underrunCount{};
 	int8_t channels{2};
 	AudioFlags flags{defaultAudioFlags};
 	ConditionalMember<IG::Audio::Config::MULTIPLE_SYSTEM_APIS, IG::Audio::Api> audioAPI{};
 	bool addSoundBuffersOnUnderrun{};
 public:
 	bool addSoundBuffersOnUnderrunSetting{};
+	bool dynamicRateControl{};
 	int8_t defaultSoundBuffers{3};
 	int8_t soundBuffers{defaultSoundBuffers};
 
@@ -108,6 +120,7 @@ public:
 	size_t framesWritten() const;
 	size_t framesCapacity() const;
 	bool shouldStartAudioWrites(size_t bytesToWrite = 0) const;
+	double rateControlFactor() const;
 	void resizeAudioBuffer(size_t targetBufferFillBytes);
 	void updateVolume();
 	void updateAddBuffersOnUnderrun();
@@ -141,6 +141,7 @@ constexpr const char *optionUserPathContentToken = ":CONTENT:";
 struct SaveStateFlags
 {
 	uint8_t uncompressed:1{};
+	uint8_t compressionLevel:4{}; // 0 uses the system's default
 };
 
 class EmuSystem
@@ -199,6 +200,7 @@ public:
 	static F2Size validFrameRateRange;
 	static bool hasRectangularPixels;
 	static bool stateSizeChangesAtRuntime;
+	static bool handlesCompressedStates;
 
 	EmuSystem(IG::ApplicationContext ctx): appCtx{ctx} {}
 
@@ -246,12 +248,14 @@ public:
 	FS::FileString contentDisplayNameForPath(CStringView path) const;
 	IG::Rotation contentRotation() const;
 	void addThreadGroupIds(std::vector<ThreadId> &) const;
+	FrameTime helperThreadFrameTime() const;
 
 	ApplicationContext appContext() const { return appCtx; }
 	bool isActive() const { return state == State::ACTIVE; }
 	bool isStarted() const { return state == State::ACTIVE || state == State::PAUSED; }
 	bool isPaused() const { return state == State::PAUSED; }
 	void loadState(EmuApp &, CStringView uri);
+	void loadState(EmuApp &, std::span<uint8_t> buff);
 	void saveState(CStringView uri);
 	DynArray<uint8_t> saveState();
 	DynArray<uint8_t> uncompressGzipState(std::span<uint8_t> buff, size_t expectedSize = 0);
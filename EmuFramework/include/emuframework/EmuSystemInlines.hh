@@ -196,6 +196,10 @@ void EmuSystem::closeSystem()
 
 void EmuSystem::runFrame(EmuSystemTaskContext task, EmuVideo *video, EmuAudio *audio)
 {
+	// cores may check either the render-skip flag or a null video pointer
+	task.skipRender |= !video;
+	if(task.skipRender)
+		video = nullptr;
 	static_cast<MainSystem*>(this)->runFrame(task, video, audio);
 }
 
@@ -280,4 +284,11 @@ void EmuSystem::addThreadGroupIds(std::vector<ThreadId> &ids) const
 		static_cast<const MainSystem*>(this)->addThreadGroupIds(ids);
 }
 
+FrameTime EmuSystem::helperThreadFrameTime() const
+{
+	if(&MainSystem::helperThreadFrameTime != &EmuSystem::helperThreadFrameTime)
+		return static_cast<const MainSystem*>(this)->helperThreadFrameTime();
+	return {};
+}
+
 }
@@ -16,9 +16,13 @@
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
 #include <imagine/base/MessagePort.hh>
+#include <imagine/base/CustomEvent.hh>
 #include <imagine/thread/Thread.hh>
+#include <imagine/thread/SPSCQueue.hh>
 #include <imagine/time/Time.hh>
+#include <imagine/util/DelegateFunc.hh>
 #include <variant>
+#include <atomic>
 
 namespace EmuEx
 {
@@ -32,16 +36,14 @@ class EmuApp;
 class EmuSystemTask
 {
 public:
-	struct FrameParamsCommand
-	{
-		FrameParams params;
-	};
-
-	struct FramePresentedCommand {};
 	struct PauseCommand {};
 	struct ExitCommand {};
+	struct RunCommand
+	{
+		DelegateFunc<void()> func;
+	};
 
-	using CommandVariant = std::variant<FrameParamsCommand, FramePresentedCommand, PauseCommand, ExitCommand>;
+	using CommandVariant = std::variant<PauseCommand, ExitCommand, RunCommand>;
 
 	struct CommandMessage
 	{
@@ -55,6 +57,7 @@ public:
 	void start();
 	void pause();
 	void stop();
+	void run(DelegateFunc<void()>);
 	void updateFrameParams(FrameParams);
 	void notifyFramePresented();
 	void sendVideoFormatChangedReply(EmuVideo &);
@@ -65,9 +68,21 @@ public:
 private:
 	EmuApp &app;
 	MessagePort<CommandMessage> commandPort{"EmuSystemTask Command"};
+	// Per-frame updates skip the command pipe, the producer only signals
+	// frameEvent if the task thread is blocked in its event loop
+	SPSCQueue<FrameParams, 16> frameParamsQueue;
+	CustomEvent frameEvent{"EmuSystemTask Frame Event"};
+	std::atomic_bool framePresented{};
+	std::atomic_bool isWaiting{};
 	std::thread taskThread;
 	ThreadId threadId_{};
 	FrameParams frameParams;
+
+	void runFrameCommands();
+	bool processFrameCommands();
+	bool hasFrameCommands();
+	bool spinForFrameCommands();
+	void wakeIfWaiting();
 public:
 	bool framePending{};
 };
@@ -26,6 +26,9 @@ class EmuSystemTaskContext
 {
 public:
 	EmuSystemTask *taskPtr{};
+	// Set when the frame's video output won't be used, like while fast-forwarding.
+	// Cores should skip pixel output but keep any state that affects emulation timing.
+	bool skipRender{};
 
 	constexpr EmuSystemTask &task() { return *taskPtr; }
 	constexpr operator bool() const { return taskPtr; }
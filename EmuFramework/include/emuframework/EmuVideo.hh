@@ -20,6 +20,7 @@
 #include <emuframework/EmuSystemTaskContext.hh>
 #include <imagine/gfx/PixmapBufferTexture.hh>
 #include <imagine/gfx/SyncFence.hh>
+#include <imagine/pixmap/MemPixmap.hh>
 #include <optional>
 
 namespace EmuEx
@@ -53,6 +54,8 @@ public:
 	constexpr EmuVideo() = default;
 	void setRendererTask(Gfx::RendererTask &);
 	bool hasRendererTask() const;
+	void setHeadless(EmuSystem &, IG::PixelFormat);
+	bool isHeadless() const { return headless; }
 	bool setFormat(IG::PixmapDesc desc, EmuSystemTaskContext task = {});
 	void dispatchFormatChanged();
 	void resetImage(IG::PixelFormat newFmt = {});
@@ -63,6 +66,8 @@ public:
 	void startFrameWithFormat(EmuSystemTaskContext, IG::PixmapView pix);
 	void startFrameWithAltFormat(EmuSystemTaskContext, IG::PixmapView pix);
 	void startUnchangedFrame(EmuSystemTaskContext);
+	MutablePixmapView startDirectFrame(EmuSystemTaskContext, IG::PixmapDesc desc);
+	void endDirectFrame();
 	void finishFrame(EmuSystemTaskContext, Gfx::LockedTextureBuffer texBuff);
 	void finishFrame(EmuSystemTaskContext, IG::PixmapView pix);
 	void dispatchFrameFinished();
@@ -88,6 +93,8 @@ public:
 protected:
 	Gfx::RendererTask *rTask{};
 	Gfx::PixmapBufferTexture vidImg;
+	Gfx::LockedTextureBuffer directTexBuff; // held while a core renders directly into the texture
+	MemPixmap headlessImg; // frames are rendered here when there's no renderer
 	FrameFinishedDelegate onFrameFinished;
 	FormatChangedDelegate onFormatChanged;
 	IG::PixelFormat renderFmt;
@@ -95,9 +102,11 @@ protected:
 	bool screenshotNextFrame{};
 	Gfx::ColorSpace colSpace{Gfx::ColorSpace::LINEAR};
 	bool useLinearFilter{true};
+	bool headless{};
 
 	void doScreenshot(EmuSystemTaskContext, IG::PixmapView pix);
 	void postFrameFinished(EmuSystemTaskContext);
+	bool isDirectFrame(IG::PixmapView pix) const;
 	Gfx::TextureSamplerConfig samplerConfig() const { return samplerConfigForLinearFilter(useLinearFilter); }
 
 public:
@@ -42,7 +42,8 @@ public:
 	bool hasLayer() const { return layer; }
 	void setLayoutInputView(EmuInputView *view) { inputView = view; }
 	void updateFrameTimeStats(FrameTimeStats, SteadyClockTimePoint currentFrameTimestamp);
-	void updateAudioStats(int underruns, int overruns, int callbacks, double avgCallbackFrames, int frames);
+	void updateAudioStats(int underruns, int overruns, int callbacks, double avgCallbackFrames, int frames,
+		float rateControlFactor, float bufferFill);
 	void clearAudioStats();
 	EmuVideoLayer *videoLayer() const { return layer; }
 	EmuSystem &system() { return *sysPtr; }
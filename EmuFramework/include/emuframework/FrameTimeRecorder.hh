@@ -0,0 +1,58 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/OutputTimingManager.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/util/memory/DynArray.hh>
+#include <string>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+struct FrameTimeRecord
+{
+	FrameTimeStats stats;
+	uint16_t missedFrameCallbacks{};
+	uint16_t audioUnderruns{};
+};
+
+// Keeps the timing events of the most recently presented frames for exporting
+class FrameTimeRecorder
+{
+public:
+	static constexpr size_t defaultCapacity = 8192;
+
+	void start(size_t capacity = defaultCapacity);
+	void stop();
+	bool isActive() const { return records.size(); }
+	void add(FrameTimeStats, unsigned audioUnderruns);
+	size_t size() const { return count; }
+	const FrameTimeRecord &operator[](size_t idx) const;
+	std::string toCSV() const;
+	std::string toTraceEventJSON() const;
+
+private:
+	DynArray<FrameTimeRecord> records;
+	size_t nextIdx{};
+	size_t count{};
+	int lastMissedFrameCallbacks{};
+	unsigned lastAudioUnderruns{};
+};
+
+}
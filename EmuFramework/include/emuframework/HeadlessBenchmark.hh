@@ -0,0 +1,59 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/config.hh>
+#include <imagine/base/BaseApplication.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <imagine/time/Time.hh>
+#include <optional>
+#include <span>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+constexpr int defaultHeadlessBenchmarkFrames = 1800;
+
+// Set from the command line:
+// --benchmark <content path> [--frames <count>] [--state <path>] [--no-video] [--no-audio] [--output <json path>]
+// --benchmark-pixel-conversions [--output <json path>]
+struct HeadlessBenchmarkParams
+{
+	FS::PathString contentPath;
+	FS::PathString statePath;
+	FS::PathString outputPath;
+	int frames{defaultHeadlessBenchmarkFrames};
+	bool video{true};
+	bool audio{true};
+	bool pixelConversions{};
+};
+
+struct FrameTimeSummary
+{
+	FloatSeconds total{};
+	FloatSeconds mean{};
+	FloatSeconds p50{};
+	FloatSeconds p99{};
+	FloatSeconds max{};
+	double fps{};
+};
+
+std::optional<HeadlessBenchmarkParams> parseHeadlessBenchmarkArgs(CommandArgs);
+FrameTimeSummary summarizeFrameTimes(std::span<const SteadyClockTime>);
+
+}
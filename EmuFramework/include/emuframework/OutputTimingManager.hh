@@ -46,6 +46,8 @@ struct FrameTimeStats
 	SteadyClockTimePoint aboutToPresent{};
 	SteadyClockTimePoint endOfDraw{};
 	int missedFrameCallbacks{};
+	int advancedFrames{};
+	Nanoseconds helperThreadTime{}; // time spent by the system's own worker threads, like a video renderer
 };
 
 struct FrameTimeConfig
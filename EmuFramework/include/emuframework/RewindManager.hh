@@ -18,6 +18,12 @@
 #include <emuframework/config.hh>
 #include <imagine/base/PausableTimer.hh>
 #include <imagine/util/memory/FlexArray.hh>
+#include <imagine/util/memory/DynArray.hh>
+#include <imagine/thread/WorkThread.hh>
+#include <imagine/util/enum.hh>
+#include <atomic>
+#include <semaphore>
+#include <vector>
 
 namespace IG
 {
@@ -31,14 +37,26 @@ namespace EmuEx
 using namespace IG;
 
 class EmuApp;
+class EmuSystem;
+class EmuSystemTaskContext;
+class EmuVideo;
+
+WISE_ENUM_CLASS((RewindMode, uint8_t),
+	Full,
+	Delta);
+
+constexpr uint16_t defaultRewindMemoryMB = 64;
+constexpr uint16_t maxRewindMemoryMB = 4096;
 
 class RewindManager
 {
 public:
 	RewindManager(EmuApp &);
+	~RewindManager();
 	void clear();
 	bool reset();
 	void rewindState(EmuApp &);
+	bool rewindFrame(EmuApp &, EmuSystemTaskContext, EmuVideo *);
 	void startTimer();
 	void pauseTimer();
 	void resetTimer();
@@ -51,6 +69,38 @@ public:
 		reset();
 	}
 
+	void updateMode(RewindMode m)
+	{
+		mode = m;
+		reset();
+	}
+
+	void updateMemoryMB(uint16_t mb)
+	{
+		memoryMB = mb;
+		reset();
+	}
+
+	// switches between saving states by frame count (non-zero) & by saveTimer
+	void setFrameInterval(EmuApp &, uint8_t interval);
+	uint8_t frameInterval() const { return frameInterval_.load(std::memory_order::relaxed); }
+
+	bool isEnabled() const { return mode == RewindMode::Delta ? memoryMB : maxStates; }
+	bool hasStorage() const { return mode == RewindMode::Delta ? bool(deltaData.size()) : bool(stateEntries.size()); }
+	void setHeld(bool on) { held.store(on, std::memory_order::relaxed); }
+	bool isHeld() const { return held.load(std::memory_order::relaxed); }
+
+	// called from the emulation thread after running frames when saving states by frame count
+	void addFrames(EmuSystem &sys, int frames)
+	{
+		auto interval = frameInterval();
+		if(!interval || !hasStorage())
+			return;
+		frameCount += frames;
+		if(frameCount >= interval && writeState(sys))
+			frameCount = 0;
+	}
+
 	bool reset(size_t stateSize_)
 	{
 		stateSize = stateSize_;
@@ -64,15 +114,53 @@ private:
 		uint8_t data[];
 	};
 
+	struct DeltaEntry
+	{
+		size_t offset{};
+		size_t size{};
+	};
+
 	FlexArray<StateEntry> stateEntries;
 	size_t stateIdx{};
+	// Delta mode keeps the newest state whole in keyframe and each older state as an
+	// XOR/RLE delta against the state saved after it, packed into the deltaData ring buffer
+	DynArray<uint8_t> keyframe;
+	DynArray<uint8_t> scratchState;
+	DynArray<uint8_t> deltaData;
+	std::vector<DeltaEntry> deltaEntries;
+	size_t oldestDeltaIdx{};
+	size_t keyframeSize{};
+	size_t scratchStateSize{};
+	// deltas are encoded on a worker so the emulation thread only pays for the raw state copy
+	WorkThread deltaThread;
+	std::binary_semaphore deltaSem{0};
+	std::atomic_bool deltaPending{};
+	std::atomic_bool held{};
+	// set from the UI thread & read by the emulation thread
+	std::atomic_uint8_t frameInterval_{};
+	int frameCount{};
 public:
 	size_t stateSize{};
 	size_t maxStates{};
 	PausableTimer<Seconds> saveTimer;
+	RewindMode mode{};
+	uint16_t memoryMB{defaultRewindMemoryMB};
 
 private:
 	void saveState(EmuApp &);
+	bool writeState(EmuSystem &);
+	bool writeDeltaState(EmuSystem &);
+	void encodeScratchState();
+	bool popState(auto &&readState);
+	void startDeltaThread();
+	void stopDeltaThread();
+	void waitForDeltaThread();
+	bool hasDeltas() const { return oldestDeltaIdx < deltaEntries.size(); }
+	size_t deltaCount() const { return deltaEntries.size() - oldestDeltaIdx; }
+	uint8_t *allocDelta(size_t size);
+	void popOldestDelta();
+	void popNewestDelta();
+	void clearDeltas();
 };
 
 }
@@ -0,0 +1,68 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/config.hh>
+#include <imagine/util/memory/DynArray.hh>
+#include <imagine/util/enum.hh>
+#include <algorithm>
+#include <span>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// Codec recorded in a state's header, values are stored in files so never reorder them
+WISE_ENUM_CLASS((StateCodec, uint8_t),
+	None,
+	LZ4,
+	Gzip);
+
+WISE_ENUM_CLASS((StateCompression, uint8_t),
+	None,
+	Fast,
+	Default,
+	Max);
+
+constexpr size_t stateHeaderSize = 12;
+
+struct StateHeader
+{
+	StateCodec codec;
+	uint32_t size; // uncompressed
+};
+
+struct StateCodecParams
+{
+	StateCodec codec;
+	int level;
+};
+
+// Largest uncompressed size accepted from a header, leaves room for states
+// saved with a different configuration of the system
+constexpr size_t maxStateSize(size_t stateSize) { return std::max(stateSize * 4, size_t(0x100000)); }
+
+StateCodecParams stateCodecParams(StateCompression);
+size_t compressStateBound(size_t size);
+size_t compressState(std::span<uint8_t> dest, std::span<const uint8_t> src, StateCompression);
+// for payloads compressed elsewhere, dest must have room for stateHeaderSize bytes
+void writeStateHeader(std::span<uint8_t> dest, StateCodecParams, uint32_t size);
+bool hasStateHeader(std::span<const uint8_t> buff);
+StateHeader readStateHeader(std::span<const uint8_t> buff, size_t maxSize);
+DynArray<uint8_t> uncompressState(std::span<const uint8_t> buff, size_t maxSize);
+
+}
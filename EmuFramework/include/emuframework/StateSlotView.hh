@@ -28,6 +28,7 @@ class StateSlotView : public TableView, public EmuAppHelper<StateSlotView>
 {
 public:
 	StateSlotView(ViewAttachParams attach);
+	~StateSlotView() final;
 	void onShow() final;
 
 private:
@@ -0,0 +1,70 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/config.hh>
+#include <emuframework/StateCodec.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/thread/WorkThread.hh>
+#include <imagine/util/DelegateFunc.hh>
+#include <imagine/util/memory/DynArray.hh>
+#include <string>
+
+namespace IG
+{
+class MapIO;
+}
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+class EmuApp;
+
+// Snapshots the emulated system's state on the calling thread and hands
+// compression, writing, and syncing of the file to a worker thread.
+// Files start with a StateCodec header so any codec can be loaded back.
+// Gzip states of systems that compress while serializing are written
+// directly instead, avoiding the uncompressed snapshot.
+class StateWriter
+{
+public:
+	StateWriter(EmuApp &app): app{app} {}
+	// successMsg, if set, is posted once the file is written
+	bool write(FileIO, StateCompression, std::string errorPrefix, const char *successMsg = {});
+	void wait();
+	bool isWriting() const { return writeThread.isWorking(); }
+	bool readConfig(MapIO &, unsigned key);
+	void writeConfig(FileIO &) const;
+
+private:
+	EmuApp &app;
+	WorkThread writeThread;
+	DynArray<uint8_t> stateBuff;
+	DynArray<uint8_t> compressedBuff;
+	void postError(WorkThread::Context, std::string msg);
+
+public:
+	// Called on the main thread after each state file is written
+	DelegateFunc<void()> onWrite;
+	// used by quick saves & autosaves
+	StateCompression compression{StateCompression::Fast};
+	// used by saves from the save state menu
+	StateCompression archiveCompression{StateCompression::Default};
+};
+
+}
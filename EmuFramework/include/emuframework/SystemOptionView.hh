@@ -38,6 +38,10 @@ protected:
 	MultiChoiceMenuItem autosaveLaunch;
 	BoolMenuItem autosaveContent;
 	BoolMenuItem confirmOverwriteState;
+	TextMenuItem stateCompressionItem[4];
+	MultiChoiceMenuItem stateCompression;
+	TextMenuItem archiveStateCompressionItem[4];
+	MultiChoiceMenuItem archiveStateCompression;
 	TextMenuItem fastModeSpeedItem[6];
 	MultiChoiceMenuItem fastModeSpeed;
 	TextMenuItem slowModeSpeedItem[3];
@@ -45,6 +49,12 @@ protected:
 	TextMenuItem rewindStatesItem[4];
 	MultiChoiceMenuItem rewindStates;
 	DualTextMenuItem rewindTimeInterval;
+	TextMenuItem rewindFrameIntervalItem[5];
+	MultiChoiceMenuItem rewindFrameInterval;
+	TextMenuItem rewindModeItem[2];
+	MultiChoiceMenuItem rewindMode;
+	TextMenuItem rewindMemoryItem[5];
+	MultiChoiceMenuItem rewindMemory;
 	ConditionalMember<Config::envIsAndroid, BoolMenuItem> performanceMode;
 	ConditionalMember<Config::envIsAndroid && Config::DEBUG_BUILD, BoolMenuItem> noopThread;
 	ConditionalMember<Config::cpuAffinity, TextMenuItem> cpuAffinity;
@@ -8,6 +8,7 @@ MDFN_COMMON_CPPFLAGS = -DHAVE_CONFIG_H \
 MDFN_COMMON_SRC := mednafen-emuex/MDFNApi.cc \
  mednafen-emuex/MThreading.cc \
  mednafen-emuex/StreamImpl.cc \
+ mednafen-emuex/GzipStream.cc \
  mednafen-emuex/VirtualFS.cpp \
  mednafen-emuex/MDFNFILE.cc \
  mednafen/endian.cpp \
@@ -82,6 +83,7 @@ MDFN_CDROM_SRC := mednafen-emuex/CDImpl.cc \
 MDFN_CDROM_STANDALONE_SRC := $(MDFN_CDROM_SRC) \
  mednafen-emuex/MDFNApi.cc \
  mednafen-emuex/StreamImpl.cc \
+ mednafen-emuex/GzipStream.cc \
  mednafen-emuex/VirtualFS.cpp \
  mednafen-emuex/MDFNFILE.cc \
  mednafen/endian.cpp \
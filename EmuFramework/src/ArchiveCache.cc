@@ -0,0 +1,263 @@
+/*  This file is part of EmuFramework.
+
+	EmuFramework is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	EmuFramework is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/ArchiveCache.hh>
+#include <imagine/fs/FS.hh>
+#include <imagine/fs/ArchiveFS.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/util/format.hh>
+#include <imagine/util/ranges.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"ArchiveCache"};
+constexpr std::string_view tempFileName{".extracting"};
+constexpr std::string_view indexSuffix{".index"};
+constexpr size_t copyBufferSize = 0x100000;
+
+static uint64_t fnv1a(uint64_t hash, std::span<const char> data)
+{
+	for(auto c : data)
+	{
+		hash ^= uint8_t(c);
+		hash *= 0x100000001b3;
+	}
+	return hash;
+}
+
+static uint64_t archiveKey(std::string_view path, uint64_t size, int64_t mtime)
+{
+	uint64_t hash = 0xcbf29ce484222325;
+	hash = fnv1a(hash, path);
+	hash = fnv1a(hash, std::span{reinterpret_cast<const char*>(&size), sizeof(size)});
+	hash = fnv1a(hash, std::span{reinterpret_cast<const char*>(&mtime), sizeof(mtime)});
+	return hash;
+}
+
+static std::string_view entryBaseName(std::string_view name)
+{
+	if(auto pos = name.rfind('/'); pos != name.npos)
+		return name.substr(pos + 1);
+	return name;
+}
+
+static void markUsed(CStringView path)
+{
+	// bump the modification time so it's the last to be evicted
+	if(utimensat(AT_FDCWD, path, nullptr, 0) == -1)
+		log.warn("error updating time of:{}", path);
+}
+
+static IO openCachedFile(CStringView path)
+{
+	FileIO io{path, {.test = true, .accessHint = IOAccessHint::All}};
+	if(!io)
+		return {};
+	markUsed(path);
+	return io;
+}
+
+// Returns the file names of the archive in order up to the last entry extracted from it,
+// or an empty list if the index is missing or truncated
+static std::vector<FS::FileString> readIndex(CStringView path)
+{
+	FileIO io{path, {.test = true, .accessHint = IOAccessHint::All}};
+	if(!io)
+		return {};
+	auto count = io.get<uint32_t>();
+	std::vector<FS::FileString> names;
+	for([[maybe_unused]] auto i : iotaCount(count))
+	{
+		auto size = io.getExpected<uint8_t>();
+		if(!size)
+			return {};
+		std::string name;
+		if(io.readSized(name, *size) != *size)
+			return {};
+		names.emplace_back(name);
+	}
+	return names;
+}
+
+static void writeIndex(CStringView path, std::span<const FS::FileString> names)
+{
+	FileIO io{path, OpenFlags::testNewFile()};
+	if(!io)
+	{
+		log.error("can't create index:{}", path);
+		return;
+	}
+	io.put(uint32_t(names.size()));
+	for(const auto &name : names)
+	{
+		io.put(uint8_t(name.size()));
+		io.write(name.data(), name.size());
+	}
+}
+
+static ArchiveCacheEntry findEntry(IO archive, ArchiveCache::EntryFilter filter,
+	std::vector<FS::FileString> *scannedNames = {})
+{
+	for(auto &entry : FS::ArchiveIterator{std::move(archive)})
+	{
+		if(entry.type() == FS::file_type::directory)
+			continue;
+		FS::FileString name{entryBaseName(entry.name())};
+		if(scannedNames)
+			scannedNames->emplace_back(name);
+		if(filter(name))
+			return {IO{std::move(entry)}, name};
+	}
+	return {};
+}
+
+ArchiveCache::ArchiveCache(ApplicationContext ctx, uint64_t maxSize):
+	ctx{ctx},
+	dir{FS::pathString(ctx.cachePath(), "archive")},
+	maxSize{maxSize} {}
+
+ArchiveCacheEntry ArchiveCache::openEntry(CStringView path, EntryFilter filter, IO archive)
+{
+	if(!archive)
+		archive = ctx.openFileUri(path, {.accessHint = IOAccessHint::Sequential});
+	auto mtime = ctx.fileUriLastWriteTime(path).time_since_epoch().count();
+	auto key = archiveKey(path, archive.size(), mtime);
+	auto keyPrefix = std::format("{:016x}-", key);
+	auto indexPath = FS::pathString(dir, std::format("{:016x}{}", key, indexSuffix));
+	FS::create_directory(dir);
+	if(!FS::exists(dir))
+	{
+		log.error("can't access cache directory:{}", dir);
+		return findEntry(std::move(archive), filter);
+	}
+	// the first indexed name accepted by filter is the entry a scan would return,
+	// if none match the rest of the archive must be scanned
+	auto index = readIndex(indexPath);
+	if(auto it = std::ranges::find_if(index, [&](const auto &name){ return filter(name); });
+		it != index.end())
+	{
+		if(auto io = openCachedFile(FS::pathString(dir, std::format("{}{}", keyPrefix, *it))))
+		{
+			log.info("using cached entry:{} for archive:{}", *it, path);
+			markUsed(indexPath);
+			return {std::move(io), *it};
+		}
+	}
+	return extractEntry(path, std::move(archive), keyPrefix, indexPath, index.size(), filter);
+}
+
+ArchiveCacheEntry ArchiveCache::extractEntry(CStringView path, IO archive, std::string_view keyPrefix,
+	CStringView indexPath, size_t indexedNames, EntryFilter filter)
+{
+	std::vector<FS::FileString> scannedNames;
+	auto entry = findEntry(std::move(archive), filter, &scannedNames);
+	if(!entry)
+		return {};
+	auto entrySize = entry.io.size();
+	if(entrySize > maxSize)
+	{
+		log.info("entry:{} ({} bytes) too large to cache", entry.name, entrySize);
+		return entry;
+	}
+	trim(entrySize);
+	auto tempPath = FS::pathString(dir, tempFileName);
+	FileIO file{tempPath, OpenFlags::testNewFile()};
+	if(!file)
+	{
+		log.error("can't create cache file for:{}", entry.name);
+		return entry;
+	}
+	log.info("extracting entry:{} ({} bytes) to cache", entry.name, entrySize);
+	auto buff = std::make_unique<uint8_t[]>(copyBufferSize);
+	while(true)
+	{
+		auto bytesRead = entry.io.read(buff.get(), copyBufferSize);
+		if(bytesRead == -1)
+		{
+			file = {};
+			FS::remove(tempPath);
+			throw std::runtime_error("Error reading archive");
+		}
+		if(!bytesRead)
+			break;
+		if(file.write(buff.get(), bytesRead) != bytesRead)
+		{
+			// out of space, open the archive again without caching
+			log.error("error writing cache file for:{}", entry.name);
+			file = {};
+			FS::remove(tempPath);
+			return findEntry(ctx.openFileUri(path, {.accessHint = IOAccessHint::Sequential}), filter);
+		}
+	}
+	file = {};
+	auto cachedPath = FS::pathString(dir, std::format("{}{}", keyPrefix, entry.name));
+	if(!FS::rename(tempPath, cachedPath))
+	{
+		FS::remove(tempPath);
+		return findEntry(ctx.openFileUri(path, {.accessHint = IOAccessHint::Sequential}), filter);
+	}
+	// keep the longest scanned list since both are in archive order
+	if(scannedNames.size() > indexedNames)
+		writeIndex(indexPath, scannedNames);
+	return {openCachedFile(cachedPath), entry.name};
+}
+
+void ArchiveCache::trim(uint64_t reserveSize)
+{
+	struct CachedFile
+	{
+		FS::PathString path;
+		uint64_t size;
+		FS::file_time_type lastUsed;
+	};
+	std::vector<CachedFile> files;
+	uint64_t totalSize{};
+	for(auto &e : FS::directory_iterator{dir})
+	{
+		if(e.type() != FS::file_type::regular)
+			continue;
+		if(e.name() == tempFileName)
+		{
+			// left over from an interrupted extraction
+			FS::remove(e.path());
+			continue;
+		}
+		auto status = FS::status(e.path());
+		files.emplace_back(e.path(), status.size(), status.lastWriteTime());
+		totalSize += status.size();
+	}
+	if(totalSize + reserveSize <= maxSize)
+		return;
+	std::ranges::sort(files, {}, &CachedFile::lastUsed);
+	for(const auto &f : files)
+	{
+		log.info("evicting:{} ({} bytes)", f.path, f.size);
+		FS::remove(f.path);
+		totalSize -= f.size;
+		if(totalSize + reserveSize <= maxSize)
+			return;
+	}
+}
+
+}
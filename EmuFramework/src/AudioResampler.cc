@@ -0,0 +1,236 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/AudioResampler.hh>
+#include <imagine/util/ranges.hh>
+#include <imagine/util/utility.h>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"AudioResampler"};
+constexpr int sincPhases = 256;
+
+// 4-wide float vector, maps to SSE2/NEON registers on targets that have them
+using Vec4f [[gnu::vector_size(16)]] = float;
+
+static Vec4f loadVec4(const float *p)
+{
+	Vec4f v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static float dot(const float *coeffs, const float *samples, int taps)
+{
+	Vec4f sum{};
+	for(int i = 0; i < taps; i += 4)
+	{
+		sum += loadVec4(coeffs + i) * loadVec4(samples + i);
+	}
+	return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+static void writeSample(void *dest, size_t idx, float s, Audio::SampleFormat format)
+{
+	if(format.isFloat())
+	{
+		static_cast<float*>(dest)[idx] = s;
+	}
+	else
+	{
+		static_cast<int16_t*>(dest)[idx] = std::clamp(std::lrint(s * 32768.f), -32768l, 32767l);
+	}
+}
+
+int AudioResampler::taps() const
+{
+	return quality_ == AudioResamplerQuality::High ? maxTaps : 4;
+}
+
+void AudioResampler::reset()
+{
+	for(auto &buff : chanBuff)
+	{
+		buff.assign(taps(), 0.f);
+	}
+	// evaluate the first output at the start of the window
+	pos = taps() / 2 - 1;
+	active = false;
+}
+
+void AudioResampler::setQuality(AudioResamplerQuality q)
+{
+	if(quality_ == q)
+		return;
+	quality_ = q;
+	sincCutoff = {};
+	reset();
+}
+
+void AudioResampler::setChannels(int8_t ch)
+{
+	assumeExpr(ch == 1 || ch == 2);
+	if(channels == ch)
+		return;
+	channels = ch;
+	reset();
+}
+
+void AudioResampler::appendInput(const void *src, size_t srcFrames, Audio::Format format)
+{
+	const size_t histFrames = taps();
+	for(auto ch : iotaCount(channels))
+	{
+		auto &buff = chanBuff[ch];
+		buff.resize(histFrames + srcFrames);
+		auto out = buff.data() + histFrames;
+		if(format.sample.isFloat())
+		{
+			auto in = static_cast<const float*>(src) + ch;
+			for(auto i : iotaCount(srcFrames))
+				out[i] = in[i * channels];
+		}
+		else
+		{
+			auto in = static_cast<const int16_t*>(src) + ch;
+			for(auto i : iotaCount(srcFrames))
+				out[i] = in[i * channels] * (1.f / 32768.f);
+		}
+	}
+}
+
+void AudioResampler::consumeInput(size_t srcFrames)
+{
+	const size_t histFrames = taps();
+	for(auto ch : iotaCount(channels))
+	{
+		auto &buff = chanBuff[ch];
+		std::memmove(buff.data(), buff.data() + srcFrames, histFrames * sizeof(float));
+		buff.resize(histFrames);
+	}
+	pos -= srcFrames;
+}
+
+void AudioResampler::updateSincTable(float cutoff)
+{
+	// Blackman windowed sinc, each phase normalized to unity DC gain
+	using std::numbers::pi;
+	constexpr int halfTaps = maxTaps / 2;
+	sincTable.resize((sincPhases + 1) * maxTaps);
+	for(auto phase : iotaCount(sincPhases + 1))
+	{
+		auto row = &sincTable[phase * maxTaps];
+		double frac = double(phase) / sincPhases;
+		double sum{};
+		for(auto k : iotaCount(maxTaps))
+		{
+			double d = (k + 1 - halfTaps) - frac;
+			double x = pi * cutoff * d;
+			double sinc = d == 0. ? 1. : std::sin(x) / x;
+			double w = 0.42 + 0.5 * std::cos(pi * d / halfTaps) + 0.08 * std::cos(2. * pi * d / halfTaps);
+			row[k] = cutoff * sinc * std::max(w, 0.);
+			sum += row[k];
+		}
+		for(auto k : iotaCount(maxTaps))
+			row[k] /= sum;
+	}
+	sincCutoff = cutoff;
+	log.debug("updated sinc table with cutoff:{}", cutoff);
+}
+
+const float *AudioResampler::coeffsForPhase(float t, float *coeffs) const
+{
+	switch(quality_)
+	{
+		case AudioResamplerQuality::Low:
+			coeffs[0] = 0.f;
+			coeffs[1] = 1.f - t;
+			coeffs[2] = t;
+			coeffs[3] = 0.f;
+			return coeffs;
+		case AudioResamplerQuality::Medium:
+		{
+			// Catmull-Rom spline
+			float t2 = t * t;
+			float t3 = t2 * t;
+			coeffs[0] = .5f * (-t3 + 2.f * t2 - t);
+			coeffs[1] = .5f * (3.f * t3 - 5.f * t2 + 2.f);
+			coeffs[2] = .5f * (-3.f * t3 + 4.f * t2 + t);
+			coeffs[3] = .5f * (t3 - t2);
+			return coeffs;
+		}
+		case AudioResamplerQuality::High:
+			return &sincTable[std::lrint(t * sincPhases) * maxTaps];
+	}
+	bug_unreachable("invalid quality");
+}
+
+size_t AudioResampler::resample(void *dest, size_t maxDestFrames, const void *src, size_t srcFrames, double srcStep, Audio::Format format)
+{
+	assumeExpr(srcStep > 0.);
+	setChannels(format.channels);
+	if(quality_ == AudioResamplerQuality::High)
+	{
+		// lower the cutoff when decimating to keep frequencies above the new Nyquist limit from aliasing
+		float cutoff = std::min(1., 1. / srcStep) * .95f;
+		if(std::abs(cutoff - sincCutoff) > .01f)
+			updateSincTable(cutoff);
+	}
+	appendInput(src, srcFrames, format);
+	active = true;
+	const int taps = this->taps();
+	const double endPos = taps + srcFrames - taps / 2;
+	float coeffBuff[4];
+	size_t destFrames{};
+	for(; pos < endPos && destFrames < maxDestFrames; pos += srcStep, destFrames++)
+	{
+		auto intPos = size_t(pos);
+		auto coeffs = coeffsForPhase(pos - intPos, coeffBuff);
+		auto windowStart = intPos + 1 - taps / 2;
+		for(auto ch : iotaCount(channels))
+		{
+			writeSample(dest, destFrames * channels + ch, dot(coeffs, &chanBuff[ch][windowStart], taps), format.sample);
+		}
+	}
+	if(pos < endPos)
+	{
+		// destination is full, skip the remaining input
+		pos = endPos;
+	}
+	consumeInput(srcFrames);
+	return destFrames;
+}
+
+void AudioResampler::prime(const void *src, size_t srcFrames, Audio::Format format)
+{
+	setChannels(format.channels);
+	const size_t histFrames = taps();
+	if(srcFrames > histFrames)
+	{
+		src = static_cast<const char*>(src) + format.framesToBytes(srcFrames - histFrames);
+		srcFrames = histFrames;
+	}
+	appendInput(src, srcFrames, format);
+	pos = histFrames + srcFrames;
+	consumeInput(srcFrames);
+}
+
+}
@@ -58,6 +58,7 @@ bool AutosaveManager::load(AutosaveActionSource src, LoadAutosaveMode mode)
 {
 	if(autoSaveSlot == noAutosaveName)
 		return true;
+	app.stateWriter.wait();
 	try
 	{
 		system().loadBackupMemory(app);
@@ -93,14 +94,17 @@ bool AutosaveManager::load(AutosaveActionSource src, LoadAutosaveMode mode)
 bool AutosaveManager::saveState()
 {
 	log.info("saving autosave state");
-	stateIO.truncate(0);
-	auto state = app.saveState();
-	if(stateIO.write(state.span(), 0).bytes != ssize_t(state.size()))
+	FileIO io;
+	try
 	{
-		app.postErrorMessage(4, "Error writing autosave state");
+		io = appContext().openFileUri(statePath(), OpenFlags::createFile());
+	}
+	catch(std::exception &err)
+	{
+		app.postErrorMessage(4, std::format("Error writing autosave state:\n{}", err.what()));
 		return false;
 	}
-	return true;
+	return app.stateWriter.write(std::move(io), app.stateWriter.compression, "Error writing autosave state");
 }
 
 bool AutosaveManager::loadState()
@@ -108,6 +108,7 @@ void EmuApp::saveConfigFile(FileIO &io)
 	inputManager.vController.writeConfig(io);
 	autosaveManager.writeConfig(io);
 	rewindManager.writeConfig(io);
+	stateWriter.writeConfig(io);
 	audio.writeConfig(io);
 	videoLayer.writeConfig(io);
 	if(overrideScreenFrameRate)
@@ -179,6 +180,8 @@ EmuApp::ConfigParams EmuApp::loadConfigFile(IG::ApplicationContext ctx)
 						return true;
 					if(rewindManager.readConfig(io, key))
 						return true;
+					if(stateWriter.readConfig(io, key))
+						return true;
 					if(audio.readConfig(io, key))
 						return true;
 					if(recentContent.readConfig(io, key, system()))
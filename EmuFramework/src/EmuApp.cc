@@ -40,6 +40,7 @@
 #include <imagine/fs/FS.hh>
 #include <imagine/fs/ArchiveFS.hh>
 #include <imagine/io/IO.hh>
+#include <imagine/io/FileIO.hh>
 #include <imagine/gfx/Renderer.hh>
 #include <imagine/gfx/RendererTask.hh>
 #include <imagine/gui/ToastView.hh>
@@ -210,13 +211,16 @@ static void suspendEmulation(EmuApp &app)
 		return;
 	app.autosaveManager.save();
 	app.system().flushBackupMemory(app);
+	// make sure the state is on disk before the process can be killed
+	app.stateWriter.wait();
 }
 
 void EmuApp::closeSystem()
 {
 	showUI();
-	emuSystemTask.stop();
+	// stop the task after closing since the system may still run code on it
 	system().closeRuntimeSystem(*this);
+	emuSystemTask.stop();
 	autosaveManager.resetSlot();
 	rewindManager.clear();
 	viewController().onSystemClosed();
@@ -407,6 +411,11 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 	system().onOptionsLoaded();
 	loadSystemOptions();
 	updateLegacySavePathOnStoragePath(ctx, system());
+	if(auto benchParams = parseHeadlessBenchmarkArgs(initParams.commandArgs()))
+	{
+		ctx.exit(runHeadlessBenchmark(*benchParams));
+		return;
+	}
 	if(auto launchGame = parseCommandArgs(initParams.commandArgs());
 		launchGame)
 		system().setInitialLoadPath(launchGame);
@@ -708,19 +717,29 @@ bool EmuApp::advanceFrames(FrameParams frameParams, EmuSystemTask *taskPtr)
 	EmuVideo *videoPtr = savedAdvancedFrames ? nullptr : &video;
 	if(videoPtr)
 	{
+		doIfUsed(frameTimeStats, [&](auto &stats) { stats.helperThreadTime = system().helperThreadFrameTime(); });
 		if(showFrameTimeStats)
 		{
 			viewCtrl.emuView.updateFrameTimeStats(frameTimeStats, frameParams.timestamp);
 		}
+		doIfUsed(frameTimeRecorder, [&](auto &recorder)
+		{
+			FrameTimeStats lastStats = frameTimeStats;
+			if(recorder.isActive() && hasTime(lastStats.startOfFrame))
+				recorder.add(lastStats, audio.underruns());
+		});
 		record(FrameTimeStatEvent::startOfFrame, frameParams.timestamp);
 		record(FrameTimeStatEvent::startOfEmulation);
+		doIfUsed(frameTimeStats, [&](auto &stats) { stats.advancedFrames = frameInfo.advanced; });
 		win.setDrawEventPriority(Window::drawEventPriorityLocked);
 		if(taskPtr)
 			taskPtr->framePending = true;
 	}
 	runTurboInputEvents();
 	//log.debug("running {} frame(s), skip:{}", frameInfo.advanced, !videoPtr);
-	runFrames({taskPtr}, videoPtr, audioPtr, frameInfo.advanced);
+	// while rewind is held, show earlier states in place of running new frames
+	if(!rewindManager.isHeld() || !rewindManager.rewindFrame(*this, {taskPtr}, videoPtr))
+		runFrames({taskPtr}, videoPtr, audioPtr, frameInfo.advanced);
 	if(!videoPtr)
 	{
 		reportFrameWorkTime();
@@ -1058,8 +1077,9 @@ void EmuApp::setupStaticBackupMemoryFile(FileIO &io, std::string_view ext, size_
 
 void EmuApp::readState(std::span<uint8_t> buff)
 {
+	stateWriter.wait();
 	syncEmulationThread();
-	system().readState(*this, buff);
+	system().loadState(*this, buff);
 	system().clearInputBuffers(viewController().inputView);
 	autosaveManager.resetTimer();
 }
@@ -1076,30 +1096,31 @@ DynArray<uint8_t> EmuApp::saveState()
 	return system().saveState();
 }
 
-bool EmuApp::saveState(CStringView path)
+bool EmuApp::saveState(CStringView path, StateCompression compression, bool notify)
 {
 	if(!system().hasContent())
 	{
 		postErrorMessage("System not running");
 		return false;
 	}
-	syncEmulationThread();
 	log.info("saving state {}", path);
+	FileIO file;
 	try
 	{
-		system().saveState(path);
-		return true;
+		// keep the previous contents until the new state is written, StateWriter truncates afterwards
+		file = appContext().openFileUri(path, OpenFlags::createFile());
 	}
 	catch(std::exception &err)
 	{
 		postErrorMessage(4, std::format("Can't save state:\n{}", err.what()));
 		return false;
 	}
+	return stateWriter.write(std::move(file), compression, "Can't save state", notify ? "State Saved" : nullptr);
 }
 
-bool EmuApp::saveStateWithSlot(int slot)
+bool EmuApp::saveStateWithSlot(int slot, StateCompression compression, bool notify)
 {
-	return saveState(system().statePath(slot));
+	return saveState(system().statePath(slot), compression, notify);
 }
 
 bool EmuApp::loadState(CStringView path)
@@ -1110,6 +1131,7 @@ bool EmuApp::loadState(CStringView path)
 		return false;
 	}
 	log.info("loading state {}", path);
+	stateWriter.wait();
 	syncEmulationThread();
 	try
 	{
@@ -1228,10 +1250,7 @@ bool EmuApp::handleAppActionKeyInput(InputAction action, const Input::Event &src
 				break;
 			static auto doSaveState = [](EmuApp &app, bool notify)
 			{
-				if(app.saveStateWithSlot(app.system().stateSlot()) && notify)
-				{
-					app.postMessage("State Saved");
-				}
+				app.saveStateWithSlot(app.system().stateSlot(), app.stateWriter.compression, notify);
 			};
 			if(shouldOverwriteExistingState())
 			{
@@ -1328,12 +1347,17 @@ bool EmuApp::handleAppActionKeyInput(InputAction action, const Input::Event &src
 		}
 		case rewind:
 		{
-			if(!isPushed)
+			if(!rewindManager.isEnabled())
+			{
+				if(isPushed)
+					postMessage(3, false, "Please set rewind states in Options➔System");
 				break;
-			if(rewindManager.maxStates)
+			}
+			if(isPushed)
 				rewindManager.rewindState(*this);
-			else
-				postMessage(3, false, "Please set rewind states in Options➔System");
+			// keep stepping back once per frame while held when saving states by frame count
+			if(rewindManager.frameInterval())
+				rewindManager.setHeld(isPushed);
 			break;
 		}
 		case softReset:
@@ -1553,11 +1577,13 @@ void EmuApp::runFrames(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *
 	skipFrames(taskCtx, frames - 1, audio);
 	system().runFrame(taskCtx, video, audio);
 	system().updateBackupMemoryCounter();
+	rewindManager.addFrames(system(), frames);
 }
 
 void EmuApp::skipFrames(EmuSystemTaskContext taskCtx, int frames, EmuAudio *audio)
 {
 	assert(system().hasContent());
+	taskCtx.skipRender = true;
 	for(auto i : iotaCount(frames))
 	{
 		system().runFrame(taskCtx, nullptr, audio);
@@ -1780,12 +1806,43 @@ void EmuApp::record(FrameTimeStatEvent event, SteadyClockTimePoint t)
 {
 	doIfUsed(frameTimeStats, [&](auto &frameTimeStats)
 	{
-		if(!showFrameTimeStats || !viewController().isShowingEmulation())
+		bool isRecording = doIfUsed(frameTimeRecorder, [](auto &recorder) { return recorder.isActive(); }, false);
+		if((!showFrameTimeStats && !isRecording) || !viewController().isShowingEmulation())
 			return;
 		(&frameTimeStats.startOfFrame)[to_underlying(event)] = hasTime(t) ? t : SteadyClock::now();
 	});
 }
 
+bool EmuApp::exportFrameTimeRecord()
+{
+	return doIfUsed(frameTimeRecorder, [&](auto &recorder)
+	{
+		if(!recorder.size())
+		{
+			postMessage("No frame times recorded yet");
+			return false;
+		}
+		auto ctx = appContext();
+		auto dir = FS::createDirectorySegments(ctx.storagePath(), "EmuEx", "frametimes");
+		auto writeFile = [&](std::string_view name, const std::string &str)
+		{
+			auto path = FS::pathString(dir, name);
+			auto bytes = std::span{reinterpret_cast<const unsigned char*>(str.data()), str.size()};
+			if(FileUtils::writeToPath(path, bytes) != ssize_t(str.size()))
+			{
+				postErrorMessage(std::format("Error writing {}", path));
+				return false;
+			}
+			return true;
+		};
+		if(!writeFile("frametimes.csv", recorder.toCSV()) ||
+			!writeFile("frametimes.trace.json", recorder.toTraceEventJSON()))
+			return false;
+		postMessage(std::format("Wrote {} frames to {}", recorder.size(), dir));
+		return true;
+	}, false);
+}
+
 IG::OnFrameDelegate EmuApp::onFrameDelayed(int8_t delay)
 {
 	return [this, delay](IG::FrameParams params)
@@ -33,12 +33,16 @@ struct AudioStats
 	int overruns{};
 	std::atomic_uint callbacks{};
 	std::atomic_uint callbackBytes{};
+	std::atomic<float> rateControlFactor{1.f};
+	std::atomic<float> bufferFill{};
 
 	void reset()
 	{
 		underruns = overruns = 0;
 		callbacks = 0;
 		callbackBytes = 0;
+		rateControlFactor = 1.f;
+		bufferFill = 0.f;
 	}
 };
 
@@ -56,7 +60,8 @@ static void startAudioStats(IG::Audio::Format format)
 		{
 			auto frames = format.bytesToFrames(audioStats.callbackBytes);
 			emuViewController.updateEmuAudioStats(audioStats.underruns, audioStats.overruns,
-				audioStats.callbacks, frames / (double)audioStats.callbacks, frames);
+				audioStats.callbacks, frames / (double)audioStats.callbacks, frames,
+				audioStats.rateControlFactor, audioStats.bufferFill);
 			audioStats.callbacks = 0;
 			audioStats.callbackBytes = 0;
 		});
@@ -97,46 +102,6 @@ bool EmuAudio::shouldStartAudioWrites(size_t bytesToWrite) const
 	return rBuff.size() + bytesToWrite >= targetBufferFillBytes;
 }
 
-template<typename T>
-static void simpleResample(T * __restrict__ dest, size_t destFrames, const T * __restrict__ src, size_t srcFrames)
-{
-	if(!destFrames)
-		return;
-	float ratio = (float)srcFrames/(float)destFrames;
-	for(auto i : iotaCount(destFrames))
-	{
-		size_t srcPos = std::floor((float)i * ratio);
-		if(srcPos >= srcFrames) [[unlikely]]
-		{
-			log.info("resample pos {} too high", srcPos);
-			srcPos = srcFrames-1;
-		}
-		dest[i] = src[srcPos];
-	}
-}
-
-static void simpleResample(void *dest, size_t destFrames, const void *src, size_t srcFrames, IG::Audio::Format format)
-{
-	if(format.channels == 1)
-	{
-		if(format.sample.isFloat())
-			simpleResample((uint32_t*)dest, destFrames, (uint32_t*)src, srcFrames);
-		else
-			simpleResample((uint16_t*)dest, destFrames, (uint16_t*)src, srcFrames);
-	}
-	else
-	{
-		if(format.channels != 2)
-		{
-			bug_unreachable("channels == %d", format.channels);
-		}
-		if(format.sample.isFloat())
-			simpleResample((uint64_t*)dest, destFrames, (uint64_t*)src, srcFrames);
-		else
-			simpleResample((uint32_t*)dest, destFrames, (uint32_t*)src, srcFrames);
-	}
-}
-
 void EmuAudio::resizeAudioBuffer(size_t targetBufferFillBytes)
 {
 	auto oldCapacity = rBuff.capacity();
@@ -206,6 +171,7 @@ void EmuAudio::start(FloatSeconds bufferDuration)
 							audioWriteState = AudioWriteState::UNDERRUN;
 						}
 						lastUnderrunTime = now;
+						underrunCount++;
 						#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
 						audioStats.underruns++;
 						#endif
@@ -247,6 +213,21 @@ void EmuAudio::stop()
 	if(audioStream)
 		audioStream.close();
 	rBuff.clear();
+	resampler.reset();
+}
+
+void EmuAudio::startHeadless(FloatSeconds bufferDuration)
+{
+	// only allocate the buffer so writes succeed without an output stream
+	targetBufferFillBytes = format().timeToBytes(bufferDuration);
+	bufferIncrementBytes = 0;
+	resizeAudioBuffer(targetBufferFillBytes);
+	audioWriteState = AudioWriteState::BUFFER;
+}
+
+void EmuAudio::discardFrames()
+{
+	rBuff.clear();
 }
 
 void EmuAudio::close()
@@ -265,6 +246,7 @@ void EmuAudio::flush()
 	if(audioStream)
 		audioStream.flush();
 	rBuff.clear();
+	resampler.reset();
 }
 
 void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
@@ -290,23 +272,29 @@ void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 		default:
 		break;
 	}
+	double srcStep = speedMultiplier;
+	if(dynamicRateControl && audioWriteState == AudioWriteState::ACTIVE)
+		srcStep *= rateControlFactor();
 	const size_t sampleFrames = framesToWrite;
-	if(speedMultiplier != 1.) [[unlikely]]
+	if(srcStep != 1.)
 	{
-		framesToWrite = std::ceil((double)framesToWrite / speedMultiplier);
+		framesToWrite = std::ceil((double)framesToWrite / srcStep);
 		framesToWrite = std::max(framesToWrite, 1zu);
 	}
 	auto bytes = inputFormat.framesToBytes(framesToWrite);
 	auto freeBytes = rBuff.freeSpace();
 	if(bytes <= freeBytes)
 	{
-		if(sampleFrames != framesToWrite)
+		if(sampleFrames != framesToWrite || resampler.isActive())
 		{
-			simpleResample(rBuff.writeAddr(), framesToWrite, samples, sampleFrames, inputFormat);
-			rBuff.commitWrite(bytes);
+			auto frames = resampler.resample(rBuff.writeAddr(), framesToWrite, samples, sampleFrames, srcStep, inputFormat);
+			rBuff.commitWrite(inputFormat.framesToBytes(frames));
 		}
 		else
+		{
 			rBuff.writeUnchecked(samples, bytes);
+			resampler.prime(samples, sampleFrames, inputFormat);
+		}
 	}
 	else
 	{
@@ -315,8 +303,12 @@ void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 		audioStats.overruns++;
 		#endif
 		auto freeFrames = inputFormat.bytesToFrames(freeBytes);
-		simpleResample(rBuff.writeAddr(), freeFrames, samples, sampleFrames, inputFormat);
-		rBuff.commitWrite(freeBytes);
+		if(freeFrames)
+		{
+			auto frames = resampler.resample(rBuff.writeAddr(), freeFrames, samples, sampleFrames,
+				double(sampleFrames) / freeFrames, inputFormat);
+			rBuff.commitWrite(inputFormat.framesToBytes(frames));
+		}
 	}
 	if(audioWriteState == AudioWriteState::BUFFER && shouldStartAudioWrites(bytes))
 	{
@@ -331,6 +323,20 @@ void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 	}
 }
 
+double EmuAudio::rateControlFactor() const
+{
+	// positive when the buffer is below its target fill level,
+	// which makes the resampler consume fewer source frames per output frame
+	auto targetBytes = double(targetBufferFillBytes);
+	auto fillError = std::clamp((targetBytes - rBuff.size()) / targetBytes, -1., 1.);
+	auto factor = 1. - maxRateControlDelta * fillError;
+	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
+	audioStats.rateControlFactor = factor;
+	audioStats.bufferFill = rBuff.size() / targetBytes;
+	#endif
+	return factor;
+}
+
 void EmuAudio::setRate(int newRate)
 {
 	assert(newRate <= defaultRate);
@@ -453,6 +459,8 @@ void EmuAudio::writeConfig(FileIO &io) const
 	writeOptionValueIfNotDefault(io, CFGKEY_SOUND_VOLUME, maxVolume(), 100);
 	writeOptionValueIfNotDefault(io, CFGKEY_ADD_SOUND_BUFFERS_ON_UNDERRUN, addSoundBuffersOnUnderrunSetting, false);
 	writeOptionValueIfNotDefault(io, CFGKEY_AUDIO_API, audioAPI, Audio::Api::DEFAULT);
+	writeOptionValueIfNotDefault(io, CFGKEY_AUDIO_DYNAMIC_RATE_CONTROL, dynamicRateControl, false);
+	writeOptionValueIfNotDefault(io, CFGKEY_AUDIO_RESAMPLER_QUALITY, resampler.quality(), AudioResamplerQuality::Medium);
 }
 
 bool EmuAudio::readConfig(MapIO &io, unsigned key)
@@ -465,6 +473,9 @@ bool EmuAudio::readConfig(MapIO &io, unsigned key)
 		case CFGKEY_SOUND_VOLUME: return readOptionValue<int8_t>(io, [&](auto v){ setMaxVolume(v); }, isValidVolumeSetting);
 		case CFGKEY_ADD_SOUND_BUFFERS_ON_UNDERRUN: return readOptionValue(io, addSoundBuffersOnUnderrunSetting);
 		case CFGKEY_AUDIO_API: return readOptionValue(io, audioAPI);
+		case CFGKEY_AUDIO_DYNAMIC_RATE_CONTROL: return readOptionValue(io, dynamicRateControl);
+		case CFGKEY_AUDIO_RESAMPLER_QUALITY: return readOptionValue<AudioResamplerQuality>(io, [&](AudioResamplerQuality q){ resampler.setQuality(q); },
+			[](auto q){ return q <= lastEnum<AudioResamplerQuality>; });
 	}
 	return false;
 }
@@ -19,6 +19,8 @@
 #include <emuframework/EmuAudio.hh>
 #include <emuframework/EmuVideo.hh>
 #include <emuframework/EmuViewController.hh>
+#include <emuframework/StateCodec.hh>
+#include <emuframework/ArchiveCache.hh>
 #include <imagine/base/ApplicationContext.hh>
 #include <imagine/fs/ArchiveFS.hh>
 #include <imagine/fs/FSUtils.hh>
@@ -54,6 +56,7 @@ constexpr SystemLogger log{"EmuSystem"};
 [[gnu::weak]] F2Size EmuSystem::validFrameRateRange{minFrameRate, 80.};
 [[gnu::weak]] bool EmuSystem::hasRectangularPixels = false;
 [[gnu::weak]] bool EmuSystem::stateSizeChangesAtRuntime = false;
+[[gnu::weak]] bool EmuSystem::handlesCompressedStates = false;
 
 bool EmuSystem::stateExists(int slot) const
 {
@@ -75,7 +78,31 @@ bool EmuApp::shouldOverwriteExistingState() const
 void EmuSystem::loadState(EmuApp &app, CStringView uri)
 {
 	auto file = appContext().openFileUri(uri, {.accessHint = IOAccessHint::All});
-	readState(app, file.buffer(IOBufferMode::Release));
+	loadState(app, file.buffer(IOBufferMode::Release).span());
+}
+
+void EmuSystem::loadState(EmuApp &app, std::span<uint8_t> buff)
+{
+	if(handlesCompressedStates)
+	{
+		// system reads uncompressed payloads in place & writes compressed states while serializing
+		readState(app, buff);
+		return;
+	}
+	if(hasStateHeader(buff))
+	{
+		auto uncompArr = uncompressState(buff, maxStateSize(stateSize()));
+		readState(app, uncompArr);
+		return;
+	}
+	// legacy states written directly by the system may be gzip compressed
+	if(hasGzipHeader(buff))
+	{
+		auto uncompArr = uncompressGzipState(buff);
+		readState(app, uncompArr);
+		return;
+	}
+	readState(app, buff);
 }
 
 void EmuSystem::saveState(CStringView uri)
@@ -97,6 +124,9 @@ DynArray<uint8_t> EmuSystem::uncompressGzipState(std::span<uint8_t> buff, size_t
 	auto uncompSize = gzipUncompressedSize(buff);
 	if(expectedSize && expectedSize != uncompSize)
 		throw std::runtime_error("Invalid state size from header");
+	// the gzip trailer isn't validated until decompression, so bound it like the EXST header
+	if(auto maxSize = maxStateSize(stateSize()); uncompSize > maxSize)
+		throw std::runtime_error(std::format("State size {} exceeds limit of {}", uncompSize, maxSize));
 	auto uncompArr = dynArrayForOverwrite<uint8_t>(uncompSize);
 	auto size = uncompressGzip(uncompArr, buff);
 	if(!size)
@@ -297,6 +327,7 @@ void EmuSystem::pause(EmuApp &app)
 	app.audio.stop();
 	app.autosaveManager.pauseTimer();
 	app.rewindManager.pauseTimer();
+	app.rewindManager.setHeld(false);
 	onStop();
 }
 
@@ -310,7 +341,7 @@ void EmuSystem::start(EmuApp &app)
 	onStart();
 	app.startAudio();
 	app.autosaveManager.startTimer();
-	if(stateSizeChangesAtRuntime && app.rewindManager.maxStates)
+	if(stateSizeChangesAtRuntime && app.rewindManager.isEnabled())
 	{
 		auto newStateSize = stateSize();
 		if(newStateSize != app.rewindManager.stateSize)
@@ -423,30 +454,16 @@ void EmuSystem::loadContentFromFile(IO file, CStringView path, std::string_view
 {
 	if(!EmuSystem::handlesArchiveFiles && EmuApp::hasArchiveExtension(displayName))
 	{
-		IO io{};
-		FS::FileString originalName{};
-		for(auto &entry : FS::ArchiveIterator{std::move(file)})
-		{
-			if(entry.type() == FS::file_type::directory)
-			{
-				continue;
-			}
-			auto name = entry.name();
-			log.info("archive file entry:{}", name);
-			if(EmuSystem::defaultFsFilter(name))
-			{
-				originalName = name;
-				io = std::move(entry);
-				break;
-			}
-		}
-		if(!io)
+		auto entry = ArchiveCache{appContext()}.openEntry(path,
+			[](std::string_view name){ return EmuSystem::defaultFsFilter(name); }, std::move(file));
+		if(!entry)
 		{
 			throw std::runtime_error("No recognized file extensions in archive");
 		}
+		log.info("archive file entry:{}", entry.name);
 		closeAndSetupNew(path, displayName);
-		contentFileName_ = originalName;
-		loadContent(io, params, onLoadProgress);
+		contentFileName_ = entry.name;
+		loadContent(entry.io, params, onLoadProgress);
 	}
 	else
 	{
@@ -27,9 +27,12 @@ constexpr SystemLogger log{"EmuSystemTask"};
 EmuSystemTask::EmuSystemTask(EmuApp &app):
 	app{app} {}
 
-using FrameParamsCommand = EmuSystemTask::FrameParamsCommand;
 using PauseCommand = EmuSystemTask::PauseCommand;
 using ExitCommand = EmuSystemTask::ExitCommand;
+using RunCommand = EmuSystemTask::RunCommand;
+
+// how long to busy-wait for another frame update before blocking in the event loop
+constexpr auto spinWaitTime = Microseconds{50};
 
 void EmuSystemTask::start()
 {
@@ -41,6 +44,8 @@ void EmuSystemTask::start()
 			threadId_ = thisThreadId();
 			auto eventLoop = EventLoop::makeForThread();
 			bool started = true;
+			frameEvent.attach(eventLoop, [this]{ runFrameCommands(); });
+			isWaiting = true;
 			commandPort.attach(eventLoop, [this, &started](auto msgs)
 			{
 				std::binary_semaphore *syncSemPtr{};
@@ -48,16 +53,6 @@ void EmuSystemTask::start()
 				{
 					bool threadIsRunning = visit(overloaded
 					{
-						[&](FrameParamsCommand &cmd)
-						{
-							frameParams = cmd.params;
-							return true;
-						},
-						[&](FramePresentedCommand &cmd)
-						{
-							framePending = false;
-							return true;
-						},
 						[&](PauseCommand &)
 						{
 							//log.debug("got pause command");
@@ -71,31 +66,19 @@ void EmuSystemTask::start()
 							EventLoop::forThread().stop();
 							return false;
 						},
+						[&](RunCommand &cmd)
+						{
+							assumeExpr(msg.semPtr);
+							cmd.func();
+							msg.semPtr->release();
+							return true;
+						},
 					}, msg.command);
 					if(!threadIsRunning)
 						return false;
 				}
-				if(hasTime(frameParams.timestamp))
-				{
-					if(!framePending)
-					{
-						auto params = std::exchange(frameParams, {});
-						bool renderingFrame = app.advanceFrames(params, this);
-						if(params.isFromRenderer())
-						{
-							framePending = false;
-							if(!renderingFrame)
-							{
-								app.emuWindow().postDraw(1);
-							}
-						}
-					}
-					else
-					{
-						log.debug("previous async frame not ready yet");
-						doIfUsed(app.frameTimeStats, [&](auto &stats) { stats.missedFrameCallbacks++; });
-					}
-				}
+				// handle any frame updates sent before this command
+				processFrameCommands();
 				if(syncSemPtr)
 				{
 					framePending = false;
@@ -107,10 +90,93 @@ void EmuSystemTask::start()
 			log.info("starting thread event loop");
 			eventLoop.run(started);
 			log.info("exiting thread");
+			frameEvent.detach();
 			commandPort.detach();
 		});
 }
 
+void EmuSystemTask::runFrameCommands()
+{
+	isWaiting.store(false, std::memory_order_relaxed);
+	while(true)
+	{
+		processFrameCommands();
+		if(spinForFrameCommands())
+			continue;
+		// announce blocking, then re-check so an update sent in between isn't missed
+		isWaiting.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if(!hasFrameCommands())
+			return;
+		isWaiting.store(false, std::memory_order_relaxed);
+	}
+}
+
+bool EmuSystemTask::processFrameCommands()
+{
+	bool hasUpdate{};
+	while(auto params = frameParamsQueue.pop())
+	{
+		frameParams = *params;
+		hasUpdate = true;
+	}
+	if(framePresented.exchange(false, std::memory_order_acquire))
+	{
+		framePending = false;
+		hasUpdate = true;
+	}
+	if(!hasUpdate || !hasTime(frameParams.timestamp))
+		return hasUpdate;
+	if(!framePending)
+	{
+		auto params = std::exchange(frameParams, {});
+		bool renderingFrame = app.advanceFrames(params, this);
+		if(params.isFromRenderer())
+		{
+			framePending = false;
+			if(!renderingFrame)
+			{
+				app.emuWindow().postDraw(1);
+			}
+		}
+	}
+	else
+	{
+		log.debug("previous async frame not ready yet");
+		doIfUsed(app.frameTimeStats, [&](auto &stats) { stats.missedFrameCallbacks++; });
+	}
+	return true;
+}
+
+bool EmuSystemTask::hasFrameCommands()
+{
+	return !frameParamsQueue.empty() || framePresented.load(std::memory_order_relaxed);
+}
+
+bool EmuSystemTask::spinForFrameCommands()
+{
+	// the next update often arrives shortly after a frame is submitted,
+	// so catching it here avoids a sleep and wakeup
+	static const bool canSpin = std::thread::hardware_concurrency() > 1;
+	if(!canSpin)
+		return false;
+	auto endTime = SteadyClock::now() + spinWaitTime;
+	do
+	{
+		if(hasFrameCommands())
+			return true;
+		cpuRelax();
+	} while(SteadyClock::now() < endTime);
+	return false;
+}
+
+void EmuSystemTask::wakeIfWaiting()
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if(isWaiting.exchange(false, std::memory_order_relaxed))
+		frameEvent.notify();
+}
+
 void EmuSystemTask::pause()
 {
 	if(!taskThread.joinable())
@@ -129,18 +195,36 @@ void EmuSystemTask::stop()
 	app.flushMainThreadMessages();
 }
 
+// Runs the function on the task thread and waits for it to return, starting the thread
+// without emulating any frames if it isn't running yet
+void EmuSystemTask::run(DelegateFunc<void()> func)
+{
+	if(thisThreadId() == threadId_)
+	{
+		func();
+		return;
+	}
+	start();
+	commandPort.send({.command = RunCommand{func}}, MessageReplyMode::wait);
+}
+
 void EmuSystemTask::updateFrameParams(FrameParams params)
 {
 	if(!taskThread.joinable()) [[unlikely]]
 		return;
-	commandPort.send({.command = FrameParamsCommand{params}});
+	if(!frameParamsQueue.push(params)) [[unlikely]]
+	{
+		log.debug("frame params queue full, task thread is stalled");
+	}
+	wakeIfWaiting();
 }
 
 void EmuSystemTask::notifyFramePresented()
 {
 	if(!taskThread.joinable()) [[unlikely]]
 		return;
-	commandPort.send({.command = FramePresentedCommand{}});
+	framePresented.store(true, std::memory_order_release);
+	wakeIfWaiting();
 }
 
 void EmuSystemTask::sendVideoFormatChangedReply(EmuVideo &video)
@@ -54,6 +54,17 @@ bool EmuVideo::hasRendererTask() const
 	return rTask;
 }
 
+// Without a renderer, frames go to a system memory buffer and are discarded,
+// letting the emulated system run its normal video path with no window or GPU
+void EmuVideo::setHeadless(EmuSystem &sys, IG::PixelFormat fmt)
+{
+	assert(!rTask);
+	headless = true;
+	renderFmt = fmt;
+	headlessImg = {};
+	sys.onVideoRenderFormatChange(*this, fmt);
+}
+
 static bool isValidRenderFormat(IG::PixelFormat fmt)
 {
 	return fmt == IG::PIXEL_FMT_RGBA8888 ||
@@ -67,6 +78,12 @@ bool EmuVideo::setFormat(IG::PixmapDesc desc, EmuSystemTaskContext taskCtx)
 	{
 		return false; // no change to size/format
 	}
+	if(isHeadless())
+	{
+		headlessImg = {desc};
+		return true;
+	}
+	endDirectFrame();
 	if(!vidImg)
 	{
 		Gfx::TextureConfig conf{desc, samplerConfig()};
@@ -97,6 +114,8 @@ void EmuVideo::dispatchFormatChanged()
 
 EmuVideoImage EmuVideo::startFrame(EmuSystemTaskContext taskCtx)
 {
+	if(isHeadless())
+		return {taskCtx, *this, Gfx::LockedTextureBuffer{nullptr, headlessImg.view(), {}, 0, false}};
 	auto lockedTex = vidImg.lock();
 	return {taskCtx, *this, lockedTex};
 }
@@ -142,6 +161,42 @@ void EmuVideo::startUnchangedFrame(EmuSystemTaskContext taskCtx)
 	postFrameFinished(taskCtx);
 }
 
+// Locks the texture before emulating a frame so the core can render into it in the final
+// pixel format, skipping the copy from its own buffer. Passing the returned pixmap to any of
+// the startFrame()/finishFrame() functions submits it without copying. An empty pixmap is
+// returned if the texture can't be locked, in which case the core renders to its own buffer
+// and the frame gets copied as usual.
+MutablePixmapView EmuVideo::startDirectFrame(EmuSystemTaskContext taskCtx, IG::PixmapDesc desc)
+{
+	assert(!directTexBuff);
+	setFormat(desc, taskCtx);
+	if(isHeadless())
+		return headlessImg.view();
+	directTexBuff = vidImg.lock();
+	if(!directTexBuff) [[unlikely]]
+	{
+		log.warn("can't lock texture for direct rendering, using copy fallback");
+		return {};
+	}
+	assumeExpr(directTexBuff.pixmap().desc() == desc);
+	return directTexBuff.pixmap();
+}
+
+// Releases the texture without presenting it if the core didn't submit the direct frame
+void EmuVideo::endDirectFrame()
+{
+	if(!directTexBuff)
+		return;
+	vidImg.cancelLock(std::exchange(directTexBuff, {}));
+}
+
+bool EmuVideo::isDirectFrame(IG::PixmapView pix) const
+{
+	if(isHeadless())
+		return headlessImg && pix.data() == headlessImg.view().data();
+	return directTexBuff && pix.data() == directTexBuff.pixmap().data();
+}
+
 void EmuVideo::dispatchFrameFinished()
 {
 	//log.debug("frame finished");
@@ -158,6 +213,8 @@ void EmuVideo::postFrameFinished(EmuSystemTaskContext taskCtx)
 
 void EmuVideo::finishFrame(EmuSystemTaskContext taskCtx, Gfx::LockedTextureBuffer texBuff)
 {
+	if(isHeadless())
+		return;
 	if(screenshotNextFrame) [[unlikely]]
 	{
 		doScreenshot(taskCtx, texBuff.pixmap());
@@ -169,6 +226,19 @@ void EmuVideo::finishFrame(EmuSystemTaskContext taskCtx, Gfx::LockedTextureBuffe
 
 void EmuVideo::finishFrame(EmuSystemTaskContext taskCtx, IG::PixmapView pix)
 {
+	if(isDirectFrame(pix))
+	{
+		assumeExpr(formatIsEqual(pix.desc()));
+		finishFrame(taskCtx, std::exchange(directTexBuff, {}));
+		return;
+	}
+	if(isHeadless())
+	{
+		// stand in for the texture upload
+		if(formatIsEqual(pix.desc()))
+			headlessImg.view().write(pix);
+		return;
+	}
 	if(screenshotNextFrame) [[unlikely]]
 	{
 		doScreenshot(taskCtx, pix);
@@ -180,7 +250,7 @@ void EmuVideo::finishFrame(EmuSystemTaskContext taskCtx, IG::PixmapView pix)
 
 void EmuVideo::clear()
 {
-	if(!vidImg)
+	if(isHeadless() || !vidImg)
 		return;
 	vidImg.clear();
 }
@@ -248,6 +318,8 @@ void EmuVideoImage::endFrame()
 
 WSize EmuVideo::size() const
 {
+	if(isHeadless() && headlessImg)
+		return headlessImg.desc().size;
 	if(!vidImg)
 		return {1, 1};
 	else
@@ -256,6 +328,8 @@ WSize EmuVideo::size() const
 
 bool EmuVideo::formatIsEqual(IG::PixmapDesc desc) const
 {
+	if(isHeadless())
+		return headlessImg && desc == headlessImg.desc();
 	return vidImg && desc == vidImg.pixmapDesc();
 }
 
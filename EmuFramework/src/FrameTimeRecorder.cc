@@ -0,0 +1,147 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/FrameTimeRecorder.hh>
+#include <imagine/util/utility.h>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <format>
+#include <limits>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"FrameTimeRecorder"};
+
+void FrameTimeRecorder::start(size_t capacity)
+{
+	log.info("recording timing of last {} frames", capacity);
+	records = DynArray<FrameTimeRecord>{capacity};
+	nextIdx = count = 0;
+	lastMissedFrameCallbacks = 0;
+	lastAudioUnderruns = 0;
+}
+
+void FrameTimeRecorder::stop()
+{
+	records = {};
+	nextIdx = count = 0;
+}
+
+static uint16_t clampedDelta(auto current, auto &last)
+{
+	auto delta = current >= last ? current - last : current;
+	last = current;
+	return std::min(delta, decltype(delta)(std::numeric_limits<uint16_t>::max()));
+}
+
+void FrameTimeRecorder::add(FrameTimeStats stats, unsigned audioUnderruns)
+{
+	if(!isActive())
+		return;
+	records[nextIdx] =
+	{
+		.stats = stats,
+		.missedFrameCallbacks = clampedDelta(stats.missedFrameCallbacks, lastMissedFrameCallbacks),
+		.audioUnderruns = clampedDelta(audioUnderruns, lastAudioUnderruns),
+	};
+	nextIdx = (nextIdx + 1) % records.size();
+	count = std::min(count + 1, records.size());
+}
+
+const FrameTimeRecord &FrameTimeRecorder::operator[](size_t idx) const
+{
+	assumeExpr(idx < count);
+	auto oldestIdx = count < records.size() ? 0 : nextIdx;
+	return records[(oldestIdx + idx) % records.size()];
+}
+
+static double msBetween(SteadyClockTimePoint start, SteadyClockTimePoint end)
+{
+	if(!hasTime(start) || !hasTime(end))
+		return 0.;
+	return duration_cast<FloatSeconds>(end - start).count() * 1000.;
+}
+
+std::string FrameTimeRecorder::toCSV() const
+{
+	std::string csv{"frame,startMs,intervalMs,emulationMs,helperThreadMs,submitFrameMs,postDrawMs,drawMs,presentMs,totalMs,"
+		"advancedFrames,missedFrameCallbacks,audioUnderruns\n"};
+	if(!count)
+		return csv;
+	auto firstStart = (*this)[0].stats.startOfFrame;
+	SteadyClockTimePoint prevStart{};
+	for(size_t i = 0; i < count; i++)
+	{
+		auto &r = (*this)[i];
+		auto &s = r.stats;
+		std::format_to(std::back_inserter(csv), "{},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{},{},{}\n",
+			i, msBetween(firstStart, s.startOfFrame), msBetween(prevStart, s.startOfFrame),
+			msBetween(s.startOfEmulation, s.aboutToSubmitFrame), duration_cast<FloatSeconds>(s.helperThreadTime).count() * 1000.,
+			msBetween(s.aboutToSubmitFrame, s.aboutToPostDraw),
+			msBetween(s.aboutToPostDraw, s.startOfDraw), msBetween(s.startOfDraw, s.aboutToPresent),
+			msBetween(s.aboutToPresent, s.endOfDraw), msBetween(s.startOfFrame, s.endOfDraw),
+			s.advancedFrames, r.missedFrameCallbacks, r.audioUnderruns);
+		prevStart = s.startOfFrame;
+	}
+	return csv;
+}
+
+std::string FrameTimeRecorder::toTraceEventJSON() const
+{
+	// Chrome trace event format, viewable in chrome://tracing or Perfetto
+	constexpr int emuThreadId = 1, mainThreadId = 2;
+	std::string json{"{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+		"{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Emulation\"}},\n"
+		"{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"Main\"}}"};
+	if(count)
+	{
+		auto firstStart = (*this)[0].stats.startOfFrame;
+		auto toUs = [&](SteadyClockTimePoint t) { return duration_cast<Microseconds>(t - firstStart).count(); };
+		auto addSpan = [&](const char *name, int tid, size_t frame, SteadyClockTimePoint start, SteadyClockTimePoint end)
+		{
+			if(!hasTime(start) || !hasTime(end) || end < start)
+				return;
+			std::format_to(std::back_inserter(json),
+				",\n{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{},\"dur\":{},\"args\":{{\"frame\":{}}}}}",
+				name, tid, toUs(start), duration_cast<Microseconds>(end - start).count(), frame);
+		};
+		auto addInstant = [&](const char *name, size_t frame, SteadyClockTimePoint t, int value)
+		{
+			std::format_to(std::back_inserter(json),
+				",\n{{\"name\":\"{}\",\"ph\":\"i\",\"s\":\"p\",\"pid\":1,\"tid\":{},\"ts\":{},\"args\":{{\"frame\":{},\"count\":{}}}}}",
+				name, emuThreadId, toUs(t), frame, value);
+		};
+		for(size_t i = 0; i < count; i++)
+		{
+			auto &r = (*this)[i];
+			auto &s = r.stats;
+			addSpan("Frame", mainThreadId, i, s.startOfFrame, s.endOfDraw);
+			addSpan("Emulate", emuThreadId, i, s.startOfEmulation, s.aboutToSubmitFrame);
+			addSpan("Submit Frame", emuThreadId, i, s.aboutToSubmitFrame, s.aboutToPostDraw);
+			addSpan("Post Draw", mainThreadId, i, s.aboutToPostDraw, s.startOfDraw);
+			addSpan("Draw", mainThreadId, i, s.startOfDraw, s.aboutToPresent);
+			addSpan("Present", mainThreadId, i, s.aboutToPresent, s.endOfDraw);
+			if(r.missedFrameCallbacks)
+				addInstant("Missed Frame Callback", i, s.startOfFrame, r.missedFrameCallbacks);
+			if(r.audioUnderruns)
+				addInstant("Audio Underrun", i, s.startOfFrame, r.audioUnderruns);
+		}
+	}
+	json += "\n]}\n";
+	return json;
+}
+
+}
@@ -0,0 +1,214 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/HeadlessBenchmark.hh>
+#include <emuframework/EmuApp.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/pixmap/PixmapBenchmark.hh>
+#include <imagine/util/string.h>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <format>
+#include <string_view>
+#include <vector>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"Benchmark"};
+
+std::optional<HeadlessBenchmarkParams> parseHeadlessBenchmarkArgs(CommandArgs args)
+{
+	if(args.c < 2)
+		return {};
+	HeadlessBenchmarkParams params;
+	int i = 2;
+	if(std::string_view{args.v[1]} == "--benchmark-pixel-conversions")
+		params.pixelConversions = true;
+	else if(args.c >= 3 && std::string_view{args.v[1]} == "--benchmark")
+		params.contentPath = args.v[i++];
+	else
+		return {};
+	for(; i < args.c; i++)
+	{
+		std::string_view arg{args.v[i]};
+		bool hasValue = i + 1 < args.c;
+		if(arg == "--frames" && hasValue)
+		{
+			std::string_view val{args.v[++i]};
+			if(std::from_chars(val.data(), val.data() + val.size(), params.frames).ec != std::errc{} || params.frames < 1)
+			{
+				log.error("invalid frame count:{}", val);
+				params.frames = defaultHeadlessBenchmarkFrames;
+			}
+		}
+		else if(arg == "--state" && hasValue)
+			params.statePath = args.v[++i];
+		else if(arg == "--output" && hasValue)
+			params.outputPath = args.v[++i];
+		else if(arg == "--no-video")
+			params.video = false;
+		else if(arg == "--no-audio")
+			params.audio = false;
+		else
+			log.warn("ignoring unknown benchmark argument:{}", arg);
+	}
+	return params;
+}
+
+FrameTimeSummary summarizeFrameTimes(std::span<const SteadyClockTime> frameTimes)
+{
+	if(frameTimes.empty())
+		return {};
+	std::vector<SteadyClockTime> sorted{frameTimes.begin(), frameTimes.end()};
+	std::ranges::sort(sorted);
+	// nearest-rank percentile
+	auto percentile = [&](double p)
+	{
+		auto rank = std::max(size_t(std::ceil(p * sorted.size())), 1zu);
+		return duration_cast<FloatSeconds>(sorted[rank - 1]);
+	};
+	SteadyClockTime total{};
+	for(auto t : sorted)
+		total += t;
+	auto totalSecs = duration_cast<FloatSeconds>(total);
+	return
+	{
+		.total = totalSecs,
+		.mean = totalSecs / sorted.size(),
+		.p50 = percentile(.5),
+		.p99 = percentile(.99),
+		.max = duration_cast<FloatSeconds>(sorted.back()),
+		.fps = sorted.size() / totalSecs.count(),
+	};
+}
+
+static std::string jsonEscaped(std::string_view str)
+{
+	std::string out;
+	out.reserve(str.size());
+	for(auto c : str)
+	{
+		if(c == '"' || c == '\\')
+			out += '\\';
+		if(uint8_t(c) < 0x20)
+		{
+			out += std::format("\\u{:04x}", c);
+			continue;
+		}
+		out += c;
+	}
+	return out;
+}
+
+static int writeBenchmarkResult(const HeadlessBenchmarkParams &params, const std::string &json)
+{
+	if(params.outputPath.size())
+	{
+		if(FileUtils::writeToPath(params.outputPath, std::span{reinterpret_cast<const unsigned char*>(json.data()), json.size()}) != ssize_t(json.size()))
+		{
+			std::fprintf(stderr, "Error writing %s\n", params.outputPath.c_str());
+			return 1;
+		}
+	}
+	else
+	{
+		std::fputs(json.c_str(), stdout);
+	}
+	return 0;
+}
+
+// Checks the SIMD pixel format conversions match the scalar versions and reports their timings
+static int runPixelConversionBenchmark(const HeadlessBenchmarkParams &params)
+{
+	auto results = benchmarkPixelConversions();
+	bool bitExact = std::ranges::all_of(results, &PixelConversionBenchmark::bitExact);
+	auto toUs = [](FloatSeconds t){ return t.count() * 1e6; };
+	std::string json = std::format("{{\"bitExact\":{},\"conversions\":[", bitExact);
+	for(const auto &r : results)
+	{
+		if(&r != &results.front())
+			json += ',';
+		json += std::format("{{\"name\":\"{}\",\"bitExact\":{},\"simdUs\":{:.3f},\"scalarUs\":{:.3f}}}",
+			wise_enum::to_string(r.conversion), r.bitExact, toUs(r.simdTime), toUs(r.scalarTime));
+	}
+	json += "]}\n";
+	log.info("pixel conversion benchmark result:{}", json);
+	if(writeBenchmarkResult(params, json))
+		return 1;
+	return bitExact ? 0 : 1;
+}
+
+int EmuApp::runHeadlessBenchmark(const HeadlessBenchmarkParams &params)
+{
+	if(params.pixelConversions)
+		return runPixelConversionBenchmark(params);
+	auto ctx = appContext();
+	auto &sys = system();
+	log.info("running headless benchmark of {} for {} frames", params.contentPath, params.frames);
+	autosaveManager.resetSlot(noAutosaveName);
+	EmuVideo *videoPtr{};
+	if(params.video)
+	{
+		video.setHeadless(sys, EmuSystem::canRenderRGBA8888 ? IG::PIXEL_RGBA8888 : IG::PIXEL_RGB565);
+		videoPtr = &video;
+	}
+	try
+	{
+		sys.createWithMedia({}, params.contentPath, ctx.fileUriDisplayName(params.contentPath), {},
+			[](int, int, const char *){ return true; });
+		if(params.statePath.size())
+			sys.loadState(*this, params.statePath);
+	}
+	catch(std::exception &err)
+	{
+		log.error("error loading content:{}", err.what());
+		std::fprintf(stderr, "Error: %s\n", err.what());
+		return 1;
+	}
+	sys.configFrameTime(audio.rate(), sys.frameTime());
+	EmuAudio *audioPtr{};
+	if(params.audio && EmuSystem::hasSound)
+	{
+		audio.startHeadless(FloatSeconds{1.});
+		audioPtr = &audio;
+	}
+	sys.resetFrameTime();
+	sys.onStart();
+	std::vector<SteadyClockTime> frameTimes(params.frames);
+	for(auto &t : frameTimes)
+	{
+		auto start = SteadyClock::now();
+		sys.runFrame({}, videoPtr, audioPtr);
+		t = SteadyClock::now() - start;
+		if(audioPtr)
+			audio.discardFrames();
+	}
+	auto summary = summarizeFrameTimes(frameTimes);
+	auto toMs = [](FloatSeconds t){ return t.count() * 1000.; };
+	auto json = std::format("{{\"system\":\"{}\",\"content\":\"{}\",\"frames\":{},\"video\":{},\"audio\":{},\"state\":{},"
+		"\"totalSecs\":{:.6f},\"fps\":{:.3f},\"frameTimeMs\":{{\"mean\":{:.4f},\"p50\":{:.4f},\"p99\":{:.4f},\"max\":{:.4f}}}}}\n",
+		sys.shortSystemName(), jsonEscaped(sys.contentDisplayName()), params.frames, bool(videoPtr), bool(audioPtr),
+		params.statePath.size() > 0, summary.total.count(), summary.fps,
+		toMs(summary.mean), toMs(summary.p50), toMs(summary.p99), toMs(summary.max));
+	log.info("benchmark result:{}", json);
+	sys.closeSystem();
+	return writeBenchmarkResult(params, json);
+}
+
+}
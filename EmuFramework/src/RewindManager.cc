@@ -15,9 +15,12 @@
 
 #include <emuframework/RewindManager.hh>
 #include <emuframework/EmuApp.hh>
+#include <emuframework/EmuSystemTaskContext.hh>
 #include <emuframework/Option.hh>
 #include <emuframework/EmuOptions.hh>
 #include <imagine/logger/logger.h>
+#include <algorithm>
+#include <cstring>
 
 namespace EmuEx
 {
@@ -25,6 +28,122 @@ namespace EmuEx
 constexpr SystemLogger log{"RewindMgr"};
 constexpr Seconds defaultSaveFreq{1};
 
+// Delta format: varint older state size, then a series of varint (skip, literal) word
+// counts, each followed by the literal words XORed between the older & newer state.
+// Applying a delta to either state yields the other since XOR is its own inverse.
+
+using DeltaWord = uint64_t;
+
+static DeltaWord loadWord(const uint8_t *p)
+{
+	DeltaWord w;
+	std::memcpy(&w, p, sizeof(w));
+	return w;
+}
+
+static void storeWord(uint8_t *p, DeltaWord w)
+{
+	std::memcpy(p, &w, sizeof(w));
+}
+
+static size_t varintSize(size_t v)
+{
+	size_t size = 1;
+	while(v >>= 7)
+		size++;
+	return size;
+}
+
+static uint8_t *writeVarint(uint8_t *p, size_t v)
+{
+	while(v >= 0x80)
+	{
+		*p++ = uint8_t(v | 0x80);
+		v >>= 7;
+	}
+	*p++ = uint8_t(v);
+	return p;
+}
+
+static size_t readVarint(const uint8_t *&p, const uint8_t *end)
+{
+	size_t v{};
+	for(unsigned shift = 0; p != end; shift += 7)
+	{
+		auto b = *p++;
+		v |= size_t(b & 0x7F) << shift;
+		if(!(b & 0x80))
+			break;
+	}
+	return v;
+}
+
+static constexpr size_t deltaBufferSize(size_t stateSize)
+{
+	return (stateSize + sizeof(DeltaWord) - 1) & ~(sizeof(DeltaWord) - 1);
+}
+
+// returns the encoded size, only writing the output if out is non-null
+static size_t encodeDelta(const uint8_t *older, const uint8_t *newer, size_t bytes,
+	size_t olderStateSize, uint8_t *out)
+{
+	const size_t words = bytes / sizeof(DeltaWord);
+	size_t outSize = varintSize(olderStateSize);
+	if(out)
+		out = writeVarint(out, olderStateSize);
+	size_t i{};
+	while(i < words)
+	{
+		auto skipStart = i;
+		while(i < words && loadWord(older + i * sizeof(DeltaWord)) == loadWord(newer + i * sizeof(DeltaWord)))
+			i++;
+		if(i == words)
+			break;
+		auto litStart = i;
+		while(i < words && loadWord(older + i * sizeof(DeltaWord)) != loadWord(newer + i * sizeof(DeltaWord)))
+			i++;
+		auto skip = litStart - skipStart;
+		auto lits = i - litStart;
+		outSize += varintSize(skip) + varintSize(lits) + lits * sizeof(DeltaWord);
+		if(out)
+		{
+			out = writeVarint(out, skip);
+			out = writeVarint(out, lits);
+			for(auto w = litStart; w < i; w++)
+			{
+				auto offset = w * sizeof(DeltaWord);
+				storeWord(out, loadWord(older + offset) ^ loadWord(newer + offset));
+				out += sizeof(DeltaWord);
+			}
+		}
+	}
+	return outSize;
+}
+
+// converts state to the other side of the delta in place, returning the older state size
+static size_t applyDelta(std::span<uint8_t> state, std::span<const uint8_t> delta)
+{
+	const size_t words = state.size() / sizeof(DeltaWord);
+	auto p = delta.data();
+	auto end = p + delta.size();
+	auto olderStateSize = readVarint(p, end);
+	size_t i{};
+	while(p != end)
+	{
+		i += readVarint(p, end);
+		auto lits = readVarint(p, end);
+		assumeExpr(i + lits <= words);
+		for(auto w = i; w < i + lits; w++)
+		{
+			auto statePtr = state.data() + w * sizeof(DeltaWord);
+			storeWord(statePtr, loadWord(statePtr) ^ loadWord(p));
+			p += sizeof(DeltaWord);
+		}
+		i += lits;
+	}
+	return olderStateSize;
+}
+
 RewindManager::RewindManager(EmuApp &app):
 	saveTimer
 	{
@@ -39,11 +158,24 @@ RewindManager::RewindManager(EmuApp &app):
 		}
 	} {}
 
+RewindManager::~RewindManager()
+{
+	stopDeltaThread();
+}
+
 void RewindManager::clear()
 {
 	saveTimer.cancel();
+	setHeld(false);
+	stopDeltaThread();
 	stateEntries = {};
 	stateIdx = 0;
+	keyframe = {};
+	scratchState = {};
+	deltaData = {};
+	clearDeltas();
+	keyframeSize = 0;
+	frameCount = 0;
 	stateSize = 0;
 }
 
@@ -51,12 +183,42 @@ bool RewindManager::reset()
 {
 	if(!stateSize)
 		return true;
+	waitForDeltaThread();
+	stateIdx = 0;
+	keyframeSize = 0;
+	frameCount = 0;
+	clearDeltas();
 	try
 	{
-		if(maxStates)
-			log.info("allocating {} states of size:{}", maxStates, stateSize);
-		stateEntries.reset(maxStates, stateSize);
-		stateIdx = 0;
+		if(mode == RewindMode::Delta)
+		{
+			stateEntries = {};
+			if(memoryMB)
+			{
+				log.info("allocating {}MB for deltas of state size:{}", memoryMB, stateSize);
+				keyframe.reset(deltaBufferSize(stateSize));
+				scratchState.reset(deltaBufferSize(stateSize));
+				deltaData.resetForOverwrite(size_t(memoryMB) * 1024 * 1024);
+				startDeltaThread();
+			}
+			else
+			{
+				stopDeltaThread();
+				keyframe = {};
+				scratchState = {};
+				deltaData = {};
+			}
+		}
+		else
+		{
+			stopDeltaThread();
+			keyframe = {};
+			scratchState = {};
+			deltaData = {};
+			if(maxStates)
+				log.info("allocating {} states of size:{}", maxStates, stateSize);
+			stateEntries.reset(maxStates, stateSize);
+		}
 		return true;
 	}
 	catch(...)
@@ -67,36 +229,231 @@ bool RewindManager::reset()
 
 void RewindManager::saveState(EmuApp &app)
 {
+	app.syncEmulationThread();
+	writeState(app.system());
+}
+
+bool RewindManager::writeState(EmuSystem &sys)
+{
+	if(mode == RewindMode::Delta)
+		return writeDeltaState(sys);
 	assumeExpr(maxStates);
 	assumeExpr(stateIdx < maxStates);
 	//log.debug("saving rewind state index:{}", stateIdx);
 	auto &entry = stateEntries[stateIdx];
 	stateIdx = stateIdx + 1 == maxStates ? 0 : stateIdx + 1;
-	entry.size = app.writeState({entry.data, stateSize}, {.uncompressed = true});
+	entry.size = sys.writeState({entry.data, stateSize}, {.uncompressed = true});
+	return true;
 }
 
-void RewindManager::rewindState(EmuApp &app)
+bool RewindManager::writeDeltaState(EmuSystem &sys)
+{
+	if(deltaPending.load(std::memory_order::acquire))
+	{
+		//log.debug("previous delta still encoding, skipping state");
+		return false;
+	}
+	auto &newState = keyframeSize ? scratchState : keyframe;
+	auto newStateSize = sys.writeState({newState.data(), stateSize}, {.uncompressed = true});
+	// clear the padding so stale bytes from a larger previous state don't end up in the delta
+	std::fill(newState.begin() + newStateSize, newState.end(), 0);
+	if(!keyframeSize)
+	{
+		keyframeSize = newStateSize;
+		return true;
+	}
+	scratchStateSize = newStateSize;
+	deltaPending.store(true, std::memory_order::release);
+	deltaSem.release();
+	return true;
+}
+
+void RewindManager::encodeScratchState()
+{
+	auto deltaSize = encodeDelta(keyframe.data(), scratchState.data(), keyframe.size(), keyframeSize, nullptr);
+	if(auto deltaPtr = allocDelta(deltaSize))
+	{
+		encodeDelta(keyframe.data(), scratchState.data(), keyframe.size(), keyframeSize, deltaPtr);
+		//log.debug("saved delta of size:{} ({} total)", deltaSize, deltaCount());
+	}
+	else
+	{
+		log.warn("delta size:{} exceeds rewind memory, discarding older states", deltaSize);
+		clearDeltas();
+	}
+	std::swap(keyframe, scratchState);
+	keyframeSize = scratchStateSize;
+}
+
+void RewindManager::startDeltaThread()
 {
-	if(!maxStates)
+	if(deltaThread.joinable())
 		return;
-	assumeExpr(stateIdx < maxStates);
-	auto prevIdx = stateIdx ? stateIdx - 1 : maxStates - 1;
-	auto &entry = stateEntries[prevIdx];
-	if(!entry.size)
+	deltaThread.reset([this](WorkThread::Context ctx)
+	{
+		while(true)
+		{
+			deltaSem.acquire();
+			if(ctx.stop) [[unlikely]]
+				return;
+			encodeScratchState();
+			deltaPending.store(false, std::memory_order::release);
+			deltaPending.notify_all();
+		}
+	});
+}
+
+void RewindManager::stopDeltaThread()
+{
+	if(!deltaThread.joinable())
 		return;
-	log.info("rewinding to state index:{}", prevIdx);
-	app.readState({entry.data, std::exchange(entry.size, 0)});
-	stateIdx = prevIdx;
-	saveTimer.reset();
+	waitForDeltaThread();
+	deltaThread.requestStop(ThreadStop::QUIT);
+	deltaSem.release();
+	deltaThread.join();
+}
+
+void RewindManager::waitForDeltaThread()
+{
+	deltaPending.wait(true, std::memory_order::acquire);
+}
+
+uint8_t *RewindManager::allocDelta(size_t size)
+{
+	if(size > deltaData.size())
+		return {};
+	size_t endPos = hasDeltas() ? deltaEntries.back().offset + deltaEntries.back().size : 0;
+	size_t pos = endPos;
+	bool wrapped = pos + size > deltaData.size();
+	if(wrapped)
+		pos = 0;
+	// the oldest deltas are the ones directly ahead of the write position, evict until there's room
+	while(hasDeltas())
+	{
+		const auto &oldest = deltaEntries[oldestDeltaIdx];
+		bool isPastWrap = wrapped && oldest.offset >= endPos;
+		bool overlaps = oldest.offset < pos + size && pos < oldest.offset + oldest.size;
+		if(!isPastWrap && !overlaps)
+			break;
+		popOldestDelta();
+	}
+	deltaEntries.emplace_back(pos, size);
+	return deltaData.data() + pos;
+}
+
+void RewindManager::popOldestDelta()
+{
+	assumeExpr(hasDeltas());
+	oldestDeltaIdx++;
+	if(!hasDeltas())
+	{
+		clearDeltas();
+	}
+	else if(oldestDeltaIdx > deltaEntries.size() / 2)
+	{
+		deltaEntries.erase(deltaEntries.begin(), deltaEntries.begin() + oldestDeltaIdx);
+		oldestDeltaIdx = 0;
+	}
+}
+
+void RewindManager::popNewestDelta()
+{
+	assumeExpr(hasDeltas());
+	deltaEntries.pop_back();
+	if(!hasDeltas())
+		clearDeltas();
+}
+
+void RewindManager::clearDeltas()
+{
+	deltaEntries.clear();
+	oldestDeltaIdx = 0;
+}
+
+bool RewindManager::popState(auto &&readState)
+{
+	waitForDeltaThread();
+	if(mode == RewindMode::Delta)
+	{
+		if(!keyframeSize)
+			return false;
+		log.info("rewinding to delta state, {} older state(s) remaining", deltaCount());
+		readState(std::span<uint8_t>{keyframe.data(), keyframeSize});
+		if(hasDeltas())
+		{
+			const auto &entry = deltaEntries.back();
+			keyframeSize = applyDelta(keyframe, {deltaData.data() + entry.offset, entry.size});
+			popNewestDelta();
+		}
+		else
+		{
+			keyframeSize = 0;
+		}
+	}
+	else
+	{
+		if(!maxStates)
+			return false;
+		assumeExpr(stateIdx < maxStates);
+		auto prevIdx = stateIdx ? stateIdx - 1 : maxStates - 1;
+		auto &entry = stateEntries[prevIdx];
+		if(!entry.size)
+			return false;
+		log.info("rewinding to state index:{}", prevIdx);
+		readState(std::span<uint8_t>{entry.data, std::exchange(entry.size, 0)});
+		stateIdx = prevIdx;
+	}
+	frameCount = 0;
+	return true;
+}
+
+void RewindManager::rewindState(EmuApp &app)
+{
+	if(!hasStorage())
+		return;
+	app.syncEmulationThread();
+	if(popState([&](std::span<uint8_t> buff){ app.readState(buff); }))
+		saveTimer.reset();
+}
+
+bool RewindManager::rewindFrame(EmuApp &app, EmuSystemTaskContext taskCtx, EmuVideo *video)
+{
+	auto &sys = app.system();
+	try
+	{
+		if(!popState([&](std::span<uint8_t> buff){ sys.readState(app, buff); }))
+		{
+			log.info("no more rewind states, resuming emulation");
+			setHeld(false);
+			return false;
+		}
+	}
+	catch(std::exception &err)
+	{
+		log.error("error loading rewind state:{}", err.what());
+		setHeld(false);
+		return false;
+	}
+	sys.runFrame(taskCtx, video, nullptr);
+	return true;
 }
 
 void RewindManager::startTimer()
 {
-	if(!stateEntries.size())
+	if(!hasStorage() || frameInterval())
 		return;
 	saveTimer.start();
 }
 
+void RewindManager::setFrameInterval(EmuApp &app, uint8_t interval)
+{
+	frameInterval_.store(interval, std::memory_order::relaxed);
+	if(interval)
+		saveTimer.pause();
+	else if(app.system().isActive())
+		startTimer();
+}
+
 void RewindManager::pauseTimer()
 {
 	saveTimer.pause();
@@ -113,6 +470,13 @@ bool RewindManager::readConfig(MapIO &io, unsigned key)
 			if(s > 0)
 				saveTimer.frequency = Seconds{s};
 		});
+		case CFGKEY_REWIND_MODE: return readOptionValue(io, mode, [](auto m){ return m <= lastEnum<RewindMode>; });
+		case CFGKEY_REWIND_MEMORY_MB: return readOptionValue<uint16_t>(io, [&](auto mb)
+		{
+			if(mb <= maxRewindMemoryMB)
+				memoryMB = mb;
+		});
+		case CFGKEY_REWIND_FRAME_INTERVAL: return readOptionValue<uint8_t>(io, [&](auto i){ frameInterval_.store(i, std::memory_order::relaxed); });
 	}
 }
 
@@ -120,6 +484,9 @@ void RewindManager::writeConfig(FileIO &io) const
 {
 	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_STATES, uint32_t(maxStates), 0u);
 	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_TIMER_SECS, int16_t(saveTimer.frequency.count()), defaultSaveFreq.count());
+	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_MODE, mode, RewindMode::Full);
+	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_MEMORY_MB, memoryMB, defaultRewindMemoryMB);
+	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_FRAME_INTERVAL, frameInterval(), uint8_t{});
 }
 
 
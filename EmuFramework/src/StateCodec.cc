@@ -0,0 +1,148 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/StateCodec.hh>
+#include <imagine/util/zlib.hh>
+#include <imagine/util/lz4.hh>
+#include <imagine/util/ranges.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <utility>
+#include <stdexcept>
+#include <format>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"StateCodec"};
+
+// Header layout:
+// 0-3: magic, 4: format version, 5: StateCodec, 6: compression level, 7: reserved,
+// 8-11: uncompressed size (little endian)
+constexpr std::array<uint8_t, 4> headerMagic{'E', 'X', 'S', 'T'};
+constexpr uint8_t headerVersion = 1;
+
+StateCodecParams stateCodecParams(StateCompression c)
+{
+	switch(c)
+	{
+		case StateCompression::None: return {StateCodec::None, 0};
+		case StateCompression::Fast: return {StateCodec::LZ4, 1};
+		case StateCompression::Default: return {StateCodec::Gzip, 6};
+		case StateCompression::Max: return {StateCodec::Gzip, 9};
+	}
+	std::unreachable();
+}
+
+// gzip adds 12 more bytes of header & trailer than the zlib format compressBound() assumes
+static size_t gzipCompressBound(size_t size) { return compressBound(size) + 12; }
+
+size_t compressStateBound(size_t size)
+{
+	return stateHeaderSize + std::max(gzipCompressBound(size), lz4CompressBound(size));
+}
+
+size_t compressState(std::span<uint8_t> dest, std::span<const uint8_t> src, StateCompression compression)
+{
+	if(dest.size() < stateHeaderSize || src.size() > UINT32_MAX)
+		return 0;
+	auto params = stateCodecParams(compression);
+	auto [codec, level] = params;
+	auto payload = dest.subspan(stateHeaderSize);
+	size_t payloadSize{};
+	switch(codec)
+	{
+		case StateCodec::None:
+			if(payload.size() < src.size())
+				return 0;
+			std::ranges::copy(src, payload.begin());
+			payloadSize = src.size();
+			break;
+		case StateCodec::LZ4:
+			payloadSize = compressLZ4(payload, src);
+			break;
+		case StateCodec::Gzip:
+			payloadSize = compressGzip(payload, src, level);
+			break;
+	}
+	if(!payloadSize)
+		return 0;
+	writeStateHeader(dest, params, src.size());
+	return stateHeaderSize + payloadSize;
+}
+
+void writeStateHeader(std::span<uint8_t> dest, StateCodecParams params, uint32_t size)
+{
+	assert(dest.size() >= stateHeaderSize);
+	std::ranges::copy(headerMagic, dest.begin());
+	dest[4] = headerVersion;
+	dest[5] = uint8_t(params.codec);
+	dest[6] = params.level;
+	dest[7] = 0;
+	for(auto i : iotaCount(4))
+		dest[8 + i] = size >> (i * 8);
+}
+
+bool hasStateHeader(std::span<const uint8_t> buff)
+{
+	return buff.size() >= stateHeaderSize && std::equal(headerMagic.begin(), headerMagic.end(), buff.begin());
+}
+
+StateHeader readStateHeader(std::span<const uint8_t> buff, size_t maxSize)
+{
+	assert(hasStateHeader(buff));
+	if(buff[4] != headerVersion)
+		throw std::runtime_error(std::format("Unsupported state format version {}", buff[4]));
+	uint32_t size{};
+	for(auto i : iotaCount(4))
+		size |= uint32_t(buff[8 + i]) << (i * 8);
+	if(size > maxSize)
+		throw std::runtime_error(std::format("State size {} exceeds limit of {}", size, maxSize));
+	return {StateCodec(buff[5]), size};
+}
+
+DynArray<uint8_t> uncompressState(std::span<const uint8_t> buff, size_t maxSize)
+{
+	auto [codec, size] = readStateHeader(buff, maxSize);
+	auto payload = buff.subspan(stateHeaderSize);
+	auto uncompArr = dynArrayForOverwrite<uint8_t>(size);
+	size_t uncompSize{};
+	switch(codec)
+	{
+		case StateCodec::None:
+			if(payload.size() == size)
+			{
+				std::ranges::copy(payload, uncompArr.begin());
+				uncompSize = size;
+			}
+			break;
+		case StateCodec::LZ4:
+			uncompSize = uncompressLZ4(uncompArr, payload);
+			break;
+		case StateCodec::Gzip:
+			uncompSize = uncompressGzip(uncompArr, payload);
+			break;
+		default:
+			throw std::runtime_error(std::format("Unsupported state codec {}", buff[5]));
+	}
+	if(uncompSize != size)
+		throw std::runtime_error("Error uncompressing state");
+	log.debug("uncompressed {} state from {} to {} bytes", wise_enum::to_string(codec), buff.size(), size);
+	return uncompArr;
+}
+
+}
@@ -0,0 +1,130 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/StateWriter.hh>
+#include <emuframework/EmuApp.hh>
+#include <emuframework/EmuOptions.hh>
+#include <emuframework/Option.hh>
+#include <imagine/util/zlib.hh>
+#include <imagine/logger/logger.h>
+#include <format>
+#include <memory>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"StateWriter"};
+
+bool StateWriter::write(FileIO io, StateCompression compression, std::string errorPrefix, const char *successMsg)
+{
+	wait();
+	app.syncEmulationThread();
+	size_t stateSize;
+	size_t precompressedSize{};
+	try
+	{
+		auto size = app.system().stateSize();
+		if(auto bound = compressStateBound(size); compressedBuff.size() < bound)
+			compressedBuff = dynArrayForOverwrite<uint8_t>(bound);
+		if(auto params = stateCodecParams(compression);
+			EmuSystem::handlesCompressedStates && params.codec == StateCodec::Gzip)
+		{
+			// the system deflates while serializing, so no uncompressed snapshot is needed
+			// at the cost of compressing on this thread
+			stateBuff = {};
+			auto payload = std::span<uint8_t>{compressedBuff}.subspan(stateHeaderSize);
+			auto payloadSize = app.system().writeState(payload, {.compressionLevel = uint8_t(params.level)});
+			stateSize = gzipUncompressedSize(payload.first(payloadSize));
+			writeStateHeader(compressedBuff, params, stateSize);
+			precompressedSize = stateHeaderSize + payloadSize;
+		}
+		else
+		{
+			if(stateBuff.size() != size)
+				stateBuff = dynArrayForOverwrite<uint8_t>(size);
+			stateSize = app.system().writeState(stateBuff, {.uncompressed = true});
+		}
+	}
+	catch(std::exception &err)
+	{
+		app.postErrorMessage(4, std::format("{}:\n{}", errorPrefix, err.what()));
+		return false;
+	}
+	writeThread.reset([this, stateSize, precompressedSize, compression, errorPrefix = std::move(errorPrefix), successMsg](WorkThread::Context ctx, FileIO io)
+	{
+		auto compSize = precompressedSize ?: compressState(compressedBuff, {stateBuff.data(), stateSize}, compression);
+		if(!compSize) [[unlikely]]
+		{
+			postError(ctx, std::format("{}:\nError compressing state", errorPrefix));
+			return;
+		}
+		if(io.write(std::span<const uint8_t>{compressedBuff.data(), compSize}, 0).bytes != ssize_t(compSize)) [[unlikely]]
+		{
+			postError(ctx, std::format("{}:\nError writing file", errorPrefix));
+			return;
+		}
+		io.truncate(compSize);
+		io.sync();
+		log.info("wrote {} state of {} bytes ({} uncompressed)", wise_enum::to_string(compression), compSize, stateSize);
+		if(ctx.stop.isQuitting())
+			return;
+		app.runOnMainThread([this, successMsg](ApplicationContext)
+		{
+			if(successMsg)
+				app.postMessage(successMsg);
+			if(onWrite)
+				onWrite();
+		});
+	}, std::move(io));
+	return true;
+}
+
+void StateWriter::wait()
+{
+	if(!writeThread.joinable())
+		return;
+	writeThread.join();
+}
+
+void StateWriter::postError(WorkThread::Context ctx, std::string msg)
+{
+	log.error("{}", msg);
+	if(ctx.stop.isQuitting())
+		return;
+	// the delegate's storage can't hold a std::string, so pass ownership of a heap copy
+	app.runOnMainThread([msg = new std::string{std::move(msg)}](ApplicationContext ctx)
+	{
+		std::unique_ptr<std::string> msgPtr{msg};
+		EmuApp::get(ctx).postErrorMessage(4, *msgPtr);
+	});
+}
+
+bool StateWriter::readConfig(MapIO &io, unsigned key)
+{
+	switch(key)
+	{
+		default: return false;
+		case CFGKEY_STATE_COMPRESSION: return readOptionValue(io, compression, [](auto c){ return c <= lastEnum<StateCompression>; });
+		case CFGKEY_ARCHIVE_STATE_COMPRESSION: return readOptionValue(io, archiveCompression, [](auto c){ return c <= lastEnum<StateCompression>; });
+	}
+}
+
+void StateWriter::writeConfig(FileIO &io) const
+{
+	writeOptionValueIfNotDefault(io, CFGKEY_STATE_COMPRESSION, compression, StateCompression::Fast);
+	writeOptionValueIfNotDefault(io, CFGKEY_ARCHIVE_STATE_COMPRESSION, archiveCompression, StateCompression::Default);
+}
+
+}
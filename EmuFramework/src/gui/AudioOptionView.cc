@@ -104,6 +104,15 @@ AudioOptionView::AudioOptionView(ViewAttachParams attach, EmuAudio& audio_, bool
 			audio.addSoundBuffersOnUnderrunSetting = item.flipBoolValue(*this);
 		}
 	},
+	dynamicRateControl
+	{
+		"Dynamic Rate Control", attach,
+		audio_.dynamicRateControl,
+		[this](BoolMenuItem &item)
+		{
+			audio.dynamicRateControl = item.flipBoolValue(*this);
+		}
+	},
 	audioRateItem
 	{
 		[&]
@@ -131,6 +140,21 @@ AudioOptionView::AudioOptionView(ViewAttachParams attach, EmuAudio& audio_, bool
 		MenuId{audio_.rate()},
 		audioRateItem
 	},
+	resamplerQualityItem
+	{
+		{"Low (Linear)",   attach, {.id = AudioResamplerQuality::Low}},
+		{"Medium (Cubic)", attach, {.id = AudioResamplerQuality::Medium}},
+		{"High (Sinc)",    attach, {.id = AudioResamplerQuality::High}},
+	},
+	resamplerQuality
+	{
+		"Resampler Quality", attach,
+		MenuId{audio_.resamplerQuality()},
+		resamplerQualityItem,
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item) { audio.setResamplerQuality(AudioResamplerQuality(item.id.val)); }
+		},
+	},
 	audioSoloMix
 	{
 		"Mix With Other Apps", attach,
@@ -186,6 +210,8 @@ void AudioOptionView::loadStockItems()
 	}
 	item.emplace_back(&soundBuffers);
 	item.emplace_back(&addSoundBuffersOnUnderrun);
+	item.emplace_back(&dynamicRateControl);
+	item.emplace_back(&resamplerQuality);
 	if constexpr(IG::Audio::Manager::HAS_SOLO_MIX)
 	{
 		item.emplace_back(&audioSoloMix);
@@ -120,6 +120,7 @@ void EmuView::updateFrameTimeStats(FrameTimeStats stats, SteadyClockTimePoint cu
 	auto timestampDiff = duration_cast<Milliseconds>(currentFrameTimestamp - stats.startOfFrame);
 	auto callbackOverhead = duration_cast<Milliseconds>(stats.startOfEmulation - stats.startOfFrame);
 	auto emulationTime = duration_cast<Milliseconds>(stats.aboutToSubmitFrame - stats.startOfEmulation);
+	auto helperThreadTime = duration_cast<Milliseconds>(stats.helperThreadTime);
 	auto submitFrameTime = duration_cast<Milliseconds>(stats.aboutToPostDraw - stats.aboutToSubmitFrame);
 	auto postDrawTime = duration_cast<Milliseconds>(stats.startOfDraw - stats.aboutToPostDraw);
 	auto drawTime = duration_cast<Milliseconds>(stats.aboutToPresent - stats.startOfDraw);
@@ -133,23 +134,26 @@ void EmuView::updateFrameTimeStats(FrameTimeStats stats, SteadyClockTimePoint cu
 			"Timestamp Diff: {}ms\n"
 			"Frame Callback: {}ms\n"
 			"Emulate: {}ms\n"
+			"Helper Threads: {}ms\n"
 			"Submit Frame: {}ms\n"
 			"Draw Callback: {}ms\n"
 			"Draw: {}ms\n"
 			"Present: {}ms\n"
 			"Total: {}ms\n"
 			"Missed Callbacks: {}",
-			screenFrameTime.count(), deadline.count(), timestampDiff.count(), callbackOverhead.count(), emulationTime.count(), submitFrameTime.count(),
+			screenFrameTime.count(), deadline.count(), timestampDiff.count(), callbackOverhead.count(), emulationTime.count(), helperThreadTime.count(), submitFrameTime.count(),
 			postDrawTime.count(), drawTime.count(), presentTime.count(), frameTime.count(), stats.missedFrameCallbacks));
 		placeFrameTimeStats();
 	});
 }
 
-void EmuView::updateAudioStats(int underruns, int overruns, int callbacks, double avgCallbackFrames, int frames)
+void EmuView::updateAudioStats(int underruns, int overruns, int callbacks, double avgCallbackFrames, int frames,
+	float rateControlFactor, float bufferFill)
 {
 	#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
-	audioStatsText.setString(std::format("Underruns:{}\nOverruns:{}\nCallbacks per second:{}\nFrames per callback:{:g}\nTotal frames:{}",
-		underruns, overruns, callbacks, avgCallbackFrames, frames), &View::defaultFace);
+	audioStatsText.setString(std::format("Underruns:{}\nOverruns:{}\nCallbacks per second:{}\nFrames per callback:{:g}\nTotal frames:{}\n"
+		"Rate control:{:+.3f}%\nBuffer fill:{:.0f}%",
+		underruns, overruns, callbacks, avgCallbackFrames, frames, (rateControlFactor - 1.f) * 100.f, bufferFill * 100.f), &View::defaultFace);
 	place();
 	#endif
 }
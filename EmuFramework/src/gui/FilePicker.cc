@@ -57,6 +57,7 @@ FilePicker::FilePicker(ViewAttachParams attach, EmuApp &app,
 {
 	if(app.showHiddenFilesInPicker)
 		setShowHiddenFiles(true);
+	setListingCache(true);
 }
 
 std::unique_ptr<FilePicker> FilePicker::forBenchmarking(ViewAttachParams attach, const Input::Event &e, bool singleDir)
@@ -306,6 +306,26 @@ FrameTimingView::FrameTimingView(ViewAttachParams attach):
 		app().showFrameTimeStats,
 		[this](BoolMenuItem &item) { app().showFrameTimeStats = item.flipBoolValue(*this); }
 	},
+	recordFrameTimes
+	{
+		"Record Frame Times", attach,
+		doIfUsed(app().frameTimeRecorder, [](auto &recorder) { return recorder.isActive(); }, false),
+		[this](BoolMenuItem &item)
+		{
+			doIfUsed(app().frameTimeRecorder, [&](auto &recorder)
+			{
+				if(item.flipBoolValue(*this))
+					recorder.start();
+				else
+					recorder.stop();
+			});
+		}
+	},
+	exportFrameTimes
+	{
+		"Export Recorded Frame Times", attach,
+		[this]{ app().exportFrameTimeRecord(); }
+	},
 	frameClockItems
 	{
 		{"Auto",                                  attach, MenuItem::Config{.id = FrameTimeSource::Unset}},
@@ -421,6 +441,11 @@ void FrameTimingView::loadStockItems()
 	}
 	if(used(frameTimeStats))
 		item.emplace_back(&frameTimeStats);
+	if(used(recordFrameTimes))
+	{
+		item.emplace_back(&recordFrameTimes);
+		item.emplace_back(&exportFrameTimes);
+	}
 	item.emplace_back(&advancedHeading);
 	item.emplace_back(&frameClock);
 	if(used(presentMode))
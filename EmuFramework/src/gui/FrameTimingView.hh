@@ -44,6 +44,8 @@ protected:
 	MultiChoiceMenuItem frameRate;
 	MultiChoiceMenuItem frameRatePAL;
 	ConditionalMember<enableFrameTimeStats, BoolMenuItem> frameTimeStats;
+	ConditionalMember<enableFrameTimeStats, BoolMenuItem> recordFrameTimes;
+	ConditionalMember<enableFrameTimeStats, TextMenuItem> exportFrameTimes;
 	TextMenuItem frameClockItems[4];
 	MultiChoiceMenuItem frameClock;
 	ConditionalMember<Gfx::supportsPresentModes, TextMenuItem> presentModeItems[3];
@@ -54,7 +56,7 @@ protected:
 	ConditionalMember<Gfx::supportsPresentationTime, MultiChoiceMenuItem> presentationTime;
 	BoolMenuItem blankFrameInsertion;
 	TextHeadingMenuItem advancedHeading;
-	StaticArrayList<MenuItem*, 10> item;
+	StaticArrayList<MenuItem*, 12> item;
 
 	bool onFrameTimeChange(VideoSystem vidSys, SteadyClockTime time);
 };
@@ -76,6 +76,17 @@ StateSlotView::StateSlotView(ViewAttachParams attach):
 {
 	assert(system().hasContent());
 	refreshSlots();
+	// the file only exists once the background write finishes
+	app().stateWriter.onWrite = [this]
+	{
+		refreshSlots();
+		place();
+	};
+}
+
+StateSlotView::~StateSlotView()
+{
+	app().stateWriter.onWrite = {};
 }
 
 void StateSlotView::onShow()
@@ -125,10 +136,8 @@ void StateSlotView::refreshSlots()
 void StateSlotView::doSaveState()
 {
 	auto slot = system().stateSlot();
-	if(app().saveStateWithSlot(slot))
+	if(app().saveStateWithSlot(slot, app().stateWriter.archiveCompression))
 		app().showEmulation();
-	refreshSlot(slot);
-	place();
 }
 
 }
@@ -99,6 +99,38 @@ SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 			app().confirmOverwriteState = item.flipBoolValue(*this);
 		}
 	},
+	stateCompressionItem
+	{
+		{"Off",               attach, {.id = StateCompression::None}},
+		{"Fast (LZ4)",        attach, {.id = StateCompression::Fast}},
+		{"Default (Gzip)",    attach, {.id = StateCompression::Default}},
+		{"Max (Gzip Level 9)", attach, {.id = StateCompression::Max}},
+	},
+	stateCompression
+	{
+		"Quick/Autosave Compression", attach,
+		MenuId{app().stateWriter.compression},
+		stateCompressionItem,
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item) { app().stateWriter.compression = StateCompression(item.id.val); }
+		},
+	},
+	archiveStateCompressionItem
+	{
+		{"Off",               attach, {.id = StateCompression::None}},
+		{"Fast (LZ4)",        attach, {.id = StateCompression::Fast}},
+		{"Default (Gzip)",    attach, {.id = StateCompression::Default}},
+		{"Max (Gzip Level 9)", attach, {.id = StateCompression::Max}},
+	},
+	archiveStateCompression
+	{
+		"Save Menu Compression", attach,
+		MenuId{app().stateWriter.archiveCompression},
+		archiveStateCompressionItem,
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item) { app().stateWriter.archiveCompression = StateCompression(item.id.val); }
+		},
+	},
 	fastModeSpeedItem
 	{
 		{"1.5x",  attach, {.id = 150}},
@@ -226,6 +258,92 @@ SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 				});
 		}
 	},
+	rewindFrameIntervalItem
+	{
+		{"Off", attach, {.id = 0}},
+		{"1",   attach, {.id = 1}},
+		{"5",   attach, {.id = 5}},
+		{"15",  attach, {.id = 15}},
+		{"Custom Value", attach, [this](const Input::Event &e)
+			{
+				pushAndShowNewCollectValueRangeInputView<int, 0, 255>(attachParams(), e,
+					"Input 0 to 255", std::to_string(app().rewindManager.frameInterval()),
+					[this](CollectTextInputView &, auto val)
+					{
+						app().rewindManager.setFrameInterval(app(), val);
+						rewindFrameInterval.setSelected(val, *this);
+						dismissPrevious();
+						return true;
+					});
+				return false;
+			}, {.id = defaultMenuId}
+		},
+	},
+	rewindFrameInterval
+	{
+		"Rewind State Interval (Frames)", attach,
+		MenuId{app().rewindManager.frameInterval()},
+		rewindFrameIntervalItem,
+		{
+			.onSetDisplayString = [this](auto idx, Gfx::Text &t)
+			{
+				if(!idx)
+					return false;
+				t.resetString(std::format("{}", app().rewindManager.frameInterval()));
+				return true;
+			},
+			.defaultItemOnSelect = [this](TextMenuItem &item) { app().rewindManager.setFrameInterval(app(), item.id); }
+		},
+	},
+	rewindModeItem
+	{
+		{"Full States",      attach, {.id = RewindMode::Full}},
+		{"Delta Compressed", attach, {.id = RewindMode::Delta}},
+	},
+	rewindMode
+	{
+		"Rewind Mode", attach,
+		MenuId{app().rewindManager.mode},
+		rewindModeItem,
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item) { app().rewindManager.updateMode(RewindMode(item.id.val)); }
+		},
+	},
+	rewindMemoryItem
+	{
+		{"32MB",  attach, {.id = 32}},
+		{"64MB",  attach, {.id = 64}},
+		{"128MB", attach, {.id = 128}},
+		{"256MB", attach, {.id = 256}},
+		{"Custom Value", attach, [this](const Input::Event &e)
+			{
+				pushAndShowNewCollectValueRangeInputView<int, 0, maxRewindMemoryMB>(attachParams(), e,
+					"Input 0 to 4096", std::to_string(app().rewindManager.memoryMB),
+					[this](CollectTextInputView &, auto val)
+					{
+						app().rewindManager.updateMemoryMB(val);
+						rewindMemory.setSelected(val, *this);
+						dismissPrevious();
+						return true;
+					});
+				return false;
+			}, {.id = defaultMenuId}
+		},
+	},
+	rewindMemory
+	{
+		"Rewind Memory (Delta Mode)", attach,
+		MenuId{app().rewindManager.memoryMB},
+		rewindMemoryItem,
+		{
+			.onSetDisplayString = [this](auto idx, Gfx::Text &t)
+			{
+				t.resetString(std::format("{}MB", app().rewindManager.memoryMB));
+				return true;
+			},
+			.defaultItemOnSelect = [this](TextMenuItem &item) { app().rewindManager.updateMemoryMB(item.id); }
+		},
+	},
 	performanceMode
 	{
 		"Performance Mode", attach,
@@ -266,10 +384,15 @@ void SystemOptionView::loadStockItems()
 	item.emplace_back(&autosaveTimer);
 	item.emplace_back(&autosaveContent);
 	item.emplace_back(&confirmOverwriteState);
+	item.emplace_back(&stateCompression);
+	item.emplace_back(&archiveStateCompression);
 	item.emplace_back(&fastModeSpeed);
 	item.emplace_back(&slowModeSpeed);
 	item.emplace_back(&rewindStates);
 	item.emplace_back(&rewindTimeInterval);
+	item.emplace_back(&rewindFrameInterval);
+	item.emplace_back(&rewindMode);
+	item.emplace_back(&rewindMemory);
 	if(used(performanceMode) && appContext().hasSustainedPerformanceMode())
 		item.emplace_back(&performanceMode);
 	if(used(noopThread))
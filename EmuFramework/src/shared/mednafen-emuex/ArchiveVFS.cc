@@ -28,17 +28,21 @@ constexpr IG::SystemLogger log{"ArchiveVFS"};
 
 ArchiveVFS::ArchiveVFS(IG::ArchiveIO arch):
 	VirtualFS('/', "/"),
-	arch{std::move(arch)} {}
+	index{std::move(arch)} {}
 
 Stream* ArchiveVFS::open(const std::string &path, const uint32 mode, const int do_lock, const bool throw_on_noent, const CanaryType canary)
 {
 	assert(mode == MODE_READ);
 	assert(do_lock == 0);
-	seekFile(path);
-	auto stream = std::make_unique<MemoryStream>(arch.size(), true);
-	if(arch.read(stream->map(), arch.size()) != ssize_t(arch.size()))
+	auto &entry = findFile(path);
+	auto stream = std::make_unique<MemoryStream>(entry.size, true);
+	try
 	{
-		throw MDFN_Error(0, "Error reading archive file:\n%s", arch.name().data());
+		index.read(entry, {stream->map(), entry.size});
+	}
+	catch(...)
+	{
+		throw MDFN_Error(0, "Error reading archive file:\n%s", entry.name.c_str());
 	}
 	return stream.release();
 }
@@ -46,24 +50,22 @@ Stream* ArchiveVFS::open(const std::string &path, const uint32 mode, const int d
 FILE* ArchiveVFS::openAsStdio(const std::string& path, const uint32 mode)
 {
 	assert(mode == MODE_READ);
-	seekFile(path);
-	return IG::MapIO{arch}.toFileStream("rb");
+	return IG::MapIO{index.read(findFile(path))}.toFileStream("rb");
 }
 
-void ArchiveVFS::seekFile(const std::string& path)
+const IG::FS::ArchiveIndex::Entry &ArchiveVFS::findFile(const std::string& path) const
 {
-	arch.rewind();
 	auto filename = IG::FS::basename(path);
 	log.info("looking for file:{}", filename);
-	if(!IG::FS::seekFileInArchive(arch, [&](auto &entry)
-		{
-			auto name = IG::FS::basename(entry.name());
-			//log.debug("checking:{}", name);
-			return name == filename;
-		}))
+	auto entry = index.findFile([&](auto &entry)
+	{
+		return IG::FS::basename(entry.name) == filename;
+	});
+	if(!entry)
 	{
 		throw MDFN_Error(ENOENT, "Not found");
 	}
+	return *entry;
 }
 
 int ArchiveVFS::mkdir(const std::string& path, const bool throw_on_exist, const bool throw_on_noent) { return -1; }
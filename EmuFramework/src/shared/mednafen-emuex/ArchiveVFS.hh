@@ -16,7 +16,7 @@
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
 #include <mednafen/VirtualFS.h>
-#include <imagine/io/ArchiveIO.hh>
+#include <imagine/fs/ArchiveFS.hh>
 
 namespace Mednafen
 {
@@ -37,9 +37,9 @@ public:
 	std::string get_human_path(const std::string& path) final;
 
 private:
-	IG::ArchiveIO arch;
+	IG::FS::ArchiveIndex index;
 
-	void seekFile(const std::string& path);
+	const IG::FS::ArchiveIndex::Entry &findFile(const std::string& path) const;
 };
 
 }
@@ -0,0 +1,87 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	EmuFramework is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	EmuFramework is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <mednafen/types.h>
+#include <mednafen/Stream.h>
+#include <mednafen/error.h>
+#include <algorithm>
+#include <vector>
+#include <cerrno>
+
+namespace Mednafen
+{
+
+// Data written over an already written range, like the section sizes MDFNSS_SaveSM() fills in after the fact
+struct StreamPatch
+{
+	uint64 pos;
+	std::vector<uint8> data;
+};
+
+// Write-only stream that discards its data and only tracks the position & size,
+// follows the same seek semantics as MemoryStream so the final size matches exactly
+class CountingStream final : public Stream
+{
+public:
+	CountingStream(std::vector<StreamPatch> *patches = {}):
+		patches{patches} {}
+
+	uint64 attributes() final { return ATTRIBUTE_WRITEABLE | ATTRIBUTE_SEEKABLE; }
+
+	uint64 read(void *, uint64, bool) final
+	{
+		throw MDFN_Error(ErrnoHolder(EBADF));
+	}
+
+	void write(const void *data, uint64 count) final
+	{
+		if(!count)
+			return;
+		if(patches && position < streamSize)
+		{
+			auto bytes = static_cast<const uint8*>(data);
+			patches->emplace_back(position, std::vector<uint8>{bytes, bytes + count});
+		}
+		position += count;
+		streamSize = std::max(streamSize, position);
+	}
+
+	void truncate(uint64 length) final { streamSize = length; }
+
+	void seek(int64 offset, int whence) final
+	{
+		switch(whence)
+		{
+			case SEEK_SET: position = offset; return;
+			case SEEK_CUR: position += offset; return;
+			case SEEK_END: position = streamSize + offset; return;
+		}
+		throw MDFN_Error(ErrnoHolder(EINVAL));
+	}
+
+	uint64 tell() final { return position; }
+	uint64 size() final { return streamSize; }
+	void flush() final {}
+	void close() final {}
+
+private:
+	std::vector<StreamPatch> *patches{};
+	uint64 position{};
+	uint64 streamSize{};
+};
+
+}
@@ -0,0 +1,166 @@
+/*  This file is part of EmuFramework.
+
+	EmuFramework is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	EmuFramework is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <mednafen/types.h>
+#include <mednafen/mednafen.h>
+#include <mednafen-emuex/GzipStream.hh>
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace Mednafen
+{
+
+constexpr size_t scratchBuffSize = 4096;
+
+static uint64 seekPosition(uint64 position, uint64 size, int64 offset, int whence)
+{
+	switch(whence)
+	{
+		case SEEK_SET: return offset;
+		case SEEK_CUR: return position + offset;
+		case SEEK_END: return size + offset;
+	}
+	throw MDFN_Error(ErrnoHolder(EINVAL));
+}
+
+GzipWriteStream::GzipWriteStream(std::span<uint8> dest, int level, std::vector<StreamPatch> patches_):
+	patches{std::move(patches_)}
+{
+	std::ranges::stable_sort(patches, {}, &StreamPatch::pos);
+	zs.next_out = dest.data();
+	zs.avail_out = dest.size();
+	if(deflateInit2(&zs, level, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		throw MDFN_Error(0, _("Error initializing state compression"));
+}
+
+GzipWriteStream::~GzipWriteStream()
+{
+	deflateEnd(&zs);
+}
+
+uint64 GzipWriteStream::attributes() { return ATTRIBUTE_WRITEABLE | ATTRIBUTE_SEEKABLE; }
+
+uint64 GzipWriteStream::read(void *, uint64, bool)
+{
+	throw MDFN_Error(ErrnoHolder(EBADF));
+}
+
+void GzipWriteStream::write(const void *data_, uint64 count)
+{
+	if(!count)
+		return;
+	auto data = static_cast<const uint8*>(data_);
+	if(position < writtenSize)
+	{
+		// already compressed, so the data must be what was merged in from the patch list
+		if(position + count > writtenSize || !matchesPatch(data, count))
+			throw MDFN_Error(0, _("Unexpected overwrite of compressed state data"));
+		position += count;
+		return;
+	}
+	if(position > writtenSize)
+	{
+		// fill the gap left by seeking past the end with zeros like MemoryStream
+		static constexpr std::array<uint8, scratchBuffSize> zeros{};
+		auto gapEnd = position;
+		position = writtenSize;
+		while(position < gapEnd)
+			writeForward(zeros.data(), std::min<uint64>(gapEnd - position, zeros.size()));
+	}
+	writeForward(data, count);
+}
+
+void GzipWriteStream::writeForward(const uint8 *data, uint64 count)
+{
+	while(count)
+	{
+		if(nextPatch == patches.size() || patches[nextPatch].pos >= position + count)
+		{
+			deflateData(data, count);
+			return;
+		}
+		auto &patch = patches[nextPatch];
+		if(patch.pos > position)
+		{
+			auto size = patch.pos - position;
+			deflateData(data, size);
+			data += size;
+			count -= size;
+			continue;
+		}
+		auto offset = position - patch.pos;
+		auto size = std::min<uint64>(count, patch.data.size() - offset);
+		deflateData(patch.data.data() + offset, size);
+		data += size;
+		count -= size;
+		if(offset + size == patch.data.size())
+			nextPatch++;
+	}
+}
+
+void GzipWriteStream::deflateData(const uint8 *data, uint64 count)
+{
+	zs.next_in = const_cast<Bytef*>(data);
+	zs.avail_in = count;
+	while(zs.avail_in)
+	{
+		if(!zs.avail_out)
+			throw MDFN_Error(0, _("Compressed state doesn't fit in buffer"));
+		if(deflate(&zs, Z_NO_FLUSH) != Z_OK)
+			throw MDFN_Error(0, _("Error compressing state"));
+	}
+	position += count;
+	writtenSize = position;
+}
+
+bool GzipWriteStream::matchesPatch(const uint8 *data, uint64 count) const
+{
+	return std::ranges::any_of(patches, [&](const StreamPatch &p)
+	{
+		return p.pos == position && p.data.size() == count && !std::memcmp(p.data.data(), data, count);
+	});
+}
+
+void GzipWriteStream::truncate(uint64)
+{
+	throw MDFN_Error(ErrnoHolder(EINVAL));
+}
+
+void GzipWriteStream::seek(int64 offset, int whence)
+{
+	position = seekPosition(position, writtenSize, offset, whence);
+}
+
+uint64 GzipWriteStream::tell() { return position; }
+
+uint64 GzipWriteStream::size() { return writtenSize; }
+
+void GzipWriteStream::flush() {}
+
+void GzipWriteStream::close() {}
+
+size_t GzipWriteStream::finish()
+{
+	if(nextPatch != patches.size())
+		throw MDFN_Error(0, _("State layout changed while compressing"));
+	zs.next_in = nullptr;
+	zs.avail_in = 0;
+	if(deflate(&zs, Z_FINISH) != Z_STREAM_END)
+		throw MDFN_Error(0, _("Compressed state doesn't fit in buffer"));
+	return zs.total_out;
+}
+
+}
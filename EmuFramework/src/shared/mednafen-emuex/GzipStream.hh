@@ -0,0 +1,61 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	EmuFramework is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	EmuFramework is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <mednafen/types.h>
+#include <mednafen/Stream.h>
+#include <mednafen-emuex/CountingStream.hh>
+#include <zlib.h>
+#include <span>
+#include <vector>
+
+namespace Mednafen
+{
+
+// Deflates data into a fixed buffer in gzip format as it's written. Since compressed data
+// can't be rewritten, any overwrites must be known in advance from a CountingStream pass
+// and are merged in when their range is first written.
+class GzipWriteStream final : public Stream
+{
+public:
+	GzipWriteStream(std::span<uint8> dest, int level, std::vector<StreamPatch> patches = {});
+	~GzipWriteStream() final;
+	GzipWriteStream &operator=(GzipWriteStream &&) = delete;
+
+	uint64 attributes() final;
+	uint64 read(void *data, uint64 count, bool error_on_eos = true) final;
+	void write(const void *data, uint64 count) final;
+	void truncate(uint64 length) final;
+	void seek(int64 offset, int whence) final;
+	uint64 tell() final;
+	uint64 size() final;
+	void flush() final;
+	void close() final;
+	size_t finish(); // returns the compressed size
+
+private:
+	z_stream zs{};
+	std::vector<StreamPatch> patches;
+	size_t nextPatch{};
+	uint64 position{};
+	uint64 writtenSize{};
+
+	void writeForward(const uint8 *data, uint64 count);
+	void deflateData(const uint8 *data, uint64 count);
+	bool matchesPatch(const uint8 *data, uint64 count) const;
+};
+
+}
@@ -15,6 +15,7 @@
 
 #include <imagine/io/FileIO.hh>
 #include <imagine/fs/ArchiveFS.hh>
+#include <emuframework/ArchiveCache.hh>
 #include <imagine/util/string.h>
 #include <imagine/util/bit.hh>
 #include <imagine/base/ApplicationContext.hh>
@@ -53,24 +54,19 @@ MDFNFILE::MDFNFILE(VirtualFS* vfs, const std::string& path, const std::vector<Fi
 	{
 		try
 		{
-			for(auto &entry : IG::FS::ArchiveIterator{EmuEx::gAppContext().openFileUri(path)})
+			auto entry = EmuEx::ArchiveCache{EmuEx::gAppContext()}.openEntry(path,
+				[&](std::string_view name){ return hasKnownExtension(name, known_ext); });
+			if(!entry)
 			{
-				if(entry.type() == IG::FS::file_type::directory)
-				{
-					continue;
-				}
-				if(hasKnownExtension(entry.name(), known_ext))
-				{
-					log.info("archive file entry:{}", entry.name());
-					str = std::make_unique<MemoryStream>(entry.size(), true);
-					if(entry.read(str->map(), str->map_size()) != (int)str->map_size())
-					{
-						throw MDFN_Error(0, "Error reading archive");
-					}
-					return; // success
-				}
+				throw MDFN_Error(0, "No recognized file extensions in archive");
 			}
-			throw MDFN_Error(0, "No recognized file extensions in archive");
+			log.info("archive file entry:{}", entry.name);
+			str = std::make_unique<MemoryStream>(entry.io.size(), true);
+			if(entry.io.read(str->map(), str->map_size()) != (int)str->map_size())
+			{
+				throw MDFN_Error(0, "Error reading archive");
+			}
+			return; // success
 		}
 		catch(...)
 		{
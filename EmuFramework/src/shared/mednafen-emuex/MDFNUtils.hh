@@ -21,6 +21,7 @@
 #include <imagine/util/string.h>
 #include <imagine/util/zlib.hh>
 #include <emuframework/EmuApp.hh>
+#include <emuframework/StateCodec.hh>
 #include <mednafen/types.h>
 #include <mednafen/video/surface.h>
 #include <mednafen/hash/md5.h>
@@ -28,6 +29,8 @@
 #include <mednafen/FileStream.h>
 #include <mednafen/MemoryStream.h>
 #include <mednafen/cdrom/CDInterface.h>
+#include <mednafen-emuex/CountingStream.hh>
+#include <mednafen-emuex/GzipStream.hh>
 #include <main/MainSystem.hh>
 #include <string_view>
 
@@ -64,6 +67,12 @@ inline Mednafen::MDFN_Surface toMDFNSurface(IG::MutablePixmapView pix)
 	return {pix.data(), uint32(pix.w()), uint32(pix.h()), uint32(pix.pitchPx()), fmt};
 }
 
+inline IG::PixmapView toPixmapView(const Mednafen::MDFN_Surface &surface, IG::PixelFormat format)
+{
+	const void *pixels = surface.format.opp == 2 ? (const void*)surface.pixels16 : (const void*)surface.pixels;
+	return {{{surface.w, surface.h}, format}, pixels, {surface.pitchinpix, IG::PixmapUnits::PIXEL}};
+}
+
 inline FS::FileString stateFilenameMDFN(const Mednafen::MDFNGI &gameInfo, int slot, std::string_view name, char autoChar, bool skipMD5)
 {
 	auto saveSlotChar = [&] -> char
@@ -165,32 +174,71 @@ inline void runFrame(EmuSystem &sys, Mednafen::MDFNGI &mdfnGameInfo, EmuSystemTa
 	}
 }
 
+// Renders into the locked video texture if possible, otherwise into bufferPix. The core's
+// MDFND_commitVideoFrame() must submit the pixmap of espec->surface for the copy to be skipped.
+inline void runFrameDirect(EmuSystem &sys, Mednafen::MDFNGI &mdfnGameInfo, EmuSystemTaskContext taskCtx,
+	EmuVideo *videoPtr, MutablePixmapView bufferPix, EmuAudio *audioPtr, size_t maxAudioFrames)
+{
+	auto directPix = videoPtr ? videoPtr->startDirectFrame(taskCtx, bufferPix.desc()) : MutablePixmapView{};
+	runFrame(sys, mdfnGameInfo, taskCtx, videoPtr, directPix ? directPix : bufferPix, audioPtr, maxAudioFrames);
+	if(directPix)
+		videoPtr->endDirectFrame();
+}
+
 // Save states
 
+// Runs the serialization pass without storing any data, the result should be cached
+// by the caller and only recomputed when the core's state layout changes
 inline size_t stateSizeMDFN()
 {
 	using namespace Mednafen;
-	MemoryStream s;
+	CountingStream s;
 	MDFNSS_SaveSM(&s);
 	return s.size();
 }
 
+inline void readGzipStateMDFN(std::span<const uint8_t> buff, size_t size)
+{
+	using namespace Mednafen;
+	// MDFNSS_LoadSM() seeks back to each section after scanning their headers,
+	// so inflate once up front
+	auto uncompArr = dynArrayForOverwrite<uint8_t>(size);
+	if(uncompressGzip(uncompArr, buff) != size)
+		throw std::runtime_error("Error uncompressing state");
+	FileStream s{uncompArr};
+	MDFNSS_LoadSM(&s);
+}
+
 inline void readStateMDFN(EmuApp &app, std::span<uint8_t> buff)
 {
 	using namespace Mednafen;
-	if(hasGzipHeader(buff))
+	if(hasStateHeader(buff))
 	{
-		MemoryStream s{gzipUncompressedSize(buff), -1};
-		auto outputSize = uncompressGzip({s.map(), size_t(s.size())}, buff);
-		if(!outputSize)
-			throw std::runtime_error("Error uncompressing state");
-		if(outputSize <= 32)
-			throw std::runtime_error("Invalid state size");
-		auto sizeFromHeader = MDFN_de32lsb(s.map() + 16 + 4) & 0x7FFFFFFF;
-		if(sizeFromHeader != outputSize)
-			throw std::runtime_error(std::format("Bad state header size, got {} but expected {}", sizeFromHeader, outputSize));
-		s.setSize(outputSize);
-		MDFNSS_LoadSM(&s);
+		auto maxSize = maxStateSize(app.system().stateSize());
+		auto [codec, size] = readStateHeader(buff, maxSize);
+		auto payload = buff.subspan(stateHeaderSize);
+		if(codec == StateCodec::Gzip)
+		{
+			readGzipStateMDFN(payload, size);
+		}
+		else if(codec == StateCodec::None && payload.size() == size)
+		{
+			FileStream s{payload};
+			MDFNSS_LoadSM(&s);
+		}
+		else
+		{
+			auto uncompArr = uncompressState(buff, maxSize);
+			FileStream s{uncompArr};
+			MDFNSS_LoadSM(&s);
+		}
+	}
+	else if(hasGzipHeader(buff))
+	{
+		auto size = gzipUncompressedSize(buff);
+		if(auto maxSize = maxStateSize(app.system().stateSize()); size > maxSize)
+			throw std::runtime_error(std::format("State size {} exceeds limit of {}", size, maxSize));
+		readGzipStateMDFN(buff, size);
 	}
 	else
 	{
@@ -210,9 +258,17 @@ inline size_t writeStateMDFN(std::span<uint8_t> buff, SaveStateFlags flags)
 	}
 	else
 	{
-		MemoryStream s;
+		// Compressed data can't be rewritten, so first record the section sizes MDFNSS_SaveSM()
+		// fills in after writing each section, then merge them in while compressing the real pass
+		std::vector<StreamPatch> patches;
+		{
+			CountingStream s{&patches};
+			MDFNSS_SaveSM(&s);
+		}
+		int level = flags.compressionLevel ?: MDFN_GetSettingI("filesys.state_comp_level");
+		GzipWriteStream s{buff, level, std::move(patches)};
 		MDFNSS_SaveSM(&s);
-		return compressGzip(buff, {s.map(), size_t(s.size())}, MDFN_GetSettingI("filesys.state_comp_level"));
+		return s.finish();
 	}
 }
 
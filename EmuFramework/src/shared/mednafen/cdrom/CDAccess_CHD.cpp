@@ -23,6 +23,7 @@
 #include <mednafen/general.h>
 
 #include <stdio.h>
+#include <algorithm>
 
 #include "CDAccess_CHD.h"
 
@@ -57,6 +58,12 @@ static const int32_t DI_Size_Table[8] =
         2352  // CD-I RAW
 };
 
+// Decompressed hunks kept in memory, a CD hunk is typically 8 sectors
+static constexpr unsigned CHD_CACHE_HUNKS = 64;
+// Hunks decompressed ahead of the current read position
+static constexpr int32_t CHD_READ_AHEAD_HUNKS = 4;
+static constexpr uint32_t CHD_STATS_LOG_INTERVAL = 4096;
+
 CDAccess_CHD::CDAccess_CHD(VirtualFS* vfs, const std::string &path, bool image_memcache) : NumTracks(0), total_sectors(0)
 {
   Load(vfs, path, image_memcache);
@@ -83,8 +90,12 @@ void CDAccess_CHD::Load(VirtualFS* vfs, const std::string &path, bool image_memc
 
   /* allocate storage for sector reads */
   const chd_header *head = chd_get_header(chd);
-  hunkmem = (uint8_t *)malloc(head->hunkbytes);
-  oldhunk = -1;
+  hunkbytes = head->hunkbytes;
+  totalhunks = head->totalhunks;
+  cached_hunks.resize(CHD_CACHE_HUNKS);
+  hunkmem.reset(new uint8_t[hunkbytes * CHD_CACHE_HUNKS]);
+  read_hunkmem.reset(new uint8_t[hunkbytes]);
+  read_ahead_hunkmem.reset(new uint8_t[hunkbytes]);
 
   MDFN_printf("chd_load '%s' hunkbytes=%d\n", path.c_str(), head->hunkbytes);
 
@@ -209,89 +220,160 @@ void CDAccess_CHD::Load(VirtualFS* vfs, const std::string &path, bool image_memc
       assert(Tracks[x].index[i] >= 0);
     }
   }
+
+  read_ahead_thread.start([this](const ReadAheadJob &job)
+  {
+    if (job.generation == read_ahead_generation.load(std::memory_order_relaxed))
+      ReadAheadHunk(job.hunknum);
+  });
 }
 
 CDAccess_CHD::~CDAccess_CHD()
 {
+  read_ahead_thread.stop();
+
+  LogCacheStats();
+
   if (chd != NULL)
     chd_close(chd);
-
-  if (hunkmem)
-    free(hunkmem);
 }
 
-bool CDAccess_CHD::Read_CHD_Hunk_RAW(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
+void CDAccess_CHD::LogCacheStats()
 {
-  const chd_header *head = chd_get_header(chd);
-  int cad = lba - track->LBA + track->fileOffset;
-  int sph = head->hunkbytes / (2352 + 96);
-  int hunknum = cad / sph; //(cad * head->unitbytes) / head->hunkbytes;
-  int hunkofs = cad % sph; //(cad * head->unitbytes) % head->hunkbytes;
-  int err = CHDERR_NONE;
+  uint32_t total = hits + read_ahead_hits + misses;
+  if (!total)
+    return;
+  MDFN_printf("chd hunk cache: %u hits (%u read ahead) %u misses, %.1f%% hit rate\n",
+    hits + read_ahead_hits, read_ahead_hits, misses, (hits + read_ahead_hits) * 100.0 / total);
+}
 
-  /* each hunk holds ~8 sectors, optimize when reading contiguous sectors */
-  if (hunknum != oldhunk)
+int CDAccess_CHD::FindCachedHunk(int32_t hunknum) const
+{
+  for (size_t i = 0; i < cached_hunks.size(); i++)
   {
-    err = chd_read(chd, hunknum, hunkmem);
-    if (err != CHDERR_NONE)
-    	MDFN_printf("chd_read_sector failed lba=%d error=%d\n", lba, err);
-    else
-      oldhunk = hunknum;
+    if (cached_hunks[i].hunknum == hunknum)
+      return i;
   }
+  return -1;
+}
 
-  memcpy(buf, hunkmem + hunkofs * (2352 + 96), 2352);
-
-  return err;
+uint8_t *CDAccess_CHD::InsertHunk(int32_t hunknum, const uint8_t *data, bool read_ahead)
+{
+  auto it = std::ranges::min_element(cached_hunks, {}, &CachedHunk::last_use);
+  auto dest = hunkmem.get() + (it - cached_hunks.begin()) * hunkbytes;
+  memcpy(dest, data, hunkbytes);
+  *it = {hunknum, ++use_counter, read_ahead};
+  return dest;
 }
 
-bool CDAccess_CHD::Read_CHD_Hunk_M1(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
+bool CDAccess_CHD::CopyCachedHunk(uint8_t *buf, uint32_t size, int32_t hunknum, int32_t hunkofs)
 {
-  const chd_header *head = chd_get_header(chd);
-  int cad = lba - track->LBA + track->fileOffset;
-  int sph = head->hunkbytes / (2352 + 96);
-  int hunknum = cad / sph; //(cad * head->unitbytes) / head->hunkbytes;
-  int hunkofs = cad % sph; //(cad * head->unitbytes) % head->hunkbytes;
-  int err = CHDERR_NONE;
+  int idx = FindCachedHunk(hunknum);
+  if (idx == -1)
+    return false;
+  auto &hunk = cached_hunks[idx];
+  if (hunk.read_ahead)
+  {
+    read_ahead_hits++;
+    hunk.read_ahead = false;
+  }
+  else
+    hits++;
+  hunk.last_use = ++use_counter;
+  memcpy(buf, hunkmem.get() + idx * hunkbytes + hunkofs * (2352 + 96), size);
+  return true;
+}
 
-  /* each hunk holds ~8 sectors, optimize when reading contiguous sectors */
-  if (hunknum != oldhunk)
+void CDAccess_CHD::ReadAhead(int32_t hunknum)
+{
+  if (hunknum == last_hunk)
+    return;
+  if (hunknum != last_hunk + 1)
   {
-    err = chd_read(chd, hunknum, hunkmem);
-    if (err != CHDERR_NONE)
-    	MDFN_printf("chd_read_sector failed lba=%d error=%d\n", lba, err);
-    else
-      oldhunk = hunknum;
+    // seeked, so any pending hunks aren't needed anymore
+    read_ahead_generation.fetch_add(1, std::memory_order_relaxed);
+    read_ahead_end = hunknum + 1;
   }
+  last_hunk = hunknum;
+  read_ahead_end = std::max(read_ahead_end, hunknum + 1);
+  QueueReadAhead(hunknum + 1 + CHD_READ_AHEAD_HUNKS);
+}
 
-  memcpy(buf + 16, hunkmem + hunkofs * (2352 + 96), 2048);
+void CDAccess_CHD::QueueReadAhead(int32_t end)
+{
+  end = std::min(end, totalhunks);
+  const uint32_t generation = read_ahead_generation.load(std::memory_order_relaxed);
+  for (; read_ahead_end < end; read_ahead_end++)
+    read_ahead_thread.push({read_ahead_end, generation});
+}
 
-  return err;
+void CDAccess_CHD::ReadAheadHunk(int32_t hunknum)
+{
+  std::lock_guard chd_lock{chd_mutex};
+  {
+    std::lock_guard lock{cache_mutex};
+    if (FindCachedHunk(hunknum) != -1)
+      return;
+  }
+  if (chd_read(chd, hunknum, read_ahead_hunkmem.get()) != CHDERR_NONE)
+    return;
+  std::lock_guard lock{cache_mutex};
+  InsertHunk(hunknum, read_ahead_hunkmem.get(), true);
 }
 
-bool CDAccess_CHD::Read_CHD_Hunk_M2(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
+bool CDAccess_CHD::Read_CHD_Hunk(uint8_t *buf, uint32_t size, int32_t lba, CHDFILE_TRACK_INFO* track)
 {
-  const chd_header *head = chd_get_header(chd);
   int cad = lba - track->LBA + track->fileOffset;
-  int sph = head->hunkbytes / (2352 + 96);
+  int sph = hunkbytes / (2352 + 96);
   int hunknum = cad / sph; //(cad * head->unitbytes) / head->hunkbytes;
   int hunkofs = cad % sph; //(cad * head->unitbytes) % head->hunkbytes;
   int err = CHDERR_NONE;
 
-  /* each hunk holds ~8 sectors, optimize when reading contiguous sectors */
-  if (hunknum != oldhunk)
+  ReadAhead(hunknum);
+
   {
-    err = chd_read(chd, hunknum, hunkmem);
-    if (err != CHDERR_NONE)
-    	MDFN_printf("chd_read_sector failed lba=%d error=%d\n", lba, err);
-    else
-      oldhunk = hunknum;
+    std::lock_guard lock{cache_mutex};
+    if ((hits + read_ahead_hits + misses) % CHD_STATS_LOG_INTERVAL == CHD_STATS_LOG_INTERVAL - 1)
+      LogCacheStats();
+    if (CopyCachedHunk(buf, size, hunknum, hunkofs))
+      return err;
   }
 
-  memcpy(buf + 16, hunkmem + hunkofs * (2352 + 96), 2336);
-
+  // not cached, unless the read-ahead thread was decompressing it
+  std::lock_guard chd_lock{chd_mutex};
+  {
+    std::lock_guard lock{cache_mutex};
+    if (CopyCachedHunk(buf, size, hunknum, hunkofs))
+      return err;
+  }
+  err = chd_read(chd, hunknum, read_hunkmem.get());
+  if (err != CHDERR_NONE)
+  {
+    MDFN_printf("chd_read_sector failed lba=%d error=%d\n", lba, err);
+    return err;
+  }
+  std::lock_guard lock{cache_mutex};
+  misses++;
+  auto data = InsertHunk(hunknum, read_hunkmem.get(), false);
+  memcpy(buf, data + hunkofs * (2352 + 96), size);
   return err;
 }
 
+bool CDAccess_CHD::Read_CHD_Hunk_RAW(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
+{
+  return Read_CHD_Hunk(buf, 2352, lba, track);
+}
+
+bool CDAccess_CHD::Read_CHD_Hunk_M1(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
+{
+  return Read_CHD_Hunk(buf + 16, 2048, lba, track);
+}
+
+bool CDAccess_CHD::Read_CHD_Hunk_M2(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track)
+{
+  return Read_CHD_Hunk(buf + 16, 2336, lba, track);
+}
+
 int CDAccess_CHD::Read_Raw_Sector(uint8 *buf, int32 lba)
 {
   uint8_t SimuQ[0xC];
@@ -535,6 +617,27 @@ bool CDAccess_CHD::Fast_Read_Raw_PW_TSRE(uint8* pwbuf, int32 lba) const noexcept
   return (true);
 }
 
+void CDAccess_CHD::HintReadSector(int32 lba, int32 count)
+{
+  for (int32_t track = FirstTrack; track < (FirstTrack + NumTracks); track++)
+  {
+    CHDFILE_TRACK_INFO *ct = &Tracks[track];
+    if (lba >= (ct->LBA - ct->pregap_dv) && lba < (ct->LBA + ct->sectors))
+    {
+      int cad = lba - ct->LBA + ct->fileOffset;
+      int hunknum = cad / (hunkbytes / (2352 + 96));
+      if (hunknum == last_hunk || hunknum == last_hunk + 1)
+        return; // already covered by the sequential read-ahead
+      // start decompressing from the hinted hunk, its next read then continues sequentially
+      read_ahead_generation.fetch_add(1, std::memory_order_relaxed);
+      last_hunk = hunknum - 1;
+      read_ahead_end = hunknum;
+      QueueReadAhead(hunknum + CHD_READ_AHEAD_HUNKS);
+      return;
+    }
+  }
+}
+
 void CDAccess_CHD::Read_TOC(TOC *toc)
 {
   *toc = this->toc;
@@ -24,6 +24,11 @@
 
 #include "CDAccess.h"
 #include <libchdr/chd.h>
+#include <imagine/thread/JobQueueThread.hh>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace Mednafen
 {
@@ -66,7 +71,7 @@ class CDAccess_CHD final : public CDAccess
 
  void Read_TOC(CDUtility::TOC *toc) final;
 
- void HintReadSector(int32 lba, int32 count) final {};
+ void HintReadSector(int32 lba, int32 count) final;
 
  int Read_Sector(uint8 *buf, int32 lba, uint32 size) final;
 
@@ -81,6 +86,17 @@ class CDAccess_CHD final : public CDAccess
   bool Read_CHD_Hunk_RAW(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track);
   bool Read_CHD_Hunk_M1(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track);
   bool Read_CHD_Hunk_M2(uint8_t *buf, int32_t lba, CHDFILE_TRACK_INFO* track);
+  bool Read_CHD_Hunk(uint8_t *buf, uint32_t size, int32_t lba, CHDFILE_TRACK_INFO* track);
+
+  // Hunk cache functions, cache_mutex must be held
+  int FindCachedHunk(int32_t hunknum) const;
+  uint8_t *InsertHunk(int32_t hunknum, const uint8_t *data, bool read_ahead);
+  bool CopyCachedHunk(uint8_t *buf, uint32_t size, int32_t hunknum, int32_t hunkofs);
+
+  void ReadAhead(int32_t hunknum);
+  void QueueReadAhead(int32_t end);
+  void ReadAheadHunk(int32_t hunknum);
+  void LogCacheStats();
 
   int32_t NumTracks;
   int32_t FirstTrack;
@@ -97,10 +113,35 @@ class CDAccess_CHD final : public CDAccess
   int num_tracks;
 
   chd_file *chd;
-  /* hunk data cache */
-  uint8_t *hunkmem;
-  /* last hunknum read */
-  int oldhunk;
+  uint32_t hunkbytes;
+  int32_t totalhunks;
+  /* LRU cache of decompressed hunks, hunkmem holds the data of each entry */
+  struct CachedHunk
+  {
+    int32_t hunknum = -1;
+    uint32_t last_use = 0;
+    bool read_ahead = false;
+  };
+  std::vector<CachedHunk> cached_hunks;
+  std::unique_ptr<uint8_t[]> hunkmem;
+  uint32_t use_counter = 0;
+  uint32_t hits = 0, read_ahead_hits = 0, misses = 0;
+  std::mutex cache_mutex;
+  /* serializes chd_read() between the reading & read-ahead threads */
+  std::mutex chd_mutex;
+  std::unique_ptr<uint8_t[]> read_hunkmem;
+  std::unique_ptr<uint8_t[]> read_ahead_hunkmem;
+  /* hunks following the last one read are decompressed on a worker thread,
+     jobs from before the last seek are skipped by comparing the generation */
+  struct ReadAheadJob
+  {
+    int32_t hunknum;
+    uint32_t generation;
+  };
+  IG::JobQueueThread<ReadAheadJob, 16> read_ahead_thread;
+  std::atomic_uint32_t read_ahead_generation{};
+  int32_t last_hunk = -1;
+  int32_t read_ahead_end = 0;
 };
 
 }
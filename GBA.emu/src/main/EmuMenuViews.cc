@@ -406,6 +406,18 @@ class CustomSystemOptionView : public SystemOptionView, public MainAppHelper<Cus
 		}
 	};
 
+	BoolMenuItem renderThread
+	{
+		"Render Video On Separate Thread", attachParams(),
+		(bool)system().optionRenderThread,
+		[this](BoolMenuItem &item)
+		{
+			system().optionRenderThread = item.flipBoolValue(*this);
+			if(system().hasContent())
+				CPUSetRenderThread(gGba, system().optionRenderThread);
+		}
+	};
+
 	#ifdef IG_CONFIG_SENSORS
 	TextMenuItem lightSensorScaleItem[5]
 	{
@@ -453,6 +465,7 @@ public:
 	{
 		loadStockItems();
 		item.emplace_back(&bios);
+		item.emplace_back(&renderThread);
 		#ifdef IG_CONFIG_SENSORS
 		item.emplace_back(&lightSensorScale);
 		#endif
@@ -257,6 +257,8 @@ struct GBALCD
 	uint32_t lineOBJWin[240];
 	bool gfxInWin0[240];
 	bool gfxInWin1[240];
+	int gfxWin0H{-1}; // WIN0H/WIN1H values gfxInWin0/1 were computed from
+	int gfxWin1H{-1};
 	int lineOBJpixleft[128];
 	alignas(8) uint16_t pix[240 * 160];
 	alignas(4) uint8_t vram[0x20000];
@@ -278,6 +280,16 @@ struct GBALCD
 	int lcdTicks{};
 	uint16_t gfxLastVCOUNT{};
 
+	// Set by register writes and copied to the matching fields above as each line is drawn,
+	// since lines may be drawn on a separate thread while emulation continues
+	struct LineState
+	{
+		unsigned layerEnable{};
+		int gfxBG2Changed{};
+		int gfxBG3Changed{};
+	};
+	LineState regState;
+
 	void registerRamReset(uint32_t flags)
 	{
     if(flags & 0x04) {
@@ -306,7 +318,7 @@ struct GBALCD
 	{
 		reset();
 		ioMem.resetLcdRegs(useBios, skipBios);
-		layerEnable = ioMem.DISPCNT & coreOptions.layerSettings;
+		regState.layerEnable = ioMem.DISPCNT & coreOptions.layerSettings;
 	}
 };
 
@@ -146,6 +146,7 @@ WallClockTimePoint GbaSystem::backupMemoryLastWriteTime(const EmuApp &app) const
 void GbaSystem::closeSystem()
 {
 	assert(hasContent());
+	CPUSetRenderThread(gGba, false);
 	CPUCleanUp();
 	saveFileIO = {};
 	coreOptions.saveType = GBA_SAVE_NONE;
@@ -207,6 +208,7 @@ void GbaSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegat
 	}
 	CPUInit(gGba, biosRom);
 	CPUReset(gGba);
+	CPUSetRenderThread(gGba, optionRenderThread);
 	saveStateSize = CPUWriteState(gGba, DynArray<uint8_t>{maxStateSize}.data());
 	readCheatFile(*this);
 }
@@ -243,6 +245,14 @@ void GbaSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio
 	CPULoop(gGba, taskCtx, video, audio);
 }
 
+void GbaSystem::addThreadGroupIds(std::vector<ThreadId> &ids) const
+{
+	if(auto id = CPURenderThreadId())
+		ids.emplace_back(id);
+}
+
+FrameTime GbaSystem::helperThreadFrameTime() const { return CPURenderThreadFrameTime(); }
+
 void GbaSystem::configAudioRate(FrameTime outputFrameTime, int outputRate)
 {
 	long mixRate = std::round(audioMixRate(outputRate, outputFrameTime));
@@ -42,7 +42,7 @@ enum
 	CFGKEY_SENSOR_TYPE = 262, CFGKEY_LIGHT_SENSOR_SCALE = 263,
 	CFGKEY_CHEATS_PATH = 264, CFGKEY_PATCHES_PATH = 265,
 	CFGKEY_USE_BIOS = 266, CFGKEY_DEFAULT_USE_BIOS = 267,
-	CFGKEY_BIOS_PATH = 268
+	CFGKEY_BIOS_PATH = 268, CFGKEY_RENDER_THREAD = 269
 };
 
 void readCheatFile(class EmuSystem &);
@@ -90,6 +90,7 @@ public:
 	bool saveMemoryIsMappedFile{};
 	Property<AutoTristate, CFGKEY_USE_BIOS> useBios;
 	Property<bool, CFGKEY_DEFAULT_USE_BIOS> defaultUseBios;
+	Property<bool, CFGKEY_RENDER_THREAD> optionRenderThread;
 	ConditionalMember<Config::SENSORS, GbaSensorType> sensorType{};
 	ConditionalMember<Config::SENSORS, GbaSensorType> detectedSensorType{};
 	static constexpr auto gbaFrameTime{fromSeconds<FrameTime>(280896. / 16777216.)}; // ~59.7275Hz
@@ -132,6 +133,8 @@ public:
 	void closeSystem();
 	bool onVideoRenderFormatChange(EmuVideo &, IG::PixelFormat);
 	void renderFramebuffer(EmuVideo &);
+	void addThreadGroupIds(std::vector<ThreadId> &) const;
+	FrameTime helperThreadFrameTime() const;
 
 private:
 	void applyGamePatches(uint8_t *rom, int &romSize);
@@ -62,6 +62,7 @@ bool GbaSystem::readConfig(ConfigType type, MapIO &io, unsigned key)
 			case CFGKEY_PATCHES_PATH: return readStringOptionValue(io, patchesDir);
 			case CFGKEY_BIOS_PATH: return readStringOptionValue(io, biosPath);
 			case CFGKEY_DEFAULT_USE_BIOS: return readOptionValue(io, defaultUseBios);
+			case CFGKEY_RENDER_THREAD: return readOptionValue(io, optionRenderThread);
 		}
 	}
 	else if(type == ConfigType::SESSION)
@@ -91,6 +92,7 @@ void GbaSystem::writeConfig(ConfigType type, FileIO &io)
 		writeStringOptionValue(io, CFGKEY_PATCHES_PATH, patchesDir);
 		writeStringOptionValue(io, CFGKEY_BIOS_PATH, biosPath);
 		writeOptionValueIfNotDefault(io, defaultUseBios);
+		writeOptionValueIfNotDefault(io, optionRenderThread);
 	}
 	else if(type == ConfigType::SESSION)
 	{
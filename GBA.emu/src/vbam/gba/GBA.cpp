@@ -34,6 +34,7 @@
 #include <imagine/util/algorithm.h>
 #include <imagine/util/ScopeGuard.hh>
 #include <emuframework/EmuSystemTaskContext.hh>
+#include <imagine/thread/JobQueueThread.hh>
 
 #ifdef PROFILING
 #include "prof/prof.h"
@@ -440,6 +441,91 @@ static const variable_desc saveGameStruct[] = {
 
 static int romSize = SIZE_ROM;
 
+// Lines are drawn at the start of H-Blank from a copy of the LCD registers, so with the render
+// thread enabled the CPU can continue while they're drawn. VRAM, palette, OAM, and the line
+// buffers aren't copied and CPUSyncRender() must be called before modifying them.
+struct LineRenderJob
+{
+  GBALCD::RenderLineFunc renderLine;
+  MixColorType *lineMix;
+  GBALCD::LineState regState;
+  alignas(4) uint8_t lcdRegs[0x56]; // DISPCNT to COLY
+};
+
+static IG::JobQueueThread<LineRenderJob, 256> renderThread;
+static IG::Nanoseconds renderThreadFrameTime;
+
+static void gfxUpdateWindow(bool (&gfxInWin)[240], int &gfxWinH, uint16_t winH)
+{
+  if (gfxWinH == winH)
+    return;
+  gfxWinH = winH;
+  int x00 = winH >> 8;
+  int x01 = winH & 255;
+
+  if (x00 <= x01) {
+    for (int i = 0; i < 240; i++) {
+      gfxInWin[i] = (i >= x00 && i < x01);
+    }
+  } else {
+    for (int i = 0; i < 240; i++) {
+      gfxInWin[i] = (i >= x00 || i < x01);
+    }
+  }
+}
+
+static void gfxRenderLine(GBALCD &lcd, GBALCD::RenderLineFunc renderLine, MixColorType *lineMix,
+  const GBALCD::LineState &regState, const GBAMem::IoMem &ioMem)
+{
+  lcd.layerEnable = regState.layerEnable;
+  lcd.gfxBG2Changed |= regState.gfxBG2Changed;
+  lcd.gfxBG3Changed |= regState.gfxBG3Changed;
+  gfxUpdateWindow(lcd.gfxInWin0, lcd.gfxWin0H, ioMem.WIN0H);
+  gfxUpdateWindow(lcd.gfxInWin1, lcd.gfxWin1H, ioMem.WIN1H);
+  renderLine(lineMix, lcd, ioMem);
+}
+
+static void CPURenderLine(GBASys &gba)
+{
+  auto &lcd = gba.lcd;
+  if (renderThread.isRunning()) {
+    LineRenderJob job{lcd.renderLine, lcd.lineMix, lcd.regState};
+    memcpy(job.lcdRegs, gba.mem.ioMem.b, sizeof(job.lcdRegs));
+    renderThread.push(job);
+  } else {
+    gfxRenderLine(lcd, lcd.renderLine, lcd.lineMix, lcd.regState, gba.mem.ioMem);
+  }
+  lcd.regState.gfxBG2Changed = 0;
+  lcd.regState.gfxBG3Changed = 0;
+}
+
+void CPUSetRenderThread(GBASys &gba, bool on)
+{
+  if (on == renderThread.isRunning())
+    return;
+  if (on) {
+    renderThread.start([&lcd = gba.lcd](const LineRenderJob &job)
+    {
+      static GBAMem::IoMem ioMem;
+      memcpy(ioMem.b, job.lcdRegs, sizeof(job.lcdRegs));
+      gfxRenderLine(lcd, job.renderLine, job.lineMix, job.regState, ioMem);
+    });
+  } else {
+    renderThread.stop();
+  }
+  renderThreadFrameTime = {};
+}
+
+void CPUSyncRender()
+{
+  if (renderThread.isRunning())
+    renderThread.sync();
+}
+
+IG::ThreadId CPURenderThreadId() { return renderThread.threadId(); }
+
+IG::Nanoseconds CPURenderThreadFrameTime() { return renderThreadFrameTime; }
+
 #define SWITicks cpu.SWITicks
 #define IRQTicks cpu.IRQTicks
 #define memoryWait cpu.memoryWait
@@ -531,12 +617,10 @@ static int romSize = SIZE_ROM;
 #define DISPSTAT gba.mem.ioMem.DISPSTAT
 #define VCOUNT gba.mem.ioMem.VCOUNT
 #define layerEnableDelay gba.lcd.layerEnableDelay
-#define layerEnable gba.lcd.layerEnable
+#define layerEnable gba.lcd.regState.layerEnable
 #define windowOn gba.lcd.windowOn
-#define gfxBG2Changed gba.lcd.gfxBG2Changed
-#define gfxBG3Changed gba.lcd.gfxBG3Changed
-#define gfxInWin0 gba.lcd.gfxInWin0
-#define gfxInWin1 gba.lcd.gfxInWin1
+#define gfxBG2Changed gba.lcd.regState.gfxBG2Changed
+#define gfxBG3Changed gba.lcd.regState.gfxBG3Changed
 #define fxOn gba.lcd.fxOn
 #define bios gba.mem.bios
 #define cpuDmaCount gba.dma.cpuDmaCount
@@ -624,41 +708,7 @@ inline int CPUUpdateTicks(ARM7TDMI &cpu)
   return cpuLoopTicks;
 }
 
-static void CPUUpdateWindow0(GBASys &gba)
-{
-  int x00 = WIN0H >> 8;
-  int x01 = WIN0H & 255;
-
-  if (x00 <= x01) {
-    for (int i = 0; i < 240; i++) {
-      gfxInWin0[i] = (i >= x00 && i < x01);
-    }
-  } else {
-    for (int i = 0; i < 240; i++) {
-    	gfxInWin0[i] = (i >= x00 || i < x01);
-    }
-  }
-}
-
-static void CPUUpdateWindow1(GBASys &gba)
-{
-  int x00 = WIN1H >> 8;
-  int x01 = WIN1H & 255;
-
-  if (x00 <= x01) {
-    for (int i = 0; i < 240; i++) {
-    	gfxInWin1[i] = (i >= x00 && i < x01);
-    }
-  } else {
-    for (int i = 0; i < 240; i++) {
-    	gfxInWin1[i] = (i >= x00 || i < x01);
-    }
-  }
-}
-
 #define CPUUpdateTicks() CPUUpdateTicks(cpu)
-#define CPUUpdateWindow0() CPUUpdateWindow0(gba)
-#define CPUUpdateWindow1() CPUUpdateWindow1(gba)
 #define line0 gba.lcd.line0
 #define line1 gba.lcd.line1
 #define line2 gba.lcd.line2
@@ -689,6 +739,7 @@ static void CPUUpdateWindow1(GBASys &gba)
 
 static void CPUUpdateRenderBuffers(GBASys &gba, bool force)
 {
+  CPUSyncRender();
   if (!(layerEnable & 0x0100) || force) {
     CLEAR_ARRAY(line0);
   }
@@ -745,6 +796,7 @@ unsigned int CPUWriteState(GBASys &gba, uint8_t* data)
 bool CPUReadState(GBASys &gba, const uint8_t* data)
 {
 	  auto &cpu = gba.cpu;
+    CPUSyncRender();
     // Don't really care about version.
     int version = utilReadIntMem(data);
     if (version != SAVE_GAME_VERSION)
@@ -806,9 +858,6 @@ bool CPUReadState(GBASys &gba, const uint8_t* data)
     CLEAR_ARRAY(line3);
     // End of CPU Update Render Buffers set to true
 
-    CPUUpdateWindow0();
-    CPUUpdateWindow1();
-
     SetSaveType(coreOptions.saveType);
 
     systemSaveUpdateCounter = SYSTEM_SAVE_NOT_UPDATED;
@@ -1044,8 +1093,6 @@ static bool CPUReadState(GBASys &gba, gzFile gzFile)
 
   CPUUpdateRender(gba);
   CPUUpdateRenderBuffers(true);
-  CPUUpdateWindow0();
-  CPUUpdateWindow1();
 
   SetSaveType(coreOptions.saveType);
 
@@ -2887,12 +2934,10 @@ void CPUUpdateRegister(ARM7TDMI &cpu, uint32_t address, uint16_t value)
   case 0x40:
   	WIN0H = value;
     UPDATE_REG(0x40, WIN0H);
-    CPUUpdateWindow0();
     break;
   case 0x42:
   	WIN1H = value;
     UPDATE_REG(0x42, WIN1H);
-    CPUUpdateWindow1();
     break;
   case 0x44:
   	WIN0V = value;
@@ -3469,6 +3514,7 @@ void SetSaveType(int st)
 void CPUReset(GBASys &gba)
 {
 	auto &cpu = gba.cpu;
+  CPUSyncRender();
   switch (CheckEReaderRegion()) {
   case 1: //US
       EReaderWriteMemory(0x8009134, 0x46C0DFE0);
@@ -3662,9 +3708,6 @@ void CPUReset(GBASys &gba)
 
   soundReset(gba);
 
-  CPUUpdateWindow0();
-  CPUUpdateWindow1();
-
   // make sure registers are correctly initialized if not using BIOS
   if (!coreOptions.useBios) {
     if (coreOptions.cpuIsMultiBoot)
@@ -4098,13 +4141,17 @@ void CPULoop(GBASys &gba, EmuEx::EmuSystemTaskContext taskCtx, EmuEx::EmuVideo *
             	else
             	{
             	}*/
-              (*gba.lcd.renderLine)(gba.lcd.lineMix, gba.lcd, ioMem);
+              CPURenderLine(gba);
             }
             if (VCOUNT == 159)
             {
             	cpuBreakLoop = true;
               if (video)
               {
+                if (renderThread.isRunning()) {
+                  renderThread.sync();
+                  renderThreadFrameTime = renderThread.takeBusyTime();
+                }
             	  systemDrawScreen(taskCtx, *video);
             	  video = nullptr;
               }
@@ -6,6 +6,8 @@
 #include "../System.h"
 #include "../Util.h"
 #include "../NLS.h"
+#include <imagine/thread/Thread.hh>
+#include <imagine/time/Time.hh>
 #include <imagine/util/mayAliasInt.h>
 #include <imagine/util/memory/Buffer.hh>
 #include <array>
@@ -179,6 +181,11 @@ void SetSaveType(int st);
 extern void CPUReset(GBASys &gba);
 extern void CPULoop(int);
 extern void CPUCheckDMA(GBASys &gba, ARM7TDMI &cpu, int,int);
+// Draw lines on a separate thread, CPUSyncRender() must be called before VRAM, palette, or OAM are modified
+extern void CPUSetRenderThread(GBASys &gba, bool);
+extern void CPUSyncRender();
+extern IG::ThreadId CPURenderThreadId();
+extern IG::Nanoseconds CPURenderThreadFrameTime();
 extern bool CPUIsGBAImage(const char*);
 extern bool CPUIsZipFile(const char*);
 #ifdef PROFILING
@@ -523,6 +523,7 @@ static inline void CPUWriteMemory(ARM7TDMI &cpu, uint32_t address, uint32_t valu
             goto unwritable;
         break;
     case 0x05:
+        CPUSyncRender();
 #ifdef BKPT_SUPPORT
         if (*((uint32_t*)&freezePRAM[address & 0x3fc]))
             cheatsWriteMemory(address & 0x70003FC, value);
@@ -531,6 +532,7 @@ static inline void CPUWriteMemory(ARM7TDMI &cpu, uint32_t address, uint32_t valu
             WRITE32LE(((uint32_t*)&paletteRAM[address & 0x3FC]), value);
         break;
     case 0x06:
+        CPUSyncRender();
         address = (address & 0x1fffc);
         if (((DISPCNT & 7) > 2) && ((address & 0x1C000) == 0x18000))
             return;
@@ -546,6 +548,7 @@ static inline void CPUWriteMemory(ARM7TDMI &cpu, uint32_t address, uint32_t valu
             WRITE32LE(((uint32_t*)&vram[address]), value);
         break;
     case 0x07:
+        CPUSyncRender();
 #ifdef BKPT_SUPPORT
         if (*((uint32_t*)&freezeOAM[address & 0x3fc]))
             cheatsWriteMemory(address & 0x70003FC, value);
@@ -626,6 +629,7 @@ static inline void CPUWriteHalfWord(ARM7TDMI &cpu, uint32_t address, uint16_t va
             goto unwritable;
         break;
     case 5:
+        CPUSyncRender();
 #ifdef BKPT_SUPPORT
         if (*((uint16_t*)&freezePRAM[address & 0x03fe]))
             cheatsWriteHalfWord(address & 0x70003fe, value);
@@ -634,6 +638,7 @@ static inline void CPUWriteHalfWord(ARM7TDMI &cpu, uint32_t address, uint16_t va
             WRITE16LE(((uint16_t*)&paletteRAM[address & 0x3fe]), value);
         break;
     case 6:
+        CPUSyncRender();
         address = (address & 0x1fffe);
         if (((DISPCNT & 7) > 2) && ((address & 0x1C000) == 0x18000))
             return;
@@ -647,6 +652,7 @@ static inline void CPUWriteHalfWord(ARM7TDMI &cpu, uint32_t address, uint16_t va
             WRITE16LE(((uint16_t*)&vram[address]), value);
         break;
     case 7:
+        CPUSyncRender();
 #ifdef BKPT_SUPPORT
         if (*((uint16_t*)&freezeOAM[address & 0x03fe]))
             cheatsWriteHalfWord(address & 0x70003fe, value);
@@ -785,10 +791,12 @@ static inline void CPUWriteByte(ARM7TDMI &cpu, uint32_t address, uint8_t b)
             goto unwritable;
         break;
     case 5:
+        CPUSyncRender();
         // no need to switch
         *((uint16_t*)&paletteRAM[address & 0x3FE]) = (b << 8) | b;
         break;
     case 6:
+        CPUSyncRender();
         address = (address & 0x1fffe);
         if (((DISPCNT & 7) > 2) && ((address & 0x1C000) == 0x18000))
             return;
@@ -411,8 +411,11 @@ void doFullTilesUnrolledDmg(PPUPriv &p, int const xend, uint_least32_t *const db
 			uint_least32_t *const dstend = dst + n;
 			xpos += n;
 
-			if (!lcdcBgEn(p)) {
-				do { *dst++ = p.bgPalette[0]; } while (dst != dstend);
+			if (!lcdcBgEn(p) || !p.framebuf.fb()) {
+				// with no frame buffer, only the last fetched tile needs decoding
+				if (p.framebuf.fb()) {
+					do { *dst++ = p.bgPalette[0]; } while (dst != dstend);
+				}
 				tileMapXpos += n / (1u * tile_len);
 
 				unsigned const tno = tileMapLine[(tileMapXpos - 1) % tile_map_len];
@@ -600,6 +603,12 @@ void doFullTilesUnrolledCgb(PPUPriv &p, int const xend, uint_least32_t *const db
 			uint_least32_t *const dstend = dst + n;
 			xpos += n;
 
+			if (!p.framebuf.fb()) {
+				// with no frame buffer, skip to fetching the last tile
+				tileMapXpos = (tileMapXpos + n / tile_len - 1) % tile_map_len;
+				dst = dstend - tile_len;
+			}
+
 			do {
 				unsigned long const *const bgPalette = p.bgPalette
 					+ (nattrib & attr_cgbpalno) * num_palette_entries;
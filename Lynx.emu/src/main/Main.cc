@@ -37,6 +37,7 @@ namespace EmuEx
 
 constexpr SystemLogger log{"Lynx.emu"};
 const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2011-2024\nRobert Broglia\nwww.explusalpha.com\n\nPortions (c) the\nMednafen Team\nmednafen.github.io";
+bool EmuSystem::handlesCompressedStates = true;
 bool EmuApp::needsGlobalInstance = true;
 
 EmuSystem::NameFilterFunc EmuSystem::defaultFsFilter =
@@ -64,7 +65,7 @@ FS::FileString LynxSystem::stateFilename(int slot, std::string_view name) const
 	return stateFilenameMDFN(*MDFNGameInfo, slot, name, 'a', noMD5InFilenames);
 }
 
-size_t LynxSystem::stateSize() { return stateSizeMDFN(); }
+size_t LynxSystem::stateSize() { return currStateSize; }
 void LynxSystem::readState(EmuApp &app, std::span<uint8_t> buff) { readStateMDFN(app, buff); }
 size_t LynxSystem::writeState(std::span<uint8_t> buff, SaveStateFlags flags) { return writeStateMDFN(buff, flags); }
 
@@ -79,6 +80,7 @@ void LynxSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelega
 	static constexpr size_t maxRomSize = 0x1000000;
 	EmuEx::loadContent(*this, mdfnGameInfo, io, maxRomSize);
 	Lynx_SetPixelFormat(toMDFNSurface(mSurfacePix).format);
+	currStateSize = stateSizeMDFN();
 }
 
 bool LynxSystem::onVideoRenderFormatChange(EmuVideo &, IG::PixelFormat fmt)
@@ -111,7 +113,7 @@ void LynxSystem::configAudioRate(FrameTime outputFrameTime, int outputRate)
 void LynxSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio)
 {
 	static constexpr size_t maxAudioFrames = 48000 / 20; // May output a large amount of audio samples during boot
-	EmuEx::runFrame(*this, mdfnGameInfo, taskCtx, video, mSurfacePix, audio, maxAudioFrames);
+	EmuEx::runFrameDirect(*this, mdfnGameInfo, taskCtx, video, mSurfacePix, audio, maxAudioFrames);
 	if(configuredHCount != Lynx_HCount()) [[unlikely]]
 	{
 		onFrameTimeChanged();
@@ -155,7 +157,8 @@ namespace Mednafen
 
 void MDFND_commitVideoFrame(EmulateSpecStruct *espec)
 {
-	espec->video->startFrameWithFormat(espec->taskCtx, static_cast<EmuEx::LynxSystem&>(*espec->sys).mSurfacePix);
+	auto &sys = static_cast<EmuEx::LynxSystem&>(*espec->sys);
+	espec->video->startFrameWithFormat(espec->taskCtx, EmuEx::toPixmapView(*espec->surface, sys.mSurfacePix.format()));
 }
 
 }
@@ -42,6 +42,7 @@ class LynxSystem final: public EmuSystem
 {
 public:
 	Mednafen::MDFNGI mdfnGameInfo{EmulatedLynx};
+	size_t currStateSize{};
 	uint16_t inputBuff{};
 	IG::MutablePixmapView mSurfacePix{};
 	static constexpr WSize vidBufferPx{160, 102};
@@ -358,7 +358,7 @@ template void system_frame_md<1>(EmuEx::EmuSystemTaskContext, EmuEx::EmuVideo *)
 template <bool hasSegaCD>
 static void system_frame_md(EmuEx::EmuSystemTaskContext taskCtx, EmuEx::EmuVideo *emuVideo)
 {
-	int do_skip = !emuVideo;
+	int do_skip = taskCtx.skipRender;
 
 	//logMsg("start frame");
   /* line counter */
@@ -528,7 +528,11 @@ static void system_frame_md(EmuEx::EmuSystemTaskContext taskCtx, EmuEx::EmuVideo
     /* render scanline */
     if (!do_skip)
     {
-      render_line(line, pixmap);
+      render_queue_line(line, pixmap);
+    }
+    else
+    {
+      render_queue_skip_line(line);
     }
 
     /* run 68k & Z80 */
@@ -560,6 +564,9 @@ static void system_frame_md(EmuEx::EmuSystemTaskContext taskCtx, EmuEx::EmuVideo
   }
   while (++line < bitmap.viewport.h);
 
+  /* wait for queued lines */
+  render_frame_sync();
+
   if(emuVideo)
   {
   	emuVideo->startFrameWithAltFormat(taskCtx, pixmap);
@@ -754,7 +761,7 @@ static void system_frame_md(EmuEx::EmuSystemTaskContext taskCtx, EmuEx::EmuVideo
 
 static void system_frame_sms(EmuEx::EmuSystemTaskContext taskCtx, EmuEx::EmuVideo *emuVideo)
 {
-	int do_skip = !emuVideo;
+	int do_skip = taskCtx.skipRender;
 
   /* line counter */
   int line = 0;
@@ -903,6 +910,10 @@ static void system_frame_sms(EmuEx::EmuSystemTaskContext taskCtx, EmuEx::EmuVide
       {
         render_line(line, pixmap);
       }
+      else
+      {
+        skip_line(line);
+      }
     }
 
     /* update 6-Buttons & Lightguns */
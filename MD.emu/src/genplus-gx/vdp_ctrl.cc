@@ -205,6 +205,7 @@ void vdp_init(void)
 
 void vdp_reset(void)
 {
+  render_sync();
   memset ((char *) sat.b, 0, sizeof (sat));
   memset ((char *) vram.b, 0, sizeof (vram));
   memset ((char *) cram.b, 0, sizeof (cram));
@@ -311,6 +312,7 @@ void vdp_reset(void)
 
 int vdp_context_save(uint8 *state)
 {
+  render_sync();
 	//logMsg("saving VDP context");
   int bufferptr = 0;
 
@@ -339,6 +341,7 @@ int vdp_context_save(uint8 *state)
 
 int vdp_context_load(uint8 *state)
 {
+  render_sync();
 	//logMsg("loading VDP context");
   int i, bufferptr = 0;
   uint8 temp_reg[0x20];
@@ -417,6 +420,7 @@ int vdp_context_load(uint8 *state)
 
 void vdp_dma_update(unsigned int cycles)
 {
+  render_sync();
   int dma_cycles;
 
   /* DMA transfer rate (bytes per line)
@@ -828,6 +832,9 @@ void vdp_z80_ctrl_w(unsigned int data)
  */
 unsigned int vdp_68k_ctrl_r(unsigned int cycles)
 {
+  /* Wait for queued lines & merge their sprite flags */
+  render_status_sync();
+
   /* Update FIFO flags */
   vdp_fifo_update(cycles);
 
@@ -845,6 +852,7 @@ unsigned int vdp_68k_ctrl_r(unsigned int cycles)
 
   /* Clear SOVR & SCOL flags */
   status &= 0xFF9F;
+  render_status_read();
 
   /* Display OFF: VBLANK flag is set */
   if (!(reg[1] & 0x40))
@@ -886,6 +894,9 @@ unsigned int vdp_68k_ctrl_r(unsigned int cycles)
 
 unsigned int vdp_z80_ctrl_r(unsigned int cycles)
 {
+  /* Wait for queued lines & merge their sprite flags, spr_col is also read below */
+  render_status_sync();
+
   /* Update DMA Busy flag (Mega Drive VDP specific) */
   if (/*(system_hw & SYSTEM_MD) &&*/ (status & 2) && !dma_length && (cycles >= dma_endCycles))
   {
@@ -907,6 +918,7 @@ unsigned int vdp_z80_ctrl_r(unsigned int cycles)
     else if ((line >= 0) && (line < bitmap.viewport.h) && !(work_ram[0x1ffb] & cart.special))
     {
       /* Check sprites overflow & collision */
+      render_sync();
       render_line(line, framebufferPixmap());
     }
   }
@@ -919,6 +931,7 @@ unsigned int vdp_z80_ctrl_r(unsigned int cycles)
 
   /* Clear VINT, SOVR & SCOL flags */
   status &= 0xFF1F;
+  render_status_read();
 
   /* Mega Drive VDP specific */
   //if (system_hw & SYSTEM_MD)
@@ -1108,6 +1121,9 @@ static void vdp_reg_w(unsigned int r, unsigned int d, unsigned int cycles)
   error("[%d(%d)][%d(%d)] VDP register %d write -> 0x%x (%x)\n", v_counter, cycles/MCYCLES_PER_LINE, cycles, cycles%MCYCLES_PER_LINE, r, d, m68k_get_reg (NULL, M68K_REG_PC));
 #endif
 
+  /* Queued lines must be rendered with the old register values */
+  render_sync();
+
   /* VDP registers #11 to #23 cannot be updated in Mode 4 (Captain Planet & Avengers, Bass Master Classic Pro Edition) */
   if (!(reg[1] & 4) && (r > 10))
   {
@@ -1841,6 +1857,7 @@ static void vdp_bus_w(unsigned int data)
 
 static void vdp_68k_data_w_m4(unsigned int data)
 {
+  render_sync();
   /* Clear pending flag */
   pending = 0;
 
@@ -1930,6 +1947,7 @@ static void vdp_68k_data_w_m4(unsigned int data)
 
 static void vdp_68k_data_w_m5(unsigned int data)
 {
+  render_sync();
   /* Clear pending flag */
   pending = 0;
 
@@ -2065,6 +2083,7 @@ static unsigned int vdp_68k_data_r_m5(void)
 
 static void vdp_z80_data_w_m4(unsigned int data)
 {
+  render_sync();
   /* Clear pending flag */
   pending = 0;
 
@@ -2116,6 +2135,7 @@ static void vdp_z80_data_w_m4(unsigned int data)
 
 static void vdp_z80_data_w_m5(unsigned int data)
 {
+  render_sync();
   /* Clear pending flag */
   pending = 0;
 
@@ -2295,6 +2315,7 @@ static unsigned int vdp_z80_data_r_m5(void)
 #if 0
 static void vdp_z80_data_w_ms(unsigned int data)
 {
+  render_sync();
   /* Clear pending flag */
   pending = 0;
 
@@ -2360,6 +2381,7 @@ static void vdp_z80_data_w_ms(unsigned int data)
 
 static void vdp_z80_data_w_gg(unsigned int data)
 {
+  render_sync();
   /* Clear pending flag */
   pending = 0;
 
@@ -2433,6 +2455,7 @@ static void vdp_z80_data_w_gg(unsigned int data)
 
 static void vdp_z80_data_w_sg(unsigned int data)
 {
+  render_sync();
   /* Clear pending flag */
   pending = 0;
 
@@ -24,6 +24,8 @@
 #include "shared.h"
 #include "vdp_render.h"
 #include <imagine/pixmap/Pixmap.hh>
+#include <imagine/thread/JobQueueThread.hh>
+#include <atomic>
 
 #ifdef NGC
 #include "md_ntsc.h"
@@ -404,7 +406,7 @@ static __inline__ void WRITE_LONG(void *address, uint32 data)
     { \
       temp |= (lb[i] << 8); \
       lb[i] = TABLE[temp | ATTR]; \
-      status |= ((temp & 0x8000) >> 10); \
+      spr_status |= ((temp & 0x8000) >> 10); \
     } \
   }
 
@@ -416,10 +418,10 @@ static __inline__ void WRITE_LONG(void *address, uint32 data)
     { \
       temp |= (lb[i] << 8); \
       lb[i] = TABLE[temp | ATTR]; \
-      if ((temp & 0x8000) && !(status & 0x20)) \
+      if ((temp & 0x8000) && !((line_status | spr_status) & 0x20)) \
       { \
-        spr_col = (v_counter << 8) | ((xpos + i + 13) >> 1); \
-        status |= 0x20; \
+        spr_col = (line_vcounter << 8) | ((xpos + i + 13) >> 1); \
+        spr_status |= 0x20; \
       } \
     } \
   }
@@ -432,18 +434,18 @@ static __inline__ void WRITE_LONG(void *address, uint32 data)
     { \
       temp |= (lb[i] << 8); \
       lb[i] = TABLE[temp | ATTR]; \
-      if ((temp & 0x8000) && !(status & 0x20)) \
+      if ((temp & 0x8000) && !((line_status | spr_status) & 0x20)) \
       { \
-        spr_col = (v_counter << 8) | ((xpos + i + 13) >> 1); \
-        status |= 0x20; \
+        spr_col = (line_vcounter << 8) | ((xpos + i + 13) >> 1); \
+        spr_status |= 0x20; \
       } \
       temp &= 0x00FF; \
       temp |= (lb[i+1] << 8); \
       lb[i+1] = TABLE[temp | ATTR]; \
-      if ((temp & 0x8000) && !(status & 0x20)) \
+      if ((temp & 0x8000) && !((line_status | spr_status) & 0x20)) \
       { \
-        spr_col = (v_counter << 8) | ((xpos + i + 1 + 13) >> 1); \
-        status |= 0x20; \
+        spr_col = (line_vcounter << 8) | ((xpos + i + 1 + 13) >> 1); \
+        spr_status |= 0x20; \
       } \
     } \
   }
@@ -520,6 +522,23 @@ uint8 object_count;
 /* Sprite Collision Info */
 uint16 spr_col;
 
+/* Sprite overflow & collision flags set while rendering since the last status read */
+static uint16 spr_status;
+
+/* Flags in spr_status already passed on to the VDP status */
+static uint16 spr_status_published;
+
+/* Flags from rendered lines waiting to be merged into the VDP status */
+static std::atomic<uint16> spr_status_pending;
+
+/* Count of status reads that cleared the sprite flags, lines rendered after a new
+   read start collecting flags again */
+static uint8 status_reads, line_status_reads;
+
+/* VDP status & V counter when the line being rendered was queued */
+static uint16 line_status;
+static uint16 line_vcounter;
+
 /* Function pointers */
 void (*render_bg)(int line, int width);
 void (*render_obj)(int max_width);
@@ -2829,7 +2848,7 @@ void render_obj_m4(int max_width)
   }
 
   /* Set SOVR flag */
-  status |= spr_ovr;
+  spr_status |= spr_ovr;
   spr_ovr = 0;
 
   /* Draw sprites in front-to-back order */
@@ -3458,7 +3477,7 @@ void parse_satb_m5(int line)
       /* Sprite overflow */
       if(count == max)
       {
-        status |= 0x40;
+        spr_status |= 0x40;
         break;
       }
 
@@ -3688,6 +3707,9 @@ void render_init(void)
 
 void render_reset(void)
 {
+  /* Wait for queued lines */
+  render_sync();
+
   /* Clear line buffers */
   memset(linebuf, 0, sizeof(linebuf));
 
@@ -3696,6 +3718,8 @@ void render_reset(void)
 
   /* Reset Sprite infos */
   spr_ovr = spr_col = object_count = 0;
+  spr_status = spr_status_published = 0;
+  spr_status_pending = 0;
 }
 
 
@@ -3703,7 +3727,37 @@ void render_reset(void)
 /* Line rendering functions                                                 */
 /*--------------------------------------------------------------------------*/
 
-void render_line(int line, IG::MutablePixmapView pix)
+static void begin_line(uint16 vdp_status, uint16 vcounter, uint8 reads)
+{
+  line_status = vdp_status;
+  line_vcounter = vcounter;
+  if (reads != line_status_reads)
+  {
+    line_status_reads = reads;
+    spr_status = spr_status_published = 0;
+  }
+}
+
+static void end_line(void)
+{
+  if (uint16 flags = spr_status & ~spr_status_published)
+  {
+    spr_status_published |= flags;
+    spr_status_pending.fetch_or(flags, std::memory_order_release);
+  }
+}
+
+void render_merge_status(void)
+{
+  status |= spr_status_pending.exchange(0, std::memory_order_acquire);
+}
+
+void render_status_read(void)
+{
+  status_reads++;
+}
+
+static void draw_line(int line, IG::MutablePixmapView pix)
 {
   int width = bitmap.viewport.w;
 
@@ -3754,6 +3808,37 @@ void render_line(int line, IG::MutablePixmapView pix)
   	remap_line(line, pix);
 }
 
+void render_line(int line, IG::MutablePixmapView pix)
+{
+  begin_line(status, v_counter, status_reads);
+  draw_line(line, pix);
+  end_line();
+  render_merge_status();
+}
+
+static void parse_line_sprites(int line)
+{
+  /* Only parse sprites so the overflow flag stays accurate, no pixels are output */
+  if ((reg[1] & 0x40) && (line < (bitmap.viewport.h - 1)))
+  {
+    if (render_obj == render_obj_m4)
+    {
+      /* Set SOVR flag from previous line */
+      spr_status |= spr_ovr;
+      spr_ovr = 0;
+    }
+    parse_satb(line);
+  }
+}
+
+void skip_line(int line)
+{
+  begin_line(status, v_counter, status_reads);
+  parse_line_sprites(line);
+  end_line();
+  render_merge_status();
+}
+
 void blank_line(int line, int offset, int width)
 {
   memset(&linebuf[0][0x20 + offset], 0x40, width);
@@ -3785,6 +3870,121 @@ void remap_line(int line, IG::MutablePixmapView pix)
 	while (--width);
 }
 
+
+/*--------------------------------------------------------------------------*/
+/* Threaded line rendering                                                  */
+/*--------------------------------------------------------------------------*/
+
+/*
+  Active display lines are queued in order to a worker thread so they're rendered in
+  parallel with the CPUs. Any write to VDP state the renderer reads (registers, data port,
+  DMA, state loading) calls render_sync() first, so the output always matches rendering
+  each line inline, including mid-line register changes that re-render a line.
+  Status reads also wait if any line is still queued so the sprite overflow & collision
+  flags don't depend on how far the worker has gotten.
+  The queue is drained at the end of active display, so everything else runs inline.
+*/
+
+enum
+{
+  JOB_RENDER_LINE,
+  JOB_SKIP_LINE,
+};
+
+struct render_job
+{
+  IG::MutablePixmapView pix;
+  int16 line;
+  uint16 status;
+  uint16 v_counter;
+  uint8 status_reads;
+  uint8 type;
+};
+
+static IG::JobQueueThread<render_job, 512> render_thread;
+static IG::Nanoseconds render_frame_time;
+
+static void run_job(const render_job &job)
+{
+  begin_line(job.status, job.v_counter, job.status_reads);
+  switch(job.type)
+  {
+    case JOB_RENDER_LINE: draw_line(job.line, job.pix); break;
+    case JOB_SKIP_LINE: parse_line_sprites(job.line); break;
+  }
+  end_line();
+}
+
+static void queue_job(render_job job)
+{
+  job.status = status;
+  job.v_counter = v_counter;
+  job.status_reads = status_reads;
+  render_thread.push(job);
+}
+
+void render_set_threaded(bool on)
+{
+  if(on == render_thread.isRunning())
+    return;
+  if(on)
+  {
+    render_thread.start([](const render_job &job){ run_job(job); });
+  }
+  else
+  {
+    render_thread.stop();
+    render_merge_status();
+  }
+}
+
+IG::ThreadId render_thread_id(void)
+{
+  return render_thread.threadId();
+}
+
+IG::Nanoseconds render_thread_frame_time(void)
+{
+  return render_frame_time;
+}
+
+void render_sync(void)
+{
+  if(!render_thread.isRunning())
+    return;
+  render_thread.sync();
+  render_merge_status();
+}
+
+void render_status_sync(void)
+{
+  if(render_thread.isRunning() && render_thread.hasPendingJobs())
+    render_thread.sync();
+  render_merge_status();
+}
+
+void render_frame_sync(void)
+{
+  if(!render_thread.isRunning())
+    return;
+  render_sync();
+  render_frame_time = render_thread.takeBusyTime();
+}
+
+void render_queue_line(int line, IG::MutablePixmapView pix)
+{
+  if(!render_thread.isRunning())
+    return render_line(line, pix);
+  queue_job({.pix = pix, .line = int16(line), .type = JOB_RENDER_LINE});
+}
+
+void render_queue_skip_line(int line)
+{
+  if(!render_thread.isRunning())
+    return skip_line(line);
+  queue_job({.line = int16(line), .type = JOB_SKIP_LINE});
+}
+
 static bool isValidPixelFormat(IG::PixelFormat fmt)
 {
 	if constexpr(RENDER_BPP == 32)
@@ -3801,6 +4001,7 @@ void setFramebufferRenderFormat(IG::PixelFormat fmt)
 {
 	if(!isValidPixelFormat(fmt))
 		return;
+	render_sync();
 	fbRenderFormat = fmt;
 	palette_init();
 }
@@ -25,6 +25,8 @@
 #define _RENDER_H_
 
 #include <imagine/pixmap/Pixmap.hh>
+#include <imagine/thread/Thread.hh>
+#include <imagine/time/Time.hh>
 #include <type_traits>
 
 static constexpr unsigned RENDER_BPP = 32;
@@ -38,9 +40,20 @@ extern uint16 spr_col;
 extern void render_init(void);
 extern void render_reset(void);
 extern void render_line(int line, IG::MutablePixmapView pix);
+extern void skip_line(int line);
 extern void blank_line(int line, int offset, int width);
 extern void remap_line(int line, IG::MutablePixmapView pix);
 extern void remapPixmap(IG::MutablePixmapView dest, IG::PixmapView src);
+extern void render_set_threaded(bool on);
+extern IG::ThreadId render_thread_id(void);
+extern IG::Nanoseconds render_thread_frame_time(void);
+extern void render_sync(void);
+extern void render_merge_status(void);
+extern void render_status_sync(void);
+extern void render_status_read(void);
+extern void render_frame_sync(void);
+extern void render_queue_line(int line, IG::MutablePixmapView pix);
+extern void render_queue_skip_line(int line);
 extern void window_clip(unsigned int data, unsigned int sw);
 extern void render_bg_m4(int line, int width);
 extern void render_bg_m5(int line, int width);
@@ -264,11 +264,24 @@ class CustomSystemOptionView : public SystemOptionView, public MainAppHelper<Cus
 		}
 	};
 
+	BoolMenuItem renderThread
+	{
+		"Render Video On Separate Thread", attachParams(),
+		(bool)system().optionRenderThread,
+		[this](BoolMenuItem &item)
+		{
+			system().optionRenderThread = item.flipBoolValue(*this);
+			if(system().hasContent())
+				system().updateRenderThread();
+		}
+	};
+
 public:
 	CustomSystemOptionView(ViewAttachParams attach): SystemOptionView{attach, true}
 	{
 		loadStockItems();
 		item.emplace_back(&bigEndianSram);
+		item.emplace_back(&renderThread);
 	}
 };
 
@@ -116,6 +116,20 @@ void MdSystem::renderFramebuffer(EmuVideo &video)
 	video.startFrameWithAltFormat({}, framebufferRenderFormatPixmap());
 }
 
+void MdSystem::updateRenderThread()
+{
+	// only Mode 5 frames queue lines for the render thread
+	render_set_threaded(optionRenderThread && system_hw != SYSTEM_PBC);
+}
+
+void MdSystem::addThreadGroupIds(std::vector<ThreadId> &ids) const
+{
+	if(auto id = render_thread_id())
+		ids.emplace_back(id);
+}
+
+FrameTime MdSystem::helperThreadFrameTime() const { return render_thread_frame_time(); }
+
 VideoSystem MdSystem::videoSystem() const { return vdp_pal ? VideoSystem::PAL : VideoSystem::NATIVE_NTSC; }
 
 void MdSystem::reset(EmuApp &, ResetMode mode)
@@ -290,6 +304,7 @@ void MdSystem::closeSystem()
 		scd_deinit();
 	}
 	#endif
+	render_set_threaded(false);
 	old_system[0] = old_system[1] = -1;
 	input.system[0] = input.system[1] = NO_SYSTEM;
 	clearCheatList();
@@ -424,6 +439,7 @@ void MdSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegate
 		log.info("using PAL timing");
 
 	system_init();
+	updateRenderThread();
 	for(auto i : iotaCount(2))
 	{
 		if(old_system[i] != -1)
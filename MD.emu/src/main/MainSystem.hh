@@ -37,6 +37,7 @@ enum
 	CFGKEY_MD_REGION = 284, CFGKEY_VIDEO_SYSTEM = 285,
 	CFGKEY_INPUT_PORT_1 = 286, CFGKEY_INPUT_PORT_2 = 287,
 	CFGKEY_MULTITAP = 288, CFGKEY_CHEATS_PATH = 289,
+	CFGKEY_RENDER_THREAD = 290,
 };
 
 bool hasMDExtension(std::string_view name);
@@ -55,6 +56,7 @@ public:
 	Property<bool, CFGKEY_SMS_FM, PropertyDesc<bool>{.defaultValue = true}> optionSmsFM;
 	Property<bool, CFGKEY_6_BTN_PAD> option6BtnPad;
 	Property<bool, CFGKEY_MULTITAP> optionMultiTap;
+	Property<bool, CFGKEY_RENDER_THREAD> optionRenderThread;
 	Property<int8_t, CFGKEY_INPUT_PORT_1, PropertyDesc<int8_t>{.defaultValue = -1, .isValid = isValidWithMinMax<-1, 4>}> optionInputPort1;
 	Property<int8_t, CFGKEY_INPUT_PORT_2, PropertyDesc<int8_t>{.defaultValue = -1, .isValid = isValidWithMinMax<-1, 4>}> optionInputPort2;
 	Property<uint8_t, CFGKEY_MD_REGION, PropertyDesc<uint8_t>{.isValid = isValidWithMax<4>}> optionRegion;
@@ -103,6 +105,9 @@ public:
 		Input::DragTrackerState prevDragState, IG::WindowRect gameRect);
 	bool onPointerInputEnd(const Input::MotionEvent &, Input::DragTrackerState, IG::WindowRect gameRect);
 	VideoSystem videoSystem() const;
+	void addThreadGroupIds(std::vector<ThreadId> &) const;
+	FrameTime helperThreadFrameTime() const;
+	void updateRenderThread();
 
 private:
 	void setupSmsInput(EmuApp &);
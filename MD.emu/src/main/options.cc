@@ -66,6 +66,7 @@ bool MdSystem::readConfig(ConfigType type, MapIO &io, unsigned key)
 		{
 			case CFGKEY_BIG_ENDIAN_SRAM: return readOptionValue(io, optionBigEndianSram);
 			case CFGKEY_SMS_FM: return readOptionValue(io, optionSmsFM);
+			case CFGKEY_RENDER_THREAD: return readOptionValue(io, optionRenderThread);
 			#ifndef NO_SCD
 			case CFGKEY_MD_CD_BIOS_USA_PATH: return readStringOptionValue(io, cdBiosUSAPath);
 			case CFGKEY_MD_CD_BIOS_JPN_PATH: return readStringOptionValue(io, cdBiosJpnPath);
@@ -95,6 +96,7 @@ void MdSystem::writeConfig(ConfigType type, FileIO &io)
 	{
 		writeOptionValueIfNotDefault(io, optionBigEndianSram);
 		writeOptionValueIfNotDefault(io, optionSmsFM);
+		writeOptionValueIfNotDefault(io, optionRenderThread);
 		#ifndef NO_SCD
 		writeStringOptionValue(io, CFGKEY_MD_CD_BIOS_USA_PATH, cdBiosUSAPath);
 		writeStringOptionValue(io, CFGKEY_MD_CD_BIOS_JPN_PATH, cdBiosJpnPath);
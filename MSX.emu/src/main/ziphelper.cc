@@ -36,7 +36,7 @@ constexpr SystemLogger log{"MSX.emu"};
 using namespace EmuEx;
 
 static struct archive *writeArch{};
-static FS::ArchiveIterator cachedZipIt{};
+static FS::ArchiveIndex cachedZipIndex{};
 static FS::PathString cachedZipName{};
 static uint8_t *buffData{};
 static size_t buffSize{};
@@ -51,7 +51,7 @@ size_t zipMemBufferSize() { return buffSize; }
 
 static void unsetCachedReadZip()
 {
-	cachedZipIt = {};
+	cachedZipIndex = {};
 	cachedZipName = {};
 	EmuEx::log.info("unset cached read zip archive");
 }
@@ -71,52 +71,52 @@ void zipCacheReadOnlyZip(const char* zipName_)
 		{
 			EmuEx::log.info("using memory buffer as cached read zip archive");
 			std::span buff{buffData, buffSize};
-			cachedZipIt = IO{buff};
+			cachedZipIndex = FS::ArchiveIndex{IO{buff}};
 		}
 		else
 		{
 			EmuEx::log.info("setting cached read zip archive:{}", zipName);
-			cachedZipIt = {EmuEx::gAppContext().openFileUri(zipName)};
+			cachedZipIndex = FS::ArchiveIndex{IO{EmuEx::gAppContext().openFileUri(zipName)}};
 		}
 	}
 }
 
-static void *loadFromArchiveIt(FS::ArchiveIterator &it, const char* zipName, const char* fileName, int* size)
+static void *loadFromArchiveIndex(FS::ArchiveIndex &index, const char* zipName, const char* fileName, int* size)
 {
-	for(auto &entry : it)
+	auto entry = index.find(fileName);
+	if(!entry || entry->type == FS::file_type::directory)
 	{
-		if(entry.type() == FS::file_type::directory)
-		{
-			continue;
-		}
-		//logMsg("archive file entry:%s", entry.name());
-		if(entry.name() == fileName)
-		{
-			int fileSize = entry.size();
-			void *buff = malloc(fileSize);
-			entry.read(buff, fileSize);
-			*size = fileSize;
-			return buff;
-		}
+		logErr("file %s not in %sarchive:%s", fileName,
+			&index == &cachedZipIndex ? "cached " : "", zipName);
+		return nullptr;
+	}
+	int fileSize = entry->size;
+	void *buff = malloc(fileSize);
+	try
+	{
+		index.read(*entry, {(uint8_t*)buff, entry->size});
+	}
+	catch(...)
+	{
+		free(buff);
+		throw;
 	}
-	logErr("file %s not in %sarchive:%s", fileName,
-		cachedZipIt.hasEntry() && cachedZipName == zipName ? "cached " : "", zipName);
-	return nullptr;
+	*size = fileSize;
+	return buff;
 }
 
 void* zipLoadFile(const char* zipName, const char* fileName, int* size)
 {
 	try
 	{
-		if(cachedZipIt.hasEntry() && cachedZipName == zipName)
+		if(cachedZipIndex && cachedZipName == zipName)
 		{
-			cachedZipIt.rewind();
-			return loadFromArchiveIt(cachedZipIt, zipName, fileName, size);
+			return loadFromArchiveIndex(cachedZipIndex, zipName, fileName, size);
 		}
 		else
 		{
-			auto it = FS::ArchiveIterator{EmuEx::gAppContext().openFileUri(zipName)};
-			return loadFromArchiveIt(it, zipName, fileName, size);
+			FS::ArchiveIndex index{IO{EmuEx::gAppContext().openFileUri(zipName)}};
+			return loadFromArchiveIndex(index, zipName, fileName, size);
 		}
 	}
 	catch(...)
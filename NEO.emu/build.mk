@@ -41,7 +41,8 @@ $(GEO)/neocrypt.c \
 $(GEO)/pd4990a.c \
 $(GEO)/roms.c \
 $(GEO)/timer.c \
-$(GEO)/video.c
+$(GEO)/video.c \
+$(GEO)/video_simd.c
 
 ifeq ($(ENV), webos)
  LDLIBS += -lpthread
@@ -28,6 +28,7 @@
 #include "emu.h"
 #include "transpack.h"
 #include "screen.h"
+#include "video_simd.h"
 #include <imagine/logger/logger.h>
 
 extern int neogeo_fix_bank_type;
@@ -95,6 +96,10 @@ Uint32 ddaxskip_i[16] = {
 };
 Uint32 dda_x_skip_i;
 
+#ifdef VIDEO_SIMD
+static int video_simd;
+#endif
+
 static __inline__ Uint16 alpha_blend(Uint16 dest, Uint16 src, Uint8 a) {
 	static Uint8 dr, dg, db, sr, sg, sb;
 
@@ -392,6 +397,12 @@ static __inline__ void draw_fix_char(unsigned char *buf, int start, int end) {
 #elif I386_ASM
 			draw_one_char_i386(byte1, byte2, br);
 #else
+#ifdef VIDEO_SIMD
+			if (video_simd) {
+				draw_one_char_simd(byte1, byte2, br);
+				continue;
+			}
+#endif
 			paldata = (unsigned int *) &current_pc_pal[16 * byte2];
 			gfxdata = (unsigned int *) &current_fix[ byte1 << 5];
 
@@ -625,11 +636,27 @@ void draw_screen(void *emuTaskPtr, void *neoSystemPtr, void *emuVideoPtr) {
 #else
 				switch (penusage) {
 					case TILE_NORMAL:
+#ifdef VIDEO_SIMD
+						if (video_simd) {
+							draw_tile_simd(tileno, sx + 16, sy, rzx, yskip, tileatr >> 8,
+									tileatr & 0x01, tileatr & 0x02,
+									(unsigned char*) buffer->pixels);
+							break;
+						}
+#endif
 						draw_tile(tileno, sx + 16, sy, rzx, yskip, tileatr >> 8,
 								tileatr & 0x01, tileatr & 0x02,
 								(unsigned char*) buffer->pixels);
 						break;
 					case TILE_TRANSPARENT50:
+#ifdef VIDEO_SIMD
+						if (video_simd) {
+							draw_tile_simd_50(tileno, sx + 16, sy, rzx, yskip, tileatr >> 8,
+									tileatr & 0x01, tileatr & 0x02,
+									(unsigned char*) buffer->pixels);
+							break;
+						}
+#endif
 						draw_tile_50(tileno, sx + 16, sy, rzx, yskip, tileatr >> 8,
 								tileatr & 0x01, tileatr & 0x02,
 								(unsigned char*) buffer->pixels);
@@ -826,10 +853,24 @@ void draw_screen_scanline(int start_line, int end_line, int refresh, void *emuTa
 					break;
 #else
 				case TILE_NORMAL:
+#ifdef VIDEO_SIMD
+					if (video_simd) {
+						draw_scanline_tile_simd(tileno, yoffs, sx + 16, yy, zx, tileatr >> 8,
+								tileatr & 0x01, (unsigned char*) buffer->pixels);
+						break;
+					}
+#endif
 					draw_scanline_tile(tileno, yoffs, sx + 16, yy, zx, tileatr >> 8,
 							tileatr & 0x01, (unsigned char*) buffer->pixels);
 					break;
 				case TILE_TRANSPARENT50:
+#ifdef VIDEO_SIMD
+					if (video_simd) {
+						draw_scanline_tile_simd_50(tileno, yoffs, sx + 16, yy, zx, tileatr >> 8,
+								tileatr & 0x01, (unsigned char*) buffer->pixels);
+						break;
+					}
+#endif
 					draw_scanline_tile_50(tileno, yoffs, sx + 16, yy, zx, tileatr >> 8,
 							tileatr & 0x01, (unsigned char*) buffer->pixels);
 					break;
@@ -869,6 +910,8 @@ void init_video(void) {
 #elif I386_ASM
 	mem_gfx = &memory.rom.tiles.p;
 	mem_video = memory.vid.ram;
+#elif defined(VIDEO_SIMD)
+	video_simd = init_video_simd();
 #endif
 	fix_value_init();
 	memory.vid.modulo = 1;
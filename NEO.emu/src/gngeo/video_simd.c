@@ -0,0 +1,306 @@
+/*  gngeo a neogeo emulator
+ *  Copyright (C) 2001 Peponas Mathieu
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Library General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include "video_simd.h"
+
+#ifdef VIDEO_SIMD
+
+#include <string.h>
+#include "video.h"
+#include "memory.h"
+#include "screen.h"
+#include <imagine/logger/logger.h>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#else
+#include <arm_neon.h>
+#endif
+
+extern char ddaxskip[16][16];
+extern char dda_y_skip[17];
+extern char full_y_skip[16];
+
+/* Each 8 byte tile row is expanded to 16 pens ordered (hi,lo) nibble per byte,
+   then a single byte shuffle reorders them for the x flip and packs the pixels
+   kept by the x zoom to the front. Indexes >= 16 yield pen 0 so the remaining
+   lanes stay transparent. */
+static Uint8 row_shuffle[2][16][16] __attribute__((aligned(16)));
+static Uint8 char_shuffle[16] __attribute__((aligned(16)));
+
+static void init_shuffles(void) {
+	int xflip, zx, i;
+
+	for (xflip = 0; xflip < 2; xflip++) {
+		for (zx = 0; zx < 16; zx++) {
+			int out = 0;
+			memset(row_shuffle[xflip][zx], 0x80, 16);
+			for (i = 0; i < 16; i++) {
+				/* pixel p is at bits (7-p%8)*4 of tile word p/8 */
+				int p = xflip ? 15 - i : i;
+				int q = p & 7;
+				int byte = ((p >> 3) << 2) + ((7 - q) >> 1);
+				if (!ddaxskip[zx][i]) continue;
+				row_shuffle[xflip][zx][out++] = (byte << 1) + (q & 1);
+			}
+		}
+	}
+	/* fix chars store pixel q at bits q*4 of the row word */
+	for (i = 0; i < 16; i++) {
+		int q = i & 7;
+		char_shuffle[i] = ((i >> 3) << 3) + ((q >> 1) << 1) + !(q & 1);
+	}
+}
+
+static inline int row_is_clear(const Uint8 *gfxdata) {
+	uint64_t row;
+	memcpy(&row, gfxdata, sizeof(row));
+	return !row;
+}
+
+#if defined(__x86_64__)
+
+#define SSE41 __attribute__((target("sse4.1")))
+#define AVX2 __attribute__((target("avx2")))
+
+typedef struct {
+	__m128i lo, hi;
+} pal_sse41;
+
+typedef struct {
+	__m256i lo, hi;
+} pal_avx2;
+
+/* split the low 16 bits of the 16 palette entries into byte lookup tables */
+static SSE41 inline pal_sse41 load_pal_sse41(const Uint32 *paldata) {
+	const __m128i mask16 = _mm_set1_epi32(0xffff), mask8 = _mm_set1_epi16(0xff);
+	__m128i p0 = _mm_packus_epi32(
+		_mm_and_si128(_mm_loadu_si128((const __m128i*)paldata), mask16),
+		_mm_and_si128(_mm_loadu_si128((const __m128i*)(paldata + 4)), mask16));
+	__m128i p1 = _mm_packus_epi32(
+		_mm_and_si128(_mm_loadu_si128((const __m128i*)(paldata + 8)), mask16),
+		_mm_and_si128(_mm_loadu_si128((const __m128i*)(paldata + 12)), mask16));
+	pal_sse41 pal = {
+		_mm_packus_epi16(_mm_and_si128(p0, mask8), _mm_and_si128(p1, mask8)),
+		_mm_packus_epi16(_mm_srli_epi16(p0, 8), _mm_srli_epi16(p1, 8))
+	};
+	return pal;
+}
+
+static SSE41 inline __m128i load_shuffle_sse41(const Uint8 *shuffle) {
+	return _mm_load_si128((const __m128i*)shuffle);
+}
+
+static SSE41 inline __m128i expand_row_sse41(const Uint8 *gfxdata, __m128i shuffle) {
+	const __m128i mask4 = _mm_set1_epi8(0xf);
+	__m128i v = _mm_loadl_epi64((const __m128i*)gfxdata);
+	__m128i pens = _mm_unpacklo_epi8(_mm_and_si128(_mm_srli_epi16(v, 4), mask4), _mm_and_si128(v, mask4));
+	return _mm_shuffle_epi8(pens, shuffle);
+}
+
+static SSE41 inline __m128i blend50_sse41(__m128i a, __m128i b) {
+	const __m128i mask = _mm_set1_epi16(0xf7de);
+	return _mm_add_epi16(_mm_srli_epi16(_mm_and_si128(a, mask), 1), _mm_srli_epi16(_mm_and_si128(b, mask), 1));
+}
+
+static SSE41 inline void put8_sse41(Uint16 *br, __m128i px, __m128i clear, int blend50) {
+	__m128i dst = _mm_loadu_si128((const __m128i*)br);
+	if (blend50) px = blend50_sse41(px, dst);
+	_mm_storeu_si128((__m128i*)br, _mm_blendv_epi8(px, dst, clear));
+}
+
+static SSE41 inline void put_row_sse41(Uint16 *br, __m128i pens, pal_sse41 pal, int blend50) {
+	__m128i lo = _mm_shuffle_epi8(pal.lo, pens);
+	__m128i hi = _mm_shuffle_epi8(pal.hi, pens);
+	__m128i clear = _mm_cmpeq_epi8(pens, _mm_setzero_si128());
+	put8_sse41(br, _mm_unpacklo_epi8(lo, hi), _mm_unpacklo_epi8(clear, clear), blend50);
+	put8_sse41(br + 8, _mm_unpackhi_epi8(lo, hi), _mm_unpackhi_epi8(clear, clear), blend50);
+}
+
+static SSE41 inline void put_char_rows_sse41(Uint16 *br, int pitch, __m128i pens, pal_sse41 pal) {
+	__m128i lo = _mm_shuffle_epi8(pal.lo, pens);
+	__m128i hi = _mm_shuffle_epi8(pal.hi, pens);
+	__m128i clear = _mm_cmpeq_epi8(pens, _mm_setzero_si128());
+	put8_sse41(br, _mm_unpacklo_epi8(lo, hi), _mm_unpacklo_epi8(clear, clear), 0);
+	put8_sse41(br + pitch, _mm_unpackhi_epi8(lo, hi), _mm_unpackhi_epi8(clear, clear), 0);
+}
+
+static AVX2 inline pal_avx2 load_pal_avx2(const Uint32 *paldata) {
+	pal_sse41 pal128 = load_pal_sse41(paldata);
+	pal_avx2 pal = {
+		_mm256_broadcastsi128_si256(pal128.lo),
+		_mm256_broadcastsi128_si256(pal128.hi)
+	};
+	return pal;
+}
+
+static AVX2 inline __m128i load_shuffle_avx2(const Uint8 *shuffle) {
+	return load_shuffle_sse41(shuffle);
+}
+
+static AVX2 inline __m128i expand_row_avx2(const Uint8 *gfxdata, __m128i shuffle) {
+	return expand_row_sse41(gfxdata, shuffle);
+}
+
+/* whole 16 pixel row in one 256-bit load/blend/store */
+static AVX2 inline void put_row_avx2(Uint16 *br, __m128i pens, pal_avx2 pal, int blend50) {
+	__m256i pens16 = _mm256_cvtepu8_epi16(pens);
+	__m256i px = _mm256_or_si256(
+		_mm256_and_si256(_mm256_shuffle_epi8(pal.lo, pens16), _mm256_set1_epi16(0xff)),
+		_mm256_slli_epi16(_mm256_shuffle_epi8(pal.hi, pens16), 8));
+	__m256i clear = _mm256_cmpeq_epi16(pens16, _mm256_setzero_si256());
+	__m256i dst = _mm256_loadu_si256((const __m256i*)br);
+	if (blend50) {
+		const __m256i mask = _mm256_set1_epi16(0xf7de);
+		px = _mm256_add_epi16(_mm256_srli_epi16(_mm256_and_si256(px, mask), 1),
+			_mm256_srli_epi16(_mm256_and_si256(dst, mask), 1));
+	}
+	_mm256_storeu_si256((__m256i*)br, _mm256_blendv_epi8(px, dst, clear));
+}
+
+static AVX2 inline void put_char_rows_avx2(Uint16 *br, int pitch, __m128i pens, pal_avx2 pal) {
+	pal_sse41 pal128 = {_mm256_castsi256_si128(pal.lo), _mm256_castsi256_si128(pal.hi)};
+	put_char_rows_sse41(br, pitch, pens, pal128);
+}
+
+#define SIMD(name) name##_sse41
+#define SIMD_ATTR SSE41
+#define SIMD_PAL pal_sse41
+#define SIMD_VEC __m128i
+#include "video_simd_template.h"
+
+#define SIMD(name) name##_avx2
+#define SIMD_ATTR AVX2
+#define SIMD_PAL pal_avx2
+#define SIMD_VEC __m128i
+#include "video_simd_template.h"
+
+#else /* __aarch64__ */
+
+typedef struct {
+	uint8x16_t lo, hi;
+} pal_neon;
+
+static inline pal_neon load_pal_neon(const Uint32 *paldata) {
+	uint16x8_t p0 = vcombine_u16(vmovn_u32(vld1q_u32(paldata)), vmovn_u32(vld1q_u32(paldata + 4)));
+	uint16x8_t p1 = vcombine_u16(vmovn_u32(vld1q_u32(paldata + 8)), vmovn_u32(vld1q_u32(paldata + 12)));
+	pal_neon pal = {
+		vuzp1q_u8(vreinterpretq_u8_u16(p0), vreinterpretq_u8_u16(p1)),
+		vuzp2q_u8(vreinterpretq_u8_u16(p0), vreinterpretq_u8_u16(p1))
+	};
+	return pal;
+}
+
+static inline uint8x16_t load_shuffle_neon(const Uint8 *shuffle) {
+	return vld1q_u8(shuffle);
+}
+
+static inline uint8x16_t expand_row_neon(const Uint8 *gfxdata, uint8x16_t shuffle) {
+	uint8x8_t v = vld1_u8(gfxdata);
+	uint8x8x2_t pens = vzip_u8(vshr_n_u8(v, 4), vand_u8(v, vdup_n_u8(0xf)));
+	return vqtbl1q_u8(vcombine_u8(pens.val[0], pens.val[1]), shuffle);
+}
+
+static inline void put8_neon(Uint16 *br, uint8x16_t px8, uint8x16_t clear8, int blend50) {
+	uint16x8_t px = vreinterpretq_u16_u8(px8);
+	uint16x8_t dst = vld1q_u16(br);
+	if (blend50) {
+		const uint16x8_t mask = vdupq_n_u16(0xf7de);
+		px = vaddq_u16(vshrq_n_u16(vandq_u16(px, mask), 1), vshrq_n_u16(vandq_u16(dst, mask), 1));
+	}
+	vst1q_u16(br, vbslq_u16(vreinterpretq_u16_u8(clear8), dst, px));
+}
+
+static inline void put_row_neon(Uint16 *br, uint8x16_t pens, pal_neon pal, int blend50) {
+	uint8x16x2_t px = vzipq_u8(vqtbl1q_u8(pal.lo, pens), vqtbl1q_u8(pal.hi, pens));
+	uint8x16_t clear = vceqq_u8(pens, vdupq_n_u8(0));
+	uint8x16x2_t clear16 = vzipq_u8(clear, clear);
+	put8_neon(br, px.val[0], clear16.val[0], blend50);
+	put8_neon(br + 8, px.val[1], clear16.val[1], blend50);
+}
+
+static inline void put_char_rows_neon(Uint16 *br, int pitch, uint8x16_t pens, pal_neon pal) {
+	uint8x16x2_t px = vzipq_u8(vqtbl1q_u8(pal.lo, pens), vqtbl1q_u8(pal.hi, pens));
+	uint8x16_t clear = vceqq_u8(pens, vdupq_n_u8(0));
+	uint8x16x2_t clear16 = vzipq_u8(clear, clear);
+	put8_neon(br, px.val[0], clear16.val[0], 0);
+	put8_neon(br + pitch, px.val[1], clear16.val[1], 0);
+}
+
+#define SIMD(name) name##_neon
+#define SIMD_ATTR
+#define SIMD_PAL pal_neon
+#define SIMD_VEC uint8x16_t
+#include "video_simd_template.h"
+
+#endif
+
+static void (*draw_tile_func)(unsigned int tileno, int sx, int sy, int zx, int zy,
+		int color, int xflip, int yflip, unsigned char *bmp, int blend50);
+static void (*draw_scanline_func)(unsigned int tileno, int yoffs, int sx, int line, int zx,
+		int color, int xflip, unsigned char *bmp, int blend50);
+static void (*draw_char_func)(int byte1, int byte2, unsigned short *br);
+
+int init_video_simd(void) {
+#if defined(__x86_64__)
+	if (__builtin_cpu_supports("avx2")) {
+		logMsg("using AVX2 tile drawing");
+		draw_tile_func = draw_tile_avx2;
+		draw_scanline_func = draw_scanline_avx2;
+		draw_char_func = draw_char_avx2;
+	} else if (__builtin_cpu_supports("sse4.1")) {
+		logMsg("using SSE4.1 tile drawing");
+		draw_tile_func = draw_tile_sse41;
+		draw_scanline_func = draw_scanline_sse41;
+		draw_char_func = draw_char_sse41;
+	} else {
+		return 0;
+	}
+#else
+	draw_tile_func = draw_tile_neon;
+	draw_scanline_func = draw_scanline_neon;
+	draw_char_func = draw_char_neon;
+#endif
+	init_shuffles();
+	return 1;
+}
+
+void draw_tile_simd(unsigned int tileno, int sx, int sy, int zx, int zy,
+		int color, int xflip, int yflip, unsigned char *bmp) {
+	draw_tile_func(tileno, sx, sy, zx, zy, color, xflip, yflip, bmp, 0);
+}
+
+void draw_tile_simd_50(unsigned int tileno, int sx, int sy, int zx, int zy,
+		int color, int xflip, int yflip, unsigned char *bmp) {
+	draw_tile_func(tileno, sx, sy, zx, zy, color, xflip, yflip, bmp, 1);
+}
+
+void draw_scanline_tile_simd(unsigned int tileno, int yoffs, int sx, int line, int zx,
+		int color, int xflip, unsigned char *bmp) {
+	draw_scanline_func(tileno, yoffs, sx, line, zx, color, xflip, bmp, 0);
+}
+
+void draw_scanline_tile_simd_50(unsigned int tileno, int yoffs, int sx, int line, int zx,
+		int color, int xflip, unsigned char *bmp) {
+	draw_scanline_func(tileno, yoffs, sx, line, zx, color, xflip, bmp, 1);
+}
+
+void draw_one_char_simd(int byte1, int byte2, unsigned short *br) {
+	draw_char_func(byte1, byte2, br);
+}
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef _VIDEO_SIMD_H_
+#define _VIDEO_SIMD_H_
+
+#ifdef HAVE_CONFIG_H
+#include <gngeo-config.h>
+#endif
+
+/* SSE4.1/AVX2 and NEON tile drawing used in place of the C templates on
+   64-bit targets without hand written asm */
+#if (defined(__x86_64__) || defined(__aarch64__)) && !defined(PROCESSOR_ARM) && !defined(I386_ASM)
+#define VIDEO_SIMD
+
+/* returns 0 if the CPU lacks the needed instructions and the C templates must be used */
+int init_video_simd(void);
+
+/* same arguments as the draw_tile/draw_scanline_tile templates, except the
+   scanline zx is the raw 0-15 zoom value used to index ddaxskip */
+void draw_tile_simd(unsigned int tileno, int sx, int sy, int zx, int zy,
+		int color, int xflip, int yflip, unsigned char *bmp);
+void draw_tile_simd_50(unsigned int tileno, int sx, int sy, int zx, int zy,
+		int color, int xflip, int yflip, unsigned char *bmp);
+void draw_scanline_tile_simd(unsigned int tileno, int yoffs, int sx, int line, int zx,
+		int color, int xflip, unsigned char *bmp);
+void draw_scanline_tile_simd_50(unsigned int tileno, int yoffs, int sx, int line, int zx,
+		int color, int xflip, unsigned char *bmp);
+void draw_one_char_simd(int byte1, int byte2, unsigned short *br);
+#endif
+
+#endif
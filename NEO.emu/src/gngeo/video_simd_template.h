@@ -0,0 +1,61 @@
+/* SIMD tile drawing template
+   use SIMD(name) to set the function suffix, SIMD_ATTR for the target attribute,
+   SIMD_PAL for the palette type and SIMD_VEC for a vector of 16 pen indexes.
+   The ISA must provide load_pal, load_shuffle, expand_row, put_row & put_char_rows
+   with the same suffix.
+*/
+
+static SIMD_ATTR void SIMD(draw_tile)(unsigned int tileno, int sx, int sy, int zx, int zy,
+		int color, int xflip, int yflip, unsigned char *bmp, int blend50)
+{
+	const Uint8 *gfxdata = &memory.rom.tiles.p[(tileno % memory.nb_of_tiles) << 7];
+	const char *l_y_skip = zy == 16 ? full_y_skip : dda_y_skip;
+	int pitch = buffer->pitch >> 1;
+	Uint16 *br = (Uint16*)bmp + sy * pitch + sx;
+	SIMD_PAL pal = SIMD(load_pal)(&current_pc_pal[16 * color]);
+	SIMD_VEC shuffle = SIMD(load_shuffle)(row_shuffle[xflip != 0][zx - 1]);
+	int y;
+
+	if (yflip) {
+		br += (zy - 1) * pitch;
+		pitch = -pitch;
+	}
+	for (y = 0; y < zy; y++) {
+		gfxdata += l_y_skip[y] << 3;
+		if (!row_is_clear(gfxdata))
+			SIMD(put_row)(br, SIMD(expand_row)(gfxdata, shuffle), pal, blend50);
+		br += pitch;
+	}
+}
+
+static SIMD_ATTR void SIMD(draw_scanline)(unsigned int tileno, int yoffs, int sx, int line, int zx,
+		int color, int xflip, unsigned char *bmp, int blend50)
+{
+	const Uint8 *gfxdata = &memory.rom.tiles.p[((tileno % memory.nb_of_tiles) << 7) + (yoffs << 3)];
+	Uint16 *br = (Uint16*)bmp + line * (buffer->pitch >> 1) + sx;
+
+	if (row_is_clear(gfxdata)) return;
+	SIMD(put_row)(br, SIMD(expand_row)(gfxdata, SIMD(load_shuffle)(row_shuffle[xflip != 0][zx])),
+		SIMD(load_pal)(&current_pc_pal[16 * color]), blend50);
+}
+
+static SIMD_ATTR void SIMD(draw_char)(int byte1, int byte2, unsigned short *br)
+{
+	const Uint8 *gfxdata = &current_fix[byte1 << 5];
+	SIMD_PAL pal = SIMD(load_pal)(&current_pc_pal[16 * byte2]);
+	SIMD_VEC shuffle = SIMD(load_shuffle)(char_shuffle);
+	int pitch = buffer->w;
+	int y;
+
+	/* two 8 pixel rows per vector */
+	for (y = 0; y < 8; y += 2) {
+		SIMD(put_char_rows)(br, pitch, SIMD(expand_row)(gfxdata, shuffle), pal);
+		gfxdata += 8;
+		br += pitch * 2;
+	}
+}
+
+#undef SIMD
+#undef SIMD_ATTR
+#undef SIMD_PAL
+#undef SIMD_VEC
@@ -19,11 +19,11 @@
 #include <imagine/io/FileIO.hh>
 #include <imagine/fs/ArchiveFS.hh>
 #include <imagine/fs/FS.hh>
-#include <imagine/util/ScopeGuard.hh>
 #include <imagine/util/bit.hh>
 #include <imagine/logger/logger.h>
 #include <imagine/util/string.h>
 #include <cstdlib>
+#include <exception>
 
 extern "C"
 {
@@ -33,48 +33,67 @@ extern "C"
 
 using namespace IG;
 
-struct PKZIP : public FS::ArchiveIterator {};
+struct PKZIP : public FS::ArchiveIndex {};
 
 struct ZFILE
 {
-	ArchiveIO io;
-	FS::ArchiveIterator *arch;
+	// ROMs are read in pieces into their regions, so decompress as they're read
+	FS::ArchiveIndex::EntryReader reader;
 };
 
+static const FS::ArchiveIndex::Entry *findEntry(PKZIP &arch, const char *filename, uint32_t fileCRC)
+{
+	int loadByName = fileCRC == (uint32_t)-1 || !gn_strictROMChecking();
+	auto entry = arch.findFile([&](auto &entry)
+	{
+		//logMsg("archive file entry:%s crc32:0x%X", entry.name.c_str(), entry.crc32);
+		return (loadByName && entry.name == filename) || entry.crc32 == fileCRC;
+	});
+	if(!entry)
+	{
+		logMsg("file:%s crc32:0x%X not found in archive", filename, fileCRC);
+	}
+	return entry;
+}
+
 ZFILE *gn_unzip_fopen(PKZIP *archPtr, const char *filename, uint32_t fileCRC)
 {
 	auto &arch = *archPtr;
-	arch.rewind();
-	for(auto &entry : arch)
+	auto entry = findEntry(arch, filename, fileCRC);
+	if(!entry)
 	{
-		if(entry.type() == FS::file_type::directory)
-		{
-			continue;
-		}
-		auto crc = entry.crc32();
-		//logMsg("archive file entry:%s crc32:0x%X", name, crc);
-		int loadByName = fileCRC == (uint32_t)-1 || !gn_strictROMChecking();
-		if((loadByName && entry.name() == filename) || crc == fileCRC)
-		{
-			//logMsg("opened archive entry file:%s crc32:0x%X", name, crc);
-			return new ZFILE{std::move(entry), archPtr};
-		}
+		return nullptr;
+	}
+	try
+	{
+		//logMsg("opened archive entry file:%s crc32:0x%X", filename, entry->crc32);
+		return new ZFILE{{arch, *entry}};
+	}
+	catch(...)
+	{
+		logErr("error reading archive entry:%s", entry->name.c_str());
+		return nullptr;
 	}
-	logMsg("file:%s crc32:0x%X not found in archive", filename, fileCRC);
-	return nullptr;
 }
 
 void gn_unzip_fclose(ZFILE *z)
 {
 	//logMsg("done with archive entry");
-	*z->arch = std::move(z->io);
 	delete z;
 }
 
 int gn_unzip_fread(ZFILE *z, uint8_t *data, unsigned int size)
 {
 	//logMsg("reading %u bytes to %p", size, data);
-	return z->io.read(data, size);
+	try
+	{
+		return z->reader.read({data, size});
+	}
+	catch(std::exception &err)
+	{
+		logErr("%s", err.what());
+		return -1;
+	}
 }
 
 PKZIP *gn_open_zip(void *contextPtr, const char *path)
@@ -82,8 +101,8 @@ PKZIP *gn_open_zip(void *contextPtr, const char *path)
 	auto &ctx = *((IG::ApplicationContext*)contextPtr);
 	try
 	{
-		auto arch = std::make_unique<FS::ArchiveIterator>(ctx.openFileUri(path));
-		return static_cast<PKZIP*>(arch.release());
+		auto arch = std::make_unique<PKZIP>(FS::ArchiveIndex{IO{ctx.openFileUri(path)}});
+		return arch.release();
 	}
 	catch(...)
 	{
@@ -99,17 +118,22 @@ void gn_close_zip(PKZIP *archPtr)
 
 uint8_t *gn_unzip_file_malloc(PKZIP *archPtr, const char *filename, uint32_t fileCRC, unsigned int *outlen)
 {
-	auto z = gn_unzip_fopen(archPtr, filename, fileCRC);
-	if(!z)
+	auto &arch = *archPtr;
+	auto entry = findEntry(arch, filename, fileCRC);
+	if(!entry)
 	{
 		return nullptr;
 	}
-	auto closeZ = IG::scopeGuard([&](){ gn_unzip_fclose(z); });
-	unsigned int size = z->io.size();
+	// read straight into the returned buffer
+	unsigned int size = entry->size;
 	auto buff = (uint8_t*)malloc(size);
-	if(gn_unzip_fread(z, buff, size) != (int)size)
+	try
+	{
+		arch.read(*entry, {buff, size});
+	}
+	catch(std::exception &err)
 	{
-		logErr("read error in gn_unzip_file_malloc");
+		logErr("read error in gn_unzip_file_malloc:%s", err.what());
 		free(buff);
 		return nullptr;
 	}
@@ -1313,22 +1313,11 @@ static void Fixit1(void) {
 }
 
 void MMC5_hb(int);		//Ugh ugh ugh.
-static void DoLine(void) {
-	if (scanline >= 240 && scanline != totalscanlines) {
-		X6502_Run(256 + 69);
-		scanline++;
-		X6502_Run(16);
-		return;
-	}
+// set while the frame's video output isn't needed, only pixel output is skipped so timing stays accurate
+static bool skipRender;
 
+static void OutputLinePixels(uint8 *target) {
 	int x;
-	uint8 *target = XBuf + ((scanline < 240 ? scanline : 240) << 8);
-	//u8* dtarget = XDBuf + ((scanline < 240 ? scanline : 240) << 8);
-
-	if (MMC5Hack) MMC5_hb(scanline);
-
-	X6502_Run(256);
-	EndRL();
 
 	if (!renderbg) {// User asked to not display background data.
 		uint32 tem;
@@ -1367,6 +1356,28 @@ static void DoLine(void) {
 	//write the actual deemph
 	//for (x = 63; x >= 0; x--)
 	//	*(uint32*)&dtarget[x << 2] = ((PPU[1]>>5)<<0)|((PPU[1]>>5)<<8)|((PPU[1]>>5)<<16)|((PPU[1]>>5)<<24);
+}
+
+static void DoLine(void) {
+	if (scanline >= 240 && scanline != totalscanlines) {
+		X6502_Run(256 + 69);
+		scanline++;
+		X6502_Run(16);
+		return;
+	}
+
+	uint8 *target = XBuf + ((scanline < 240 ? scanline : 240) << 8);
+	//u8* dtarget = XDBuf + ((scanline < 240 ? scanline : 240) << 8);
+
+	if (MMC5Hack) MMC5_hb(scanline);
+
+	X6502_Run(256);
+	EndRL();
+
+	if (!skipRender)
+		OutputLinePixels(target);
+	else if (SpriteON)
+		spork = 0; // consume RefreshSprites() output without copying it, as in CopySprites()
 
 	sphitx = 0x100;
 
@@ -1776,6 +1787,7 @@ void emulateSound(EmuAudio *audio);
 }
 
 int FCEUPPU_Loop(EmuEx::EmuSystemTaskContext taskCtx, EmuEx::NesSystem &sys, EmuEx::EmuVideo *video, EmuEx::EmuAudio *audio, int skip) {
+	skipRender = taskCtx.skipRender;
 	if ((newppu) && (GameInfo->type != GIT_NSF)) {
 		int FCEUX_PPU_Loop(int skip);
 		return FCEUX_PPU_Loop(skip);
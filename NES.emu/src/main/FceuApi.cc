@@ -71,7 +71,7 @@ void FCEUI_Emulate(EmuEx::EmuSystemTaskContext taskCtx, EmuEx::NesSystem &sys, E
 
 void FCEUI_Emulate(EmuEx::NesSystem &sys, EmuEx::EmuVideo *video, int skip, EmuEx::EmuAudio *audio)
 {
-	FCEUI_Emulate({}, sys, video, skip, audio);
+	FCEUI_Emulate({.skipRender = !video}, sys, video, skip, audio);
 }
 
 FILE *FCEUD_UTF8fopen(const char *fn, const char *mode)
@@ -437,19 +437,19 @@ void NesSystem::renderVideo(EmuSystemTaskContext taskCtx, EmuVideo &video, uint8
 	assumeExpr(pix.size() == ppuPixRegion.size());
 	if(pix.format() == PIXEL_RGB565)
 	{
-		pix.writeTransformed([&](uint8 p){ return nativeCol.col16[p]; }, ppuPixRegion);
+		pix.writeIndexed(nativeCol.col16, ppuPixRegion);
 	}
 	else
 	{
 		assumeExpr(pix.format().bytesPerPixel() == 4);
-		pix.writeTransformed([&](uint8 p){ return nativeCol.col32[p]; }, ppuPixRegion);
+		pix.writeIndexed(nativeCol.col32, ppuPixRegion);
 	}
 	img.endFrame();
 }
 
 void NesSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio)
 {
-	bool skip = !video && !optionCompatibleFrameskip;
+	bool skip = taskCtx.skipRender && !optionCompatibleFrameskip;
 	FCEUI_Emulate(taskCtx, *this, video, skip, audio);
 }
 
@@ -38,6 +38,7 @@ namespace EmuEx
 {
 
 const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2011-2024\nRobert Broglia\nwww.explusalpha.com\n\nPortions (c) the\nMednafen Team\nmednafen.github.io";
+bool EmuSystem::handlesCompressedStates = true;
 bool EmuApp::needsGlobalInstance = true;
 
 EmuSystem::NameFilterFunc EmuSystem::defaultFsFilter =
@@ -70,7 +71,7 @@ FS::FileString NgpSystem::stateFilename(int slot, std::string_view name) const
 	return stateFilenameMDFN(*MDFNGameInfo, slot, name, 'a', noMD5InFilenames);
 }
 
-size_t NgpSystem::stateSize() { return stateSizeMDFN(); }
+size_t NgpSystem::stateSize() { return currStateSize; }
 void NgpSystem::readState(EmuApp &app, std::span<uint8_t> buff) { readStateMDFN(app, buff); }
 size_t NgpSystem::writeState(std::span<uint8_t> buff, SaveStateFlags flags) { return writeStateMDFN(buff, flags); }
 
@@ -106,6 +107,7 @@ void NgpSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegat
 	static constexpr size_t maxRomSize = 0x400000;
 	EmuEx::loadContent(*this, mdfnGameInfo, io, maxRomSize);
 	MDFN_IEN_NGP::SetPixelFormat(toMDFNSurface(mSurfacePix).format);
+	currStateSize = stateSizeMDFN();
 }
 
 bool NgpSystem::onVideoRenderFormatChange(EmuVideo &, IG::PixelFormat fmt)
@@ -129,7 +131,7 @@ void NgpSystem::configAudioRate(FrameTime outputFrameTime, int outputRate)
 void NgpSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio)
 {
 	static constexpr size_t maxAudioFrames = 48000 / minFrameRate;
-	EmuEx::runFrame(*this, mdfnGameInfo, taskCtx, video, mSurfacePix, audio, maxAudioFrames);
+	EmuEx::runFrameDirect(*this, mdfnGameInfo, taskCtx, video, mSurfacePix, audio, maxAudioFrames);
 }
 
 void EmuApp::onCustomizeNavView(EmuApp::NavView &view)
@@ -173,7 +175,8 @@ namespace Mednafen
 
 void MDFND_commitVideoFrame(EmulateSpecStruct *espec)
 {
-	espec->video->startFrameWithFormat(espec->taskCtx, static_cast<EmuEx::NgpSystem&>(*espec->sys).mSurfacePix);
+	auto &sys = static_cast<EmuEx::NgpSystem&>(*espec->sys);
+	espec->video->startFrameWithFormat(espec->taskCtx, EmuEx::toPixmapView(*espec->surface, sys.mSurfacePix.format()));
 }
 
 }
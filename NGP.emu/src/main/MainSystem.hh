@@ -33,6 +33,7 @@ class NgpSystem final: public EmuSystem
 {
 public:
 	Mednafen::MDFNGI mdfnGameInfo{EmulatedNGP};
+	size_t currStateSize{};
 	Property<bool, CFGKEY_NGPKEY_LANGUAGE, PropertyDesc<bool>{.defaultValue = true}> optionNGPLanguage;
 	uint8_t inputBuff{};
 	MutablePixmapView mSurfacePix{};
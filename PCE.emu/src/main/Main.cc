@@ -35,8 +35,9 @@ namespace EmuEx
 {
 
 const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2011-2024\nRobert Broglia\nwww.explusalpha.com\n\nPortions (c) the\nMednafen Team\nmednafen.github.io";
+bool EmuSystem::handlesCompressedStates = true;
 bool EmuSystem::hasRectangularPixels = true;
-bool EmuSystem::stateSizeChangesAtRuntime = true;
+bool EmuSystem::stateSizeChangesAtRuntime = false; // state layout is fixed once content & input devices are set in loadContent()
 constexpr double masterClockFrac = 21477272.727273 / 3.;
 constexpr auto pceFrameTimeWith262Lines{fromSeconds<FrameTime>(455. * 262. / masterClockFrac)}; // ~60.05Hz
 constexpr auto pceFrameTime{fromSeconds<FrameTime>(455. * 263. / masterClockFrac)}; //~59.82Hz
@@ -154,6 +155,7 @@ void PceSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegat
 	{
 		mdfnGameInfo.SetInput(i, "gamepad", (uint8*)&inputBuff[i]);
 	}
+	currStateSize = stateSizeMDFN(); // core & input devices affect state size
 	updatePixmap(mSurfacePix.format());
 }
 
@@ -210,7 +212,7 @@ void PceSystem::reset(EmuApp &, ResetMode mode)
 	mdfnGameInfo.DoSimpleCommand(MDFN_MSC_RESET);
 }
 
-size_t PceSystem::stateSize() { return stateSizeMDFN(); }
+size_t PceSystem::stateSize() { return currStateSize; }
 void PceSystem::readState(EmuApp &app, std::span<uint8_t> buff) { readStateMDFN(app, buff); }
 size_t PceSystem::writeState(std::span<uint8_t> buff, SaveStateFlags flags) { return writeStateMDFN(buff, flags); }
 
@@ -95,6 +95,7 @@ class PceSystem final: public EmuSystem
 {
 public:
 	Mednafen::MDFNGI mdfnGameInfo{EmulatedPCE_Fast};
+	size_t currStateSize{};
 	std::array<uint16, 5> inputBuff; // 5 gamepad buffers
 	static constexpr int maxFrameBuffWidth = 1365, maxFrameBuffHeight = 270;
 	alignas(8) uint32_t pixBuff[maxFrameBuffWidth * maxFrameBuffHeight];
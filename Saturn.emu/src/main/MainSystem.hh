@@ -33,6 +33,7 @@ namespace MDFN_IEN_SS
 {
 extern Mednafen::CDInterface* Cur_CDIF;
 extern IG::ThreadId RThreadId;
+int64 VDP2REND_GetThreadFrameTime();
 extern const int ActiveCartType;
 extern uint8 AreaCode;
 }
@@ -195,6 +196,7 @@ public:
 	bool onPointerInputEnd(const Input::MotionEvent &, Input::DragTrackerState, WRect);
 	Rotation contentRotation() const;
 	void addThreadGroupIds(std::vector<ThreadId> &ids) const { ids.emplace_back(MDFN_IEN_SS::RThreadId); }
+	FrameTime helperThreadFrameTime() const { return Nanoseconds{MDFN_IEN_SS::VDP2REND_GetThreadFrameTime()}; }
 };
 
 using MainSystem = SaturnSystem;
@@ -26,16 +26,14 @@
 
 #include "ss.h"
 #include <mednafen/mednafen.h>
-#include <mednafen/Time.h>
 #include <mednafen/MThreading.h>
 #include "vdp2_common.h"
 #include "vdp2_render.h"
 #include <imagine/thread/Thread.hh>
+#include <imagine/time/Time.hh>
 
 #include <atomic>
 
-#define VDP2_QUEUE_ATOMIC_WAIT
-
 namespace MDFN_IEN_SS
 {
 
@@ -3199,8 +3197,6 @@ enum
 
  COMMAND_SET_LEM,
 
- COMMAND_SET_BUSYWAIT,
-
  COMMAND_RESET,
  COMMAND_EXIT
 };
@@ -3216,20 +3212,21 @@ static std::array<WQ_Entry, 0x80000> WQ;
 static size_t WQ_ReadPos{}, WQ_WritePos{};
 static std::atomic_int_least32_t WQ_InCount{};
 static std::atomic_int_least32_t DrawCounter{};
-#ifndef VDP2_QUEUE_ATOMIC_WAIT
-static bool DoBusyWait;
-static MThreading::Sem* WakeupSem;
-static bool DoWakeupIfNecessary;
-#endif
+// Render thread time spent processing commands, in nanoseconds
+static std::atomic<int64> RThreadBusyTime{};
+static std::atomic<int64> RThreadFrameTime{};
 
-template<class T>
-static void atomicWait(const std::atomic<T> &val, T oldVal)
+//
+// The render thread blocks on WQ_InCount with std::atomic wait/notify (a futex on Linux/Android)
+// instead of polling, and the emulation thread only wakes it once a batch of lines is queued,
+// or for every line near the end of the frame so little work remains when VDP2REND_EndFrame() syncs.
+// notify_all() skips the syscall when nothing is waiting, so waking an already running thread is cheap.
+//
+static constexpr int32 LineBatchSize = 64;
+
+static INLINE void WakeRThread(void)
 {
- if(MDFN_UNLIKELY(val.load(std::memory_order_acquire) == oldVal))
- {
-  //fprintf(stderr, "waiting for change from:%d\n", oldVal);
-  val.wait(oldVal, std::memory_order_acquire);
- }
+ WQ_InCount.notify_all();
 }
 
 template<class T>
@@ -3237,19 +3234,20 @@ static void atomicWaitForValue(const std::atomic<T> &val, T wantedVal)
 {
  for(auto c = val.load(std::memory_order_acquire); c != wantedVal; c = val.load(std::memory_order_acquire))
  {
-  //fprintf(stderr, "waiting for value\n");
   val.wait(c, std::memory_order_acquire);
  }
 }
 
 static INLINE void WWQ(uint16 command, uint32 arg32 = 0, uint16 arg16 = 0)
 {
-#ifdef VDP2_QUEUE_ATOMIC_WAIT
- atomicWait(WQ_InCount, int(WQ.size()));
-#else
- while(MDFN_UNLIKELY(WQ_InCount.load(std::memory_order_acquire) == WQ.size()))
-  Time::SleepMS(1);
-#endif
+ if(MDFN_UNLIKELY(WQ_InCount.load(std::memory_order_acquire) == (int32)WQ.size()))
+ {
+  WakeRThread();
+  do
+  {
+   WQ_InCount.wait(WQ.size(), std::memory_order_acquire);
+  } while(WQ_InCount.load(std::memory_order_acquire) == (int32)WQ.size());
+ }
 
  WQ_Entry* wqe = &WQ[WQ_WritePos];
 
@@ -3265,33 +3263,25 @@ static int RThreadEntry(void* data)
 {
  bool Running = true;
  RThreadId = IG::thisThreadId();
+ auto BusyStart = IG::SteadyClock::now();
+ auto AddBusyTime = [&]()
+ {
+  auto Now = IG::SteadyClock::now();
+  RThreadBusyTime.fetch_add(std::chrono::duration_cast<IG::Nanoseconds>(Now - BusyStart).count(), std::memory_order_relaxed);
+  BusyStart = Now;
+ };
 
  while(MDFN_LIKELY(Running))
  {
-#ifdef VDP2_QUEUE_ATOMIC_WAIT
-	 atomicWait(WQ_InCount, 0);
-#else
-  while(MDFN_UNLIKELY(WQ_InCount.load(std::memory_order_acquire) == 0))
+  if(WQ_InCount.load(std::memory_order_acquire) == 0)
   {
-   if(!DoBusyWait)
-    MThreading::Sem_TimedWait(WakeupSem, 1);
-   else
+   AddBusyTime();
+   do
    {
-#ifdef MDFN_SS_BUSYWAIT_PAUSE
-    asm volatile("pause\n\tpause\n\tpause\n\tpause\n\tpause\n\tpause\n\tpause\n\t");
-#else
-    for(int i = 1000; i; i--)
-    {
-     #ifdef _MSC_VER
-     __nop();
-     #else
-     asm volatile("nop\n\t");
-     #endif
-    }
-#endif
-   }
+    WQ_InCount.wait(0, std::memory_order_acquire);
+   } while(WQ_InCount.load(std::memory_order_acquire) == 0);
+   BusyStart = IG::SteadyClock::now();
   }
-#endif
   //
   //
   //
@@ -3311,10 +3301,11 @@ static int RThreadEntry(void* data)
 	//for(unsigned i = 0; i < 2; i++)
 	DrawLine((uint16)wqe->Arg32, wqe->Arg32 >> 16, wqe->Arg16);
 	//
+	// account for the time before VDP2REND_EndFrame() can see the counter reach 0
+	if(DrawCounter.load(std::memory_order_relaxed) == 1)
+	 AddBusyTime();
 	DrawCounter.fetch_sub(1, std::memory_order_release);
-#ifdef VDP2_QUEUE_ATOMIC_WAIT
 	DrawCounter.notify_all();
-#endif
 	break;
 
    case COMMAND_RESET:
@@ -3325,12 +3316,6 @@ static int RThreadEntry(void* data)
 	UserLayerEnableMask = wqe->Arg32;
 	break;
 
-#ifndef VDP2_QUEUE_ATOMIC_WAIT
-   case COMMAND_SET_BUSYWAIT:
-	DoBusyWait = wqe->Arg32;
-	break;
-#endif
-
    case COMMAND_EXIT:
 	Running = false;
 	break;
@@ -3340,14 +3325,17 @@ static int RThreadEntry(void* data)
   //
   WQ_ReadPos = (WQ_ReadPos + 1) % WQ.size();
   WQ_InCount.fetch_sub(1, std::memory_order_release);
-#ifdef VDP2_QUEUE_ATOMIC_WAIT
   WQ_InCount.notify_all();
-#endif
  }
 
  return 0;
 }
 
+int64 VDP2REND_GetThreadFrameTime(void)
+{
+ return RThreadFrameTime.load(std::memory_order_relaxed);
+}
+
 
 //
 //
@@ -3366,10 +3354,9 @@ void VDP2REND_Init(const bool IsPAL, const uint64 affinity)
  WQ_WritePos = 0;
  WQ_InCount.store(0, std::memory_order_release); 
  DrawCounter.store(0, std::memory_order_release);
+ RThreadBusyTime.store(0, std::memory_order_relaxed);
+ RThreadFrameTime.store(0, std::memory_order_relaxed);
 
-#ifndef VDP2_QUEUE_ATOMIC_WAIT
- WakeupSem = MThreading::Sem_Create();
-#endif
  RThread = MThreading::Thread_Create(RThreadEntry, NULL, "MDFN VDP2 Render");
  if(affinity)
   MThreading::Thread_SetAffinity(RThread, affinity);
@@ -3437,21 +3424,11 @@ void VDP2REND_Kill(void)
  if(RThread != NULL)
  {
   WWQ(COMMAND_EXIT);
-#ifdef VDP2_QUEUE_ATOMIC_WAIT
-  WQ_InCount.notify_all();
-#endif
+  WakeRThread();
   MThreading::Thread_Wait(RThread, NULL);
   RThread = NULL;
   RThreadId = {};
  }
-
-#ifndef VDP2_QUEUE_ATOMIC_WAIT
- if(WakeupSem != NULL)
- {
-  MThreading::Sem_Destroy(WakeupSem);
-  WakeupSem = NULL;
- }
-#endif
 }
 
 void VDP2REND_StartFrame(EmulateSpecStruct* espec_arg, const bool clock28m, const int SurfInterlaceField)
@@ -3478,17 +3455,9 @@ void VDP2REND_StartFrame(EmulateSpecStruct* espec_arg, const bool clock28m, cons
 
 void VDP2REND_EndFrame(void)
 {
-#ifdef VDP2_QUEUE_ATOMIC_WAIT
+ WakeRThread();
  atomicWaitForValue(DrawCounter, 0);
-#else
- while(MDFN_UNLIKELY(DrawCounter.load(std::memory_order_acquire) != 0))
- {
-  //fprintf(stderr, "SLEEEEP\n");
-  //Time::SleepMS(1);
- }
-
- WWQ(COMMAND_SET_BUSYWAIT, false);
-#endif
+ RThreadFrameTime.store(RThreadBusyTime.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
 
  if(NextOutLine < VisibleLines)
  {
@@ -3534,33 +3503,8 @@ void VDP2REND_DrawLine(const int vdp2_line, const uint32 crt_line, const bool fi
   WWQ(COMMAND_DRAW_LINE, ((uint16)vdp2_line << 16) | out_line, field);
   //
   //
-#ifdef VDP2_QUEUE_ATOMIC_WAIT
-  if(crt_line >= bwthresh)
-  {
-   WQ_InCount.notify_all();
-  }
-  else if(crt_line < bwthresh && (wdcq + 1) >= 64)
-  {
-  	WQ_InCount.notify_all();
-  }
-#else
-  if(crt_line == bwthresh)
-  {
-   WWQ(COMMAND_SET_BUSYWAIT, true);
-   MThreading::Sem_Post(WakeupSem);
-  }
-  else if(crt_line < bwthresh)
-  {
-   if(wdcq == 0)
-    DoWakeupIfNecessary = true;
-   else if((wdcq + 1) >= 64 && DoWakeupIfNecessary)
-   {
-    //printf("Post Wakeup: %3d --- crt_line=%3d\n", wdcq + 1, crt_line);
-    MThreading::Sem_Post(WakeupSem);
-    DoWakeupIfNecessary = false;
-   }
-  }
-#endif
+  if(crt_line >= bwthresh || (wdcq + 1) >= LineBatchSize)
+   WakeRThread();
 
   NextOutLine = crt_line + 1;
  }
@@ -3594,13 +3538,8 @@ void VDP2REND_Write16_DB(uint32 A, uint16 DB)
 
 void VDP2REND_StateAction(StateMem* sm, const unsigned load, const bool data_only, uint16 (&rr)[0x100], uint16 (&cr)[2048], uint16 (&vr)[262144])
 {
-#ifdef VDP2_QUEUE_ATOMIC_WAIT
- WQ_InCount.notify_all();
+ WakeRThread();
  atomicWaitForValue(WQ_InCount, 0);
-#else
- while(MDFN_UNLIKELY(WQ_InCount.load(std::memory_order_acquire) != 0))
-  Time::SleepMS(1);
-#endif
  //
  //
  //
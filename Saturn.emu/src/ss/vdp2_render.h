@@ -33,6 +33,7 @@ void VDP2REND_StartFrame(EmulateSpecStruct* espec, const bool clock28m, const in
 void VDP2REND_EndFrame(void);
 void VDP2REND_Reset(bool powering_up) MDFN_COLD;
 void VDP2REND_SetLayerEnableMask(uint64 mask) MDFN_COLD;
+int64 VDP2REND_GetThreadFrameTime(void); // render thread busy time of the last frame in nanoseconds
 
 void VDP2REND_StateAction(StateMem* sm, const unsigned load, const bool data_only, uint16 (&rr)[0x100], uint16 (&cr)[2048], uint16 (&vr)[262144]) MDFN_COLD;
 
@@ -4,6 +4,7 @@
 #include <emuframework/DataPathSelectView.hh>
 #include <emuframework/UserPathSelectView.hh>
 #include <emuframework/SystemActionsView.hh>
+#include <emuframework/SystemOptionView.hh>
 #include <emuframework/viewUtils.hh>
 #include "EmuCheatViews.hh"
 #include "MainApp.hh"
@@ -58,6 +59,30 @@ public:
 		item.emplace_back(&dspInterpolation);
 	}
 };
+
+class CustomSystemOptionView : public SystemOptionView, public MainAppHelper<CustomSystemOptionView>
+{
+	using MainAppHelper<CustomSystemOptionView>::system;
+
+	BoolMenuItem renderThread
+	{
+		"Render Video On Separate Thread", attachParams(),
+		(bool)system().optionRenderThread,
+		[this](BoolMenuItem &item)
+		{
+			system().optionRenderThread = item.flipBoolValue(*this);
+			if(system().hasContent())
+				S9xSetRenderThread(system().optionRenderThread);
+		}
+	};
+
+public:
+	CustomSystemOptionView(ViewAttachParams attach): SystemOptionView{attach, true}
+	{
+		loadStockItems();
+		item.emplace_back(&renderThread);
+	}
+};
 #endif
 
 class ConsoleOptionView : public TableView, public MainAppHelper<ConsoleOptionView>
@@ -407,6 +432,7 @@ std::unique_ptr<View> EmuApp::makeCustomView(ViewAttachParams attach, ViewID id)
 	{
 		#ifndef SNES9X_VERSION_1_4
 		case ViewID::AUDIO_OPTIONS: return std::make_unique<CustomAudioOptionView>(attach, audio);
+		case ViewID::SYSTEM_OPTIONS: return std::make_unique<CustomSystemOptionView>(attach);
 		#endif
 		case ViewID::FILE_PATH_OPTIONS: return std::make_unique<CustomFilePathOptionView>(attach);
 		case ViewID::SYSTEM_ACTIONS: return std::make_unique<CustomSystemActionsView>(attach);
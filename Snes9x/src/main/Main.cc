@@ -38,6 +38,13 @@ constexpr auto srcPixFmt = IG::PIXEL_FMT_RGB565;
 #endif
 static EmuSystemTaskContext emuSysTask{};
 static EmuVideo *emuVideo{};
+#ifndef SNES9X_VERSION_1_4
+// size of the frame finished in S9xMainLoop(), presented after it returns so
+// the render thread can draw the last lines while the CPU finishes the scanline
+static WSize pendingFrameSize{};
+#endif
+
+static void presentFrame(int width, int height);
 constexpr auto SNES_HEIGHT_480i = SNES_HEIGHT * 2;
 constexpr auto SNES_HEIGHT_EXTENDED_480i = SNES_HEIGHT_EXTENDED * 2;
 bool EmuSystem::hasCheats = true;
@@ -89,7 +96,7 @@ MutablePixmapView Snes9xSystem::fbPixmapView(WSize size, bool useInterlaceFields
 void Snes9xSystem::renderFramebuffer(EmuVideo &video)
 {
 	emuSysTask = {};
-	S9xDeinitUpdate(IPPU.RenderedScreenWidth, IPPU.RenderedScreenHeight);
+	presentFrame(IPPU.RenderedScreenWidth, IPPU.RenderedScreenHeight);
 }
 
 void Snes9xSystem::reset(EmuApp &, ResetMode mode)
@@ -210,6 +217,16 @@ WallClockTimePoint Snes9xSystem::backupMemoryLastWriteTime(const EmuApp &app) co
 VideoSystem Snes9xSystem::videoSystem() const { return Settings.PAL ? VideoSystem::PAL : VideoSystem::NATIVE_NTSC; }
 WSize Snes9xSystem::multiresVideoBaseSize() const { return {256, 239}; }
 
+#ifndef SNES9X_VERSION_1_4
+void Snes9xSystem::addThreadGroupIds(std::vector<ThreadId> &ids) const
+{
+	if(auto id = S9xGetRenderThreadId())
+		ids.emplace_back(id);
+}
+
+FrameTime Snes9xSystem::helperThreadFrameTime() const { return S9xGetRenderThreadFrameTime(); }
+#endif
+
 static bool isSufamiTurboCart(const IOBuffer &buff)
 {
 	return buff.size() >= 0x80000 && buff.size() <= 0x100000 &&
@@ -306,6 +323,9 @@ void Snes9xSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDele
 	setupSNESInput(EmuApp::get(appContext()).defaultVController());
 	saveStateSize = S9xFreezeSize();
 	IPPU.RenderThisFrame = TRUE;
+	#ifndef SNES9X_VERSION_1_4
+	S9xSetRenderThread(optionRenderThread);
+	#endif
 }
 
 void Snes9xSystem::configAudioRate(FrameTime outputFrameTime, int outputRate)
@@ -373,7 +393,7 @@ void Snes9xSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAu
 	}
 	emuSysTask = taskCtx;
 	emuVideo = video;
-	IPPU.RenderThisFrame = video ? TRUE : FALSE;
+	IPPU.RenderThisFrame = taskCtx.skipRender ? FALSE : TRUE;
 	#ifndef SNES9X_VERSION_1_4
 	S9xSetSamplesAvailableCallback([](void *audio)
 		{
@@ -383,7 +403,14 @@ void Snes9xSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAu
 	#endif
 	S9xMainLoop();
 	// video rendered in S9xDeinitUpdate
-	#ifdef SNES9X_VERSION_1_4
+	#ifndef SNES9X_VERSION_1_4
+	if(pendingFrameSize.x)
+	{
+		S9xSyncRenderFrame();
+		auto size = std::exchange(pendingFrameSize, {});
+		presentFrame(size.x, size.y);
+	}
+	#else
 	auto samples = updateAudioFramesPerVideoFrame() * 2;
 	mixSamples(samples, audio);
 	#endif
@@ -401,11 +428,8 @@ void EmuApp::onCustomizeNavView(EmuApp::NavView &view)
 	view.setBackgroundGradient(navViewGrad);
 }
 
-}
-
-bool8 S9xDeinitUpdate (int width, int height)
+static void presentFrame(int width, int height)
 {
-	using namespace EmuEx;
 	auto &sys = gSnes9xSystem();
 	assumeExpr(emuVideo);
 	if((height == SNES_HEIGHT_EXTENDED || height == SNES_HEIGHT_EXTENDED_480i)
@@ -420,6 +444,18 @@ bool8 S9xDeinitUpdate (int width, int height)
 	memset(GFX.ZBuffer, 0, GFX.ScreenSize);
 	memset(GFX.SubZBuffer, 0, GFX.ScreenSize);
 	#endif
+}
+
+}
+
+bool8 S9xDeinitUpdate (int width, int height)
+{
+	using namespace EmuEx;
+	#ifndef SNES9X_VERSION_1_4
+	pendingFrameSize = {width, height};
+	#else
+	presentFrame(width, height);
+	#endif
 	return true;
 }
 
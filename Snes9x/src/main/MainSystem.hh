@@ -27,6 +27,7 @@ enum
 	CFGKEY_CHEATS_PATH = 284, CFGKEY_PATCHES_PATH = 285,
 	CFGKEY_SATELLAVIEW_PATH = 286, CFGKEY_SUFAMI_BIOS_PATH = 287,
 	CFGKEY_BSX_BIOS_PATH = 288, CFGKEY_DEINTERLACE_MODE = 289,
+	CFGKEY_RENDER_THREAD = 290,
 };
 
 #ifdef SNES9X_VERSION_1_4
@@ -86,6 +87,7 @@ public:
 		PropertyDesc<uint8_t>{.defaultValue = 100, .isValid = isValidWithMinMax<5, 250>}> optionSuperFXClockMultiplier;
 	Property<uint8_t, CFGKEY_AUDIO_DSP_INTERPOLATON,
 		PropertyDesc<uint8_t>{.defaultValue = DSP_INTERPOLATION_GAUSSIAN, .isValid = isValidWithMax<4>}> optionAudioDSPInterpolation;
+	Property<bool, CFGKEY_RENDER_THREAD> optionRenderThread;
 	#endif
 	static constexpr FloatSeconds ntscFrameTimeSecs{357366. / 21477272.}; // ~60.098Hz
 	static constexpr FloatSeconds palFrameTimeSecs{425568. / 21281370.}; // ~50.00Hz
@@ -150,6 +152,10 @@ public:
 	bool onPointerInputUpdate(const Input::MotionEvent &, Input::DragTrackerState,
 		Input::DragTrackerState prevDragState, IG::WindowRect gameRect);
 	bool onPointerInputEnd(const Input::MotionEvent &, Input::DragTrackerState, IG::WindowRect gameRect);
+	#ifndef SNES9X_VERSION_1_4
+	void addThreadGroupIds(std::vector<ThreadId> &) const;
+	FrameTime helperThreadFrameTime() const;
+	#endif
 
 protected:
 	void applyInputPortOption(int portVal, VController &vCtrl);
@@ -13,6 +13,7 @@
 #include "movie.h"
 #include "screenshot.h"
 #include "display.h"
+#include <imagine/thread/JobQueueThread.hh>
 
 extern struct SCheatData		Cheat;
 
@@ -34,11 +35,22 @@ static void DrawBackgroundOffsetMosaic (int, uint8, uint8, int);
 static inline void DrawBackgroundMode7 (int, void (*DrawMath) (uint32, uint32, int), void (*DrawNomath) (uint32, uint32, int), int);
 static inline void DrawBackdrop (void);
 static inline void RenderScreen (bool8);
+static void RenderLines (void);
 static uint16 get_crosshair_color (uint8);
 static void S9xDisplayStringType (const char *, int, int, bool, int);
 
 #define TILE_PLUS(t, x)	(((t) & 0xfc00) | ((t + x) & 0x3ff))
 
+// When enabled, each range of lines S9xUpdateScreen() draws is queued in order
+// with its own copy of RPPU. The thread owns GFX, BG, RPPU and the tile caches
+// until it's synced, which happens before anything else it reads is modified.
+static IG::JobQueueThread<struct SRenderPPU, 256> RenderThread;
+static IG::Nanoseconds	RenderThreadFrameTime;
+
+// Emulation thread copies of GFX.FixedColour & GFX.EndY
+static uint32	FixedColour;
+static uint32	LastEndY;
+
 
 bool8 S9xGraphicsInit (void)
 {
@@ -141,6 +153,7 @@ void S9xGraphicsScreenResize (void)
 
 void S9xBuildDirectColourMaps (void)
 {
+	S9xSyncRender();
 	IPPU.XB = mul_brightness[PPU.Brightness];
 
 	for (uint32 p = 0; p < 8; p++)
@@ -150,6 +163,8 @@ void S9xBuildDirectColourMaps (void)
 
 void S9xStartScreenRefresh (void)
 {
+	S9xSyncRender();
+
 	if (GFX.DoInterlace)
 		GFX.DoInterlace--;
 
@@ -187,6 +202,7 @@ void S9xEndScreenRefresh (void)
 {
 	if (IPPU.RenderThisFrame)
 	{
+		// the last lines can still be drawing, S9xSyncRenderFrame() must be called before presenting
 		FLUSH_REDRAW();
 
 		if (GFX.DoInterlace && S9xInterlaceField() == 0)
@@ -206,10 +222,16 @@ void S9xEndScreenRefresh (void)
 			S9xControlEOF();
 
 			if (Settings.TakeScreenshot)
+			{
+				S9xSyncRender();
 				S9xDoScreenshot(IPPU.RenderedScreenWidth, IPPU.RenderedScreenHeight);
+			}
 
 			if (Settings.AutoDisplayMessages)
+			{
+				S9xSyncRender();
 				S9xDisplayMessages(GFX.Screen, GFX.RealPPL, IPPU.RenderedScreenWidth, IPPU.RenderedScreenHeight, 1);
+			}
 
 			S9xDeinitUpdate(IPPU.RenderedScreenWidth, IPPU.RenderedScreenHeight);
 		}
@@ -290,62 +312,62 @@ static inline void RenderScreen (bool8 sub)
 		if (GFX.DoInterlace && S9xInterlaceField())
 			GFX.S += GFX.RealPPL;
 		GFX.DB = GFX.ZBuffer;
-		GFX.Clip = IPPU.Clip[0];
-		BGActive = Memory.FillRAM[0x212c] & ~Settings.BG_Forced;
+		GFX.Clip = RPPU.Clip[0];
+		BGActive = RPPU.Reg212c & ~Settings.BG_Forced;
 		D = 32;
 	}
 	else
 	{
 		GFX.S = GFX.SubScreen;
 		GFX.DB = GFX.SubZBuffer;
-		GFX.Clip = IPPU.Clip[1];
-		BGActive = Memory.FillRAM[0x212d] & ~Settings.BG_Forced;
-		D = (Memory.FillRAM[0x2130] & 2) << 4; // 'do math' depth flag
+		GFX.Clip = RPPU.Clip[1];
+		BGActive = RPPU.Reg212d & ~Settings.BG_Forced;
+		D = (RPPU.Reg2130 & 2) << 4; // 'do math' depth flag
 	}
 
 	if (BGActive & 0x10)
 	{
-		BG.TileAddress = PPU.OBJNameBase;
-		BG.NameSelect = PPU.OBJNameSelect;
-		BG.EnableMath = !sub && (Memory.FillRAM[0x2131] & 0x10);
+		BG.TileAddress = RPPU.OBJNameBase;
+		BG.NameSelect = RPPU.OBJNameSelect;
+		BG.EnableMath = !sub && (RPPU.Reg2131 & 0x10);
 		BG.StartPalette = 128;
 		S9xSelectTileConverter(4, FALSE, sub, FALSE);
-		S9xSelectTileRenderers(PPU.BGMode, sub, TRUE);
+		S9xSelectTileRenderers(RPPU.BGMode, sub, TRUE);
 		DrawOBJS(D + 4);
 	}
 
 	BG.NameSelect = 0;
-	S9xSelectTileRenderers(PPU.BGMode, sub, FALSE);
+	S9xSelectTileRenderers(RPPU.BGMode, sub, FALSE);
 
 	#define DO_BG(n, pal, depth, hires, offset, Zh, Zl, voffoff) \
 		if (BGActive & (1 << n)) \
 		{ \
 			BG.StartPalette = pal; \
-			BG.EnableMath = !sub && (Memory.FillRAM[0x2131] & (1 << n)); \
-			BG.TileSizeH = (!hires && PPU.BG[n].BGSize) ? 16 : 8; \
-			BG.TileSizeV = (PPU.BG[n].BGSize) ? 16 : 8; \
-			S9xSelectTileConverter(depth, hires, sub, PPU.BGMosaic[n]); \
+			BG.EnableMath = !sub && (RPPU.Reg2131 & (1 << n)); \
+			BG.TileSizeH = (!hires && RPPU.BG[n].BGSize) ? 16 : 8; \
+			BG.TileSizeV = (RPPU.BG[n].BGSize) ? 16 : 8; \
+			S9xSelectTileConverter(depth, hires, sub, RPPU.BGMosaic[n]); \
 			\
 			if (offset) \
 			{ \
-				BG.OffsetSizeH = (!hires && PPU.BG[2].BGSize) ? 16 : 8; \
-				BG.OffsetSizeV = (PPU.BG[2].BGSize) ? 16 : 8; \
+				BG.OffsetSizeH = (!hires && RPPU.BG[2].BGSize) ? 16 : 8; \
+				BG.OffsetSizeV = (RPPU.BG[2].BGSize) ? 16 : 8; \
 				\
-				if (PPU.BGMosaic[n] && (hires || PPU.Mosaic > 1)) \
+				if (RPPU.BGMosaic[n] && (hires || RPPU.Mosaic > 1)) \
 					DrawBackgroundOffsetMosaic(n, D + Zh, D + Zl, voffoff); \
 				else \
 					DrawBackgroundOffset(n, D + Zh, D + Zl, voffoff); \
 			} \
 			else \
 			{ \
-				if (PPU.BGMosaic[n] && (hires || PPU.Mosaic > 1)) \
+				if (RPPU.BGMosaic[n] && (hires || RPPU.Mosaic > 1)) \
 					DrawBackgroundMosaic(n, D + Zh, D + Zl); \
 				else \
 					DrawBackground(n, D + Zh, D + Zl); \
 			} \
 		}
 
-	switch (PPU.BGMode)
+	switch (RPPU.BGMode)
 	{
 		case 0:
 			DO_BG(0,  0, 2, FALSE, FALSE, 15, 11, 0);
@@ -357,7 +379,7 @@ static inline void RenderScreen (bool8 sub)
 		case 1:
 			DO_BG(0,  0, 4, FALSE, FALSE, 15, 11, 0);
 			DO_BG(1,  0, 4, FALSE, FALSE, 14, 10, 0);
-			DO_BG(2,  0, 2, FALSE, FALSE, (PPU.BG3Priority ? 17 : 7), 3, 0);
+			DO_BG(2,  0, 2, FALSE, FALSE, (RPPU.BG3Priority ? 17 : 7), 3, 0);
 			break;
 
 		case 2:
@@ -387,13 +409,13 @@ static inline void RenderScreen (bool8 sub)
 		case 7:
 			if (BGActive & 0x01)
 			{
-				BG.EnableMath = !sub && (Memory.FillRAM[0x2131] & 1);
+				BG.EnableMath = !sub && (RPPU.Reg2131 & 1);
 				DrawBackgroundMode7(0, GFX.DrawMode7BG1Math, GFX.DrawMode7BG1Nomath, D);
 			}
 
-			if ((Memory.FillRAM[0x2133] & 0x40) && (BGActive & 0x02))
+			if ((RPPU.Reg2133 & 0x40) && (BGActive & 0x02))
 			{
-				BG.EnableMath = !sub && (Memory.FillRAM[0x2131] & 2);
+				BG.EnableMath = !sub && (RPPU.Reg2131 & 2);
 				DrawBackgroundMode7(1, GFX.DrawMode7BG2Math, GFX.DrawMode7BG2Nomath, D);
 			}
 
@@ -402,22 +424,97 @@ static inline void RenderScreen (bool8 sub)
 
 	#undef DO_BG
 
-	BG.EnableMath = !sub && (Memory.FillRAM[0x2131] & 0x20);
+	BG.EnableMath = !sub && (RPPU.Reg2131 & 0x20);
 
 	DrawBackdrop();
 }
 
+static void CaptureRenderPPU (struct SRenderPPU &R, uint32 StartY, uint32 EndY)
+{
+	R.StartY = StartY;
+	R.EndY = EndY;
+	R.FixedColour = FixedColour;
+	R.ForcedBlanking = PPU.ForcedBlanking;
+
+	for (int i = 0; i < 4; i++)
+	{
+		R.BG[i].SCBase = PPU.BG[i].SCBase;
+		R.BG[i].BGSize = PPU.BG[i].BGSize;
+		R.BG[i].NameBase = PPU.BG[i].NameBase;
+		R.BG[i].SCSize = PPU.BG[i].SCSize;
+		R.BGMosaic[i] = PPU.BGMosaic[i];
+	}
+
+	R.BGMode = PPU.BGMode;
+	R.BG3Priority = PPU.BG3Priority;
+	R.OBJNameBase = PPU.OBJNameBase;
+	R.OBJNameSelect = PPU.OBJNameSelect;
+	R.Mode7HFlip = PPU.Mode7HFlip;
+	R.Mode7VFlip = PPU.Mode7VFlip;
+	R.Mode7Repeat = PPU.Mode7Repeat;
+	R.Mosaic = PPU.Mosaic;
+	R.MosaicStart = PPU.MosaicStart;
+
+	R.Interlace = IPPU.Interlace;
+	R.PseudoHires = IPPU.PseudoHires;
+	R.MaxBrightness = IPPU.MaxBrightness;
+	R.Reg212c = Memory.FillRAM[0x212c];
+	R.Reg212d = Memory.FillRAM[0x212d];
+	R.Reg2130 = Memory.FillRAM[0x2130];
+	R.Reg2131 = Memory.FillRAM[0x2131];
+	R.Reg2133 = Memory.FillRAM[0x2133];
+	memcpy(R.Clip, IPPU.Clip, sizeof(R.Clip));
+	memcpy(R.ScreenColors, IPPU.ScreenColors, sizeof(R.ScreenColors));
+}
+
+static void RenderLines (void)
+{
+	GFX.StartY = RPPU.StartY;
+	GFX.EndY = RPPU.EndY;
+
+	if (!RPPU.ForcedBlanking)
+	{
+		GFX.FixedColour = RPPU.FixedColour;
+
+		if (RPPU.BGMode == 5 || RPPU.BGMode == 6 || RPPU.PseudoHires ||
+			((RPPU.Reg2130 & 0x30) != 0x30 && (RPPU.Reg2130 & 2) && (RPPU.Reg2131 & 0x3f) && (RPPU.Reg212d & 0x1f)))
+			// If hires (Mode 5/6 or pseudo-hires) or math is to be done
+			// involving the subscreen, then we need to render the subscreen...
+			RenderScreen(TRUE);
+
+		RenderScreen(FALSE);
+	}
+	else
+	{
+		const uint16	black = BUILD_PIXEL(0, 0, 0);
+
+		GFX.S = GFX.Screen + GFX.StartY * GFX.PPL;
+		if (GFX.DoInterlace && S9xInterlaceField())
+			GFX.S += GFX.RealPPL;
+
+		for (uint32 l = GFX.StartY; l <= GFX.EndY; l++, GFX.S += GFX.PPL)
+			for (int x = 0; x < IPPU.RenderedScreenWidth; x++)
+				GFX.S[x] = black;
+	}
+}
+
 void S9xUpdateScreen (void)
 {
 	if (IPPU.OBJChanged || IPPU.InterlaceOBJ)
+	{
+		// DrawOBJS() reads the sprite tables
+		S9xSyncRender();
 		SetupOBJ();
+	}
 
 	// XXX: Check ForceBlank? Or anything else?
-	PPU.RangeTimeOver |= GFX.OBJLines[GFX.EndY].RTOFlags;
+	PPU.RangeTimeOver |= GFX.OBJLines[LastEndY].RTOFlags;
 
-	GFX.StartY = IPPU.PreviousLine;
-	if ((GFX.EndY = IPPU.CurrentLine - 1) >= PPU.ScreenHeight)
-		GFX.EndY = PPU.ScreenHeight - 1;
+	uint32	StartY = IPPU.PreviousLine;
+	uint32	EndY = IPPU.CurrentLine - 1;
+	if (EndY >= PPU.ScreenHeight)
+		EndY = PPU.ScreenHeight - 1;
+	LastEndY = EndY;
 
 	if (!PPU.ForcedBlanking)
 	{
@@ -432,8 +529,10 @@ void S9xUpdateScreen (void)
 
 		if (!IPPU.DoubleWidthPixels && (PPU.BGMode == 5 || PPU.BGMode == 6 || IPPU.PseudoHires))
 		{
+			S9xSyncRender();
+
 			// Have to back out of the regular speed hack
-			for (uint32 y = 0; y < GFX.StartY; y++)
+			for (uint32 y = 0; y < StartY; y++)
 			{
 				uint16	*p = GFX.Screen + y * GFX.PPL + 255;
 				uint16	*q = GFX.Screen + y * GFX.PPL + 510;
@@ -448,40 +547,77 @@ void S9xUpdateScreen (void)
 
 		if (!IPPU.DoubleHeightPixels && IPPU.Interlace && (PPU.BGMode == 5 || PPU.BGMode == 6))
 		{
+			S9xSyncRender();
+
 			IPPU.DoubleHeightPixels = TRUE;
 			IPPU.RenderedScreenHeight = PPU.ScreenHeight << 1;
 			GFX.PPL = GFX.RealPPL << 1;
 			GFX.DoInterlace = 2;
 
-			for (int32 y = (int32) GFX.StartY - 2; y >= 0; y--)
+			for (int32 y = (int32) StartY - 2; y >= 0; y--)
 				memmove(GFX.Screen + (y + 1) * GFX.PPL, GFX.Screen + y * GFX.RealPPL, GFX.PPL * sizeof(uint16));
 		}
 
 		if ((Memory.FillRAM[0x2130] & 0x30) != 0x30 && (Memory.FillRAM[0x2131] & 0x3f))
-			GFX.FixedColour = BUILD_PIXEL(IPPU.XB[PPU.FixedColourRed], IPPU.XB[PPU.FixedColourGreen], IPPU.XB[PPU.FixedColourBlue]);
-
-		if (PPU.BGMode == 5 || PPU.BGMode == 6 || IPPU.PseudoHires ||
-			((Memory.FillRAM[0x2130] & 0x30) != 0x30 && (Memory.FillRAM[0x2130] & 2) && (Memory.FillRAM[0x2131] & 0x3f) && (Memory.FillRAM[0x212d] & 0x1f)))
-			// If hires (Mode 5/6 or pseudo-hires) or math is to be done
-			// involving the subscreen, then we need to render the subscreen...
-			RenderScreen(TRUE);
+			FixedColour = BUILD_PIXEL(IPPU.XB[PPU.FixedColourRed], IPPU.XB[PPU.FixedColourGreen], IPPU.XB[PPU.FixedColourBlue]);
+	}
 
-		RenderScreen(FALSE);
+	if (RenderThread.isRunning())
+	{
+		struct SRenderPPU	R;
+		CaptureRenderPPU(R, StartY, EndY);
+		RenderThread.push(R);
 	}
 	else
 	{
-		const uint16	black = BUILD_PIXEL(0, 0, 0);
+		CaptureRenderPPU(RPPU, StartY, EndY);
+		RenderLines();
+	}
 
-		GFX.S = GFX.Screen + GFX.StartY * GFX.PPL;
-		if (GFX.DoInterlace && S9xInterlaceField())
-			GFX.S += GFX.RealPPL;
+	IPPU.PreviousLine = IPPU.CurrentLine;
+}
 
-		for (uint32 l = GFX.StartY; l <= GFX.EndY; l++, GFX.S += GFX.PPL)
-			for (int x = 0; x < IPPU.RenderedScreenWidth; x++)
-				GFX.S[x] = black;
+void S9xSetRenderThread (bool8 on)
+{
+	if (on == RenderThread.isRunning())
+		return;
+
+	if (on)
+	{
+		RenderThread.start([](const struct SRenderPPU &R)
+		{
+			RPPU = R;
+			RenderLines();
+		});
 	}
+	else
+		RenderThread.stop();
 
-	IPPU.PreviousLine = IPPU.CurrentLine;
+	RenderThreadFrameTime = {};
+}
+
+void S9xSyncRender (void)
+{
+	if (RenderThread.isRunning())
+		RenderThread.sync();
+}
+
+void S9xSyncRenderFrame (void)
+{
+	if (!RenderThread.isRunning())
+		return;
+	RenderThread.sync();
+	RenderThreadFrameTime = RenderThread.takeBusyTime();
+}
+
+IG::ThreadId S9xGetRenderThreadId (void)
+{
+	return RenderThread.threadId();
+}
+
+IG::Nanoseconds S9xGetRenderThreadFrameTime (void)
+{
+	return RenderThreadFrameTime;
 }
 
 static void SetupOBJ (void)
@@ -822,20 +958,20 @@ static void DrawOBJS (int D)
 
 static void DrawBackground (int bg, uint8 Zh, uint8 Zl)
 {
-	BG.TileAddress = PPU.BG[bg].NameBase << 1;
+	BG.TileAddress = RPPU.BG[bg].NameBase << 1;
 
 	uint32	Tile;
 	uint16	*SC0, *SC1, *SC2, *SC3;
 	auto &LineData = GFX.LineData;
 
-	SC0 = (uint16 *) &Memory.VRAM[PPU.BG[bg].SCBase << 1];
-	SC1 = (PPU.BG[bg].SCSize & 1) ? SC0 + 1024 : SC0;
+	SC0 = (uint16 *) &Memory.VRAM[RPPU.BG[bg].SCBase << 1];
+	SC1 = (RPPU.BG[bg].SCSize & 1) ? SC0 + 1024 : SC0;
 	if (SC1 >= (uint16 *) (Memory.VRAM + 0x10000))
 		SC1 -= 0x8000;
-	SC2 = (PPU.BG[bg].SCSize & 2) ? SC1 + 1024 : SC0;
+	SC2 = (RPPU.BG[bg].SCSize & 2) ? SC1 + 1024 : SC0;
 	if (SC2 >= (uint16 *) (Memory.VRAM + 0x10000))
 		SC2 -= 0x8000;
-	SC3 = (PPU.BG[bg].SCSize & 1) ? SC2 + 1024 : SC2;
+	SC3 = (RPPU.BG[bg].SCSize & 1) ? SC2 + 1024 : SC2;
 	if (SC3 >= (uint16 *) (Memory.VRAM + 0x10000))
 		SC3 -= 0x8000;
 
@@ -843,7 +979,7 @@ static void DrawBackground (int bg, uint8 Zh, uint8 Zl)
 	int		OffsetMask  = (BG.TileSizeH == 16) ? 0x3ff : 0x1ff;
 	int		OffsetShift = (BG.TileSizeV == 16) ? 4 : 3;
 	int		PixWidth = IPPU.DoubleWidthPixels ? 2 : 1;
-	bool8	HiresInterlace = IPPU.Interlace && IPPU.DoubleWidthPixels;
+	bool8	HiresInterlace = RPPU.Interlace && IPPU.DoubleWidthPixels;
 
 	void (*DrawTile) (uint32, uint32, uint32, uint32);
 	void (*DrawClippedTile) (uint32, uint32, uint32, uint32, uint32, uint32);
@@ -1040,20 +1176,20 @@ static void DrawBackground (int bg, uint8 Zh, uint8 Zl)
 
 static void DrawBackgroundMosaic (int bg, uint8 Zh, uint8 Zl)
 {
-	BG.TileAddress = PPU.BG[bg].NameBase << 1;
+	BG.TileAddress = RPPU.BG[bg].NameBase << 1;
 
 	uint32	Tile;
 	uint16	*SC0, *SC1, *SC2, *SC3;
 	auto &LineData = GFX.LineData;
 
-	SC0 = (uint16 *) &Memory.VRAM[PPU.BG[bg].SCBase << 1];
-	SC1 = (PPU.BG[bg].SCSize & 1) ? SC0 + 1024 : SC0;
+	SC0 = (uint16 *) &Memory.VRAM[RPPU.BG[bg].SCBase << 1];
+	SC1 = (RPPU.BG[bg].SCSize & 1) ? SC0 + 1024 : SC0;
 	if (SC1 >= (uint16 *) (Memory.VRAM + 0x10000))
 		SC1 -= 0x8000;
-	SC2 = (PPU.BG[bg].SCSize & 2) ? SC1 + 1024 : SC0;
+	SC2 = (RPPU.BG[bg].SCSize & 2) ? SC1 + 1024 : SC0;
 	if (SC2 >= (uint16 *) (Memory.VRAM + 0x10000))
 		SC2 -= 0x8000;
-	SC3 = (PPU.BG[bg].SCSize & 1) ? SC2 + 1024 : SC2;
+	SC3 = (RPPU.BG[bg].SCSize & 1) ? SC2 + 1024 : SC2;
 	if (SC3 >= (uint16 *) (Memory.VRAM + 0x10000))
 		SC3 -= 0x8000;
 
@@ -1061,11 +1197,11 @@ static void DrawBackgroundMosaic (int bg, uint8 Zh, uint8 Zl)
 	int	OffsetMask  = (BG.TileSizeH == 16) ? 0x3ff : 0x1ff;
 	int	OffsetShift = (BG.TileSizeV == 16) ? 4 : 3;
 	int	PixWidth = IPPU.DoubleWidthPixels ? 2 : 1;
-	bool8	HiresInterlace = IPPU.Interlace && IPPU.DoubleWidthPixels;
+	bool8	HiresInterlace = RPPU.Interlace && IPPU.DoubleWidthPixels;
 
 	void (*DrawPix) (uint32, uint32, uint32, uint32, uint32, uint32);
 
-	int	MosaicStart = ((uint32) GFX.StartY - PPU.MosaicStart) % PPU.Mosaic;
+	int	MosaicStart = ((uint32) GFX.StartY - RPPU.MosaicStart) % RPPU.Mosaic;
 
 	for (int clip = 0; clip < GFX.Clip[bg].Count; clip++)
 	{
@@ -1076,13 +1212,13 @@ static void DrawBackgroundMosaic (int bg, uint8 Zh, uint8 Zl)
 		else
 			DrawPix = GFX.DrawMosaicPixelNomath;
 
-		for (uint32 Y = GFX.StartY - MosaicStart; Y <= GFX.EndY; Y += PPU.Mosaic)
+		for (uint32 Y = GFX.StartY - MosaicStart; Y <= GFX.EndY; Y += RPPU.Mosaic)
 		{
 			uint32	Y2 = HiresInterlace ? Y * 2 : Y;
 			uint32	VOffset = LineData[Y + MosaicStart].BG[bg].VOffset + (HiresInterlace ? 1 : 0);
 			uint32	HOffset = LineData[Y + MosaicStart].BG[bg].HOffset;
 
-			Lines = PPU.Mosaic - MosaicStart;
+			Lines = RPPU.Mosaic - MosaicStart;
 			if (Y + MosaicStart + Lines > GFX.EndY)
 				Lines = GFX.EndY - Y - MosaicStart + 1;
 
@@ -1122,7 +1258,7 @@ static void DrawBackgroundMosaic (int bg, uint8 Zh, uint8 Zl)
 			uint32	Left   = GFX.Clip[bg].Left[clip];
 			uint32	Right  = GFX.Clip[bg].Right[clip];
 			uint32	Offset = Left * PixWidth + (Y + MosaicStart) * GFX.PPL;
-			uint32	HPos   = (HOffset + Left - (Left % PPU.Mosaic)) & OffsetMask;
+			uint32	HPos   = (HOffset + Left - (Left % RPPU.Mosaic)) & OffsetMask;
 			uint32	HTile  = HPos >> 3;
 			uint16	*t;
 
@@ -1147,7 +1283,7 @@ static void DrawBackgroundMosaic (int bg, uint8 Zh, uint8 Zl)
 
 			while (Left < Right)
 			{
-				uint32	w = PPU.Mosaic - (Left % PPU.Mosaic);
+				uint32	w = RPPU.Mosaic - (Left % RPPU.Mosaic);
 				if (w > Width)
 					w = Width;
 
@@ -1167,7 +1303,7 @@ static void DrawBackgroundMosaic (int bg, uint8 Zh, uint8 Zl)
 						DrawPix(TILE_PLUS(Tile, 1 - (HTile & 1)), Offset, VirtAlign, HPos & 7, w, Lines);
 				}
 
-				HPos += PPU.Mosaic;
+				HPos += RPPU.Mosaic;
 
 				while (HPos >= 8)
 				{
@@ -1207,32 +1343,32 @@ static void DrawBackgroundMosaic (int bg, uint8 Zh, uint8 Zl)
 
 static void DrawBackgroundOffset (int bg, uint8 Zh, uint8 Zl, int VOffOff)
 {
-	BG.TileAddress = PPU.BG[bg].NameBase << 1;
+	BG.TileAddress = RPPU.BG[bg].NameBase << 1;
 
 	uint32	Tile;
 	uint16	*SC0, *SC1, *SC2, *SC3;
 	uint16	*BPS0, *BPS1, *BPS2, *BPS3;
 	auto &LineData = GFX.LineData;
 
-	BPS0 = (uint16 *) &Memory.VRAM[PPU.BG[2].SCBase << 1];
-	BPS1 = (PPU.BG[2].SCSize & 1) ? BPS0 + 1024 : BPS0;
+	BPS0 = (uint16 *) &Memory.VRAM[RPPU.BG[2].SCBase << 1];
+	BPS1 = (RPPU.BG[2].SCSize & 1) ? BPS0 + 1024 : BPS0;
 	if (BPS1 >= (uint16 *) (Memory.VRAM + 0x10000))
 		BPS1 -= 0x8000;
-	BPS2 = (PPU.BG[2].SCSize & 2) ? BPS1 + 1024 : BPS0;
+	BPS2 = (RPPU.BG[2].SCSize & 2) ? BPS1 + 1024 : BPS0;
 	if (BPS2 >= (uint16 *) (Memory.VRAM + 0x10000))
 		BPS2 -= 0x8000;
-	BPS3 = (PPU.BG[2].SCSize & 1) ? BPS2 + 1024 : BPS2;
+	BPS3 = (RPPU.BG[2].SCSize & 1) ? BPS2 + 1024 : BPS2;
 	if (BPS3 >= (uint16 *) (Memory.VRAM + 0x10000))
 		BPS3 -= 0x8000;
 
-	SC0 = (uint16 *) &Memory.VRAM[PPU.BG[bg].SCBase << 1];
-	SC1 = (PPU.BG[bg].SCSize & 1) ? SC0 + 1024 : SC0;
+	SC0 = (uint16 *) &Memory.VRAM[RPPU.BG[bg].SCBase << 1];
+	SC1 = (RPPU.BG[bg].SCSize & 1) ? SC0 + 1024 : SC0;
 	if (SC1 >= (uint16 *) (Memory.VRAM + 0x10000))
 		SC1 -= 0x8000;
-	SC2 = (PPU.BG[bg].SCSize & 2) ? SC1 + 1024 : SC0;
+	SC2 = (RPPU.BG[bg].SCSize & 2) ? SC1 + 1024 : SC0;
 	if (SC2 >= (uint16 *) (Memory.VRAM + 0x10000))
 		SC2 -= 0x8000;
-	SC3 = (PPU.BG[bg].SCSize & 1) ? SC2 + 1024 : SC2;
+	SC3 = (RPPU.BG[bg].SCSize & 1) ? SC2 + 1024 : SC2;
 	if (SC3 >= (uint16 *) (Memory.VRAM + 0x10000))
 		SC3 -= 0x8000;
 
@@ -1242,7 +1378,7 @@ static void DrawBackgroundOffset (int bg, uint8 Zh, uint8 Zl, int VOffOff)
 	int	Offset2Shift = (BG.OffsetSizeV == 16) ? 4 : 3;
 	int	OffsetEnableMask = 0x2000 << bg;
 	int	PixWidth = IPPU.DoubleWidthPixels ? 2 : 1;
-	bool8	HiresInterlace = IPPU.Interlace && IPPU.DoubleWidthPixels;
+	bool8	HiresInterlace = RPPU.Interlace && IPPU.DoubleWidthPixels;
 
 	void (*DrawClippedTile) (uint32, uint32, uint32, uint32, uint32, uint32);
 
@@ -1436,32 +1572,32 @@ static void DrawBackgroundOffset (int bg, uint8 Zh, uint8 Zl, int VOffOff)
 
 static void DrawBackgroundOffsetMosaic (int bg, uint8 Zh, uint8 Zl, int VOffOff)
 {
-	BG.TileAddress = PPU.BG[bg].NameBase << 1;
+	BG.TileAddress = RPPU.BG[bg].NameBase << 1;
 
 	uint32	Tile;
 	uint16	*SC0, *SC1, *SC2, *SC3;
 	uint16	*BPS0, *BPS1, *BPS2, *BPS3;
 	auto &LineData = GFX.LineData;
 
-	BPS0 = (uint16 *) &Memory.VRAM[PPU.BG[2].SCBase << 1];
-	BPS1 = (PPU.BG[2].SCSize & 1) ? BPS0 + 1024 : BPS0;
+	BPS0 = (uint16 *) &Memory.VRAM[RPPU.BG[2].SCBase << 1];
+	BPS1 = (RPPU.BG[2].SCSize & 1) ? BPS0 + 1024 : BPS0;
 	if (BPS1 >= (uint16 *) (Memory.VRAM + 0x10000))
 		BPS1 -= 0x8000;
-	BPS2 = (PPU.BG[2].SCSize & 2) ? BPS1 + 1024 : BPS0;
+	BPS2 = (RPPU.BG[2].SCSize & 2) ? BPS1 + 1024 : BPS0;
 	if (BPS2 >= (uint16 *) (Memory.VRAM + 0x10000))
 		BPS2 -= 0x8000;
-	BPS3 = (PPU.BG[2].SCSize & 1) ? BPS2 + 1024 : BPS2;
+	BPS3 = (RPPU.BG[2].SCSize & 1) ? BPS2 + 1024 : BPS2;
 	if (BPS3 >= (uint16 *) (Memory.VRAM + 0x10000))
 		BPS3 -= 0x8000;
 
-	SC0 = (uint16 *) &Memory.VRAM[PPU.BG[bg].SCBase << 1];
-	SC1 = (PPU.BG[bg].SCSize & 1) ? SC0 + 1024 : SC0;
+	SC0 = (uint16 *) &Memory.VRAM[RPPU.BG[bg].SCBase << 1];
+	SC1 = (RPPU.BG[bg].SCSize & 1) ? SC0 + 1024 : SC0;
 	if (SC1 >= (uint16 *) (Memory.VRAM + 0x10000))
 		SC1 -= 0x8000;
-	SC2 = (PPU.BG[bg].SCSize & 2) ? SC1 + 1024 : SC0;
+	SC2 = (RPPU.BG[bg].SCSize & 2) ? SC1 + 1024 : SC0;
 	if (SC2 >= (uint16 *) (Memory.VRAM + 0x10000))
 		SC2 -= 0x8000;
-	SC3 = (PPU.BG[bg].SCSize & 1) ? SC2 + 1024 : SC2;
+	SC3 = (RPPU.BG[bg].SCSize & 1) ? SC2 + 1024 : SC2;
 	if (SC3 >= (uint16 *) (Memory.VRAM + 0x10000))
 		SC3 -= 0x8000;
 
@@ -1471,11 +1607,11 @@ static void DrawBackgroundOffsetMosaic (int bg, uint8 Zh, uint8 Zl, int VOffOff)
 	int	Offset2Shift = (BG.OffsetSizeV == 16) ? 4 : 3;
 	int	OffsetEnableMask = 0x2000 << bg;
 	int	PixWidth = IPPU.DoubleWidthPixels ? 2 : 1;
-	bool8	HiresInterlace = IPPU.Interlace && IPPU.DoubleWidthPixels;
+	bool8	HiresInterlace = RPPU.Interlace && IPPU.DoubleWidthPixels;
 
 	void (*DrawPix) (uint32, uint32, uint32, uint32, uint32, uint32);
 
-	int	MosaicStart = ((uint32) GFX.StartY - PPU.MosaicStart) % PPU.Mosaic;
+	int	MosaicStart = ((uint32) GFX.StartY - RPPU.MosaicStart) % RPPU.Mosaic;
 
 	for (int clip = 0; clip < GFX.Clip[bg].Count; clip++)
 	{
@@ -1486,13 +1622,13 @@ static void DrawBackgroundOffsetMosaic (int bg, uint8 Zh, uint8 Zl, int VOffOff)
 		else
 			DrawPix = GFX.DrawMosaicPixelNomath;
 
-		for (uint32 Y = GFX.StartY - MosaicStart; Y <= GFX.EndY; Y += PPU.Mosaic)
+		for (uint32 Y = GFX.StartY - MosaicStart; Y <= GFX.EndY; Y += RPPU.Mosaic)
 		{
 			uint32	Y2 = HiresInterlace ? Y * 2 : Y;
 			uint32	VOff = LineData[Y + MosaicStart].BG[2].VOffset - 1;
 			uint32	HOff = LineData[Y + MosaicStart].BG[2].HOffset;
 
-			Lines = PPU.Mosaic - MosaicStart;
+			Lines = RPPU.Mosaic - MosaicStart;
 			if (Y + MosaicStart + Lines > GFX.EndY)
 				Lines = GFX.EndY - Y - MosaicStart + 1;
 
@@ -1613,7 +1749,7 @@ static void DrawBackgroundOffsetMosaic (int bg, uint8 Zh, uint8 Zl, int VOffOff)
 				b1 += (TilemapRow & 0x1f) << 5;
 				b2 += (TilemapRow & 0x1f) << 5;
 
-				uint32	HPos = (HOffset + Left - (Left % PPU.Mosaic)) & OffsetMask;
+				uint32	HPos = (HOffset + Left - (Left % RPPU.Mosaic)) & OffsetMask;
 				uint32	HTile = HPos >> 3;
 				uint16	*t;
 
@@ -1632,7 +1768,7 @@ static void DrawBackgroundOffsetMosaic (int bg, uint8 Zh, uint8 Zl, int VOffOff)
 						t = b1 + (HTile >> 1);
 				}
 
-				uint32	w = PPU.Mosaic - (Left % PPU.Mosaic);
+				uint32	w = RPPU.Mosaic - (Left % RPPU.Mosaic);
 				if (w > Width)
 					w = Width;
 
@@ -8,6 +8,8 @@
 #define _GFX_H_
 
 #include "port.h"
+#include <imagine/thread/Thread.hh>
+#include <imagine/time/Time.hh>
 #include <vector>
 
 struct SLineData
@@ -211,6 +213,13 @@ void S9xDisplayChar (uint16 *, uint8);
 void S9xGraphicsScreenResize (void);
 // called automatically unless Settings.AutoDisplayMessages is false
 void S9xDisplayMessages (uint16 *, int, int, int, int);
+// draw lines on a separate thread, S9xSyncRender() waits for it before modifying state it reads
+void S9xSetRenderThread (bool8);
+void S9xSyncRender (void);
+// waits for the lines of the frame finished by S9xEndScreenRefresh(), called by the port before presenting it
+void S9xSyncRenderFrame (void);
+IG::ThreadId S9xGetRenderThreadId (void);
+IG::Nanoseconds S9xGetRenderThreadFrameTime (void);
 
 // external port interface which must be implemented or initialised for each port
 bool8 S9xGraphicsInit (void);
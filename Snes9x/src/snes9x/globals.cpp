@@ -25,6 +25,7 @@ struct SICPU			ICPU;
 struct SRegisters		Registers;
 struct SPPU				PPU;
 struct InternalPPU		IPPU;
+struct SRenderPPU		RPPU;
 struct SDMA				DMA[8];
 struct STimings			Timings;
 struct SGFX				GFX;
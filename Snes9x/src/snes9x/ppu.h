@@ -197,6 +197,46 @@ struct SPPU
 	uint16	VRAMReadBuffer;
 };
 
+// Registers the renderer reads, copied from PPU/IPPU each time a range of lines
+// is drawn so the drawing can run on a separate thread (see S9xSetRenderThread)
+struct SRenderPPU
+{
+	uint32	StartY;
+	uint32	EndY;
+	uint32	FixedColour;
+	bool8	ForcedBlanking;
+
+	struct
+	{
+		uint16	SCBase;
+		uint8	BGSize;
+		uint16	NameBase;
+		uint16	SCSize;
+	}	BG[4];
+
+	uint8	BGMode;
+	uint8	BG3Priority;
+	uint16	OBJNameBase;
+	uint16	OBJNameSelect;
+	bool8	Mode7HFlip;
+	bool8	Mode7VFlip;
+	uint8	Mode7Repeat;
+	uint8	Mosaic;
+	uint8	MosaicStart;
+	bool8	BGMosaic[4];
+
+	bool8	Interlace;
+	bool8	PseudoHires;
+	uint8	MaxBrightness;
+	uint8	Reg212c;
+	uint8	Reg212d;
+	uint8	Reg2130;
+	uint8	Reg2131;
+	uint8	Reg2133;
+	struct ClipData Clip[2][6];
+	uint16	ScreenColors[256];
+};
+
 constexpr uint16 SignExtend[2]
 {
 	0x0000,
@@ -204,6 +244,7 @@ constexpr uint16 SignExtend[2]
 };
 extern struct SPPU			PPU;
 extern struct InternalPPU	IPPU;
+extern struct SRenderPPU	RPPU;
 
 void S9xResetPPU (void);
 void S9xResetPPUFast (void);
@@ -268,6 +309,7 @@ static inline void REGISTER_2104 (uint8 Byte)
 		if (Byte != PPU.OAMData[addr])
 		{
 			FLUSH_REDRAW();
+			S9xSyncRender();
 			PPU.OAMData[addr] = Byte;
 			IPPU.OBJChanged = TRUE;
 
@@ -295,6 +337,7 @@ static inline void REGISTER_2104 (uint8 Byte)
 		if (lowbyte != PPU.OAMData[addr] || highbyte != PPU.OAMData[addr + 1])
 		{
 			FLUSH_REDRAW();
+			S9xSyncRender();
 			PPU.OAMData[addr] = lowbyte;
 			PPU.OAMData[addr + 1] = highbyte;
 			IPPU.OBJChanged = TRUE;
@@ -369,6 +412,8 @@ static inline void REGISTER_2118 (uint8 Byte)
 	if(CHECK_INBLANK1(PPU, CPU))
 		return;
 
+	S9xSyncRender();
+
 	uint32	address;
 
 	if (PPU.VMA.FullGraphicCount)
@@ -407,6 +452,8 @@ static inline void REGISTER_2118_tile (uint8 Byte)
 	if(CHECK_INBLANK1(PPU, CPU))
 		return;
 
+	S9xSyncRender();
+
 	uint32 rem = PPU.VMA.Address & PPU.VMA.Mask1;
 	uint32 address = (((PPU.VMA.Address & ~PPU.VMA.Mask1) + (rem >> PPU.VMA.Shift) + ((rem & (PPU.VMA.FullGraphicCount - 1)) << 3)) << 1) & 0xffff;
 
@@ -433,6 +480,8 @@ static inline void REGISTER_2118_linear (uint8 Byte)
 	if(CHECK_INBLANK1(PPU, CPU))
 		return;
 
+	S9xSyncRender();
+
 	uint32	address;
 
 	Memory.VRAM[address = (PPU.VMA.Address << 1) & 0xffff] = Byte;
@@ -484,6 +533,9 @@ static inline void REGISTER_2119 (uint8 Byte)
 {
 	if(CHECK_INBLANK2(PPU, CPU))
 		return;
+
+	S9xSyncRender();
+
 	uint32	address;
 
 	if (PPU.VMA.FullGraphicCount)
@@ -522,6 +574,8 @@ static inline void REGISTER_2119_tile (uint8 Byte)
 	if(CHECK_INBLANK2(PPU, CPU))
 		return;
 
+	S9xSyncRender();
+
 	uint32 rem = PPU.VMA.Address & PPU.VMA.Mask1;
 	uint32 address = ((((PPU.VMA.Address & ~PPU.VMA.Mask1) + (rem >> PPU.VMA.Shift) + ((rem & (PPU.VMA.FullGraphicCount - 1)) << 3)) << 1) + 1) & 0xffff;
 
@@ -548,6 +602,8 @@ static inline void REGISTER_2119_linear (uint8 Byte)
 	if(CHECK_INBLANK2(PPU, CPU))
 		return;
 
+	S9xSyncRender();
+
 	uint32	address;
 
 	Memory.VRAM[address = ((PPU.VMA.Address << 1) + 1) & 0xffff] = Byte;
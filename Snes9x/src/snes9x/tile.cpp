@@ -340,11 +340,11 @@ void S9xSelectTileRenderers (int BGMode, bool8 sub, bool8 obj)
 	void	(**DM7BG2)	(uint32, uint32, int);
 	bool8	M7M1, M7M2;
 
-	M7M1 = PPU.BGMosaic[0] && PPU.Mosaic > 1;
-	M7M2 = PPU.BGMosaic[1] && PPU.Mosaic > 1;
+	M7M1 = RPPU.BGMosaic[0] && RPPU.Mosaic > 1;
+	M7M2 = RPPU.BGMosaic[1] && RPPU.Mosaic > 1;
 
-	bool8 interlace = obj ? FALSE : IPPU.Interlace;
-	bool8 hires = !sub && (BGMode == 5 || BGMode == 6 || IPPU.PseudoHires);
+	bool8 interlace = obj ? FALSE : RPPU.Interlace;
+	bool8 hires = !sub && (BGMode == 5 || BGMode == 6 || RPPU.PseudoHires);
 
 	if (!IPPU.DoubleWidthPixels)	// normal width
 	{
@@ -416,14 +416,14 @@ void S9xSelectTileRenderers (int BGMode, bool8 sub, bool8 obj)
 		i = 0;
 	else
 	{
-		i = (Memory.FillRAM[0x2131] & 0x80) ? 4 : 1;
-		if (Memory.FillRAM[0x2131] & 0x40)
+		i = (RPPU.Reg2131 & 0x80) ? 4 : 1;
+		if (RPPU.Reg2131 & 0x40)
 		{
 			i++;
-			if (Memory.FillRAM[0x2130] & 2)
+			if (RPPU.Reg2130 & 2)
 				i++;
 		}
-		if (IPPU.MaxBrightness != 0xf)
+		if (RPPU.MaxBrightness != 0xf)
 		{
 			if (i == 1)
 				i = 7;
@@ -452,7 +452,7 @@ void S9xSelectTileConverter (int depth, bool8 hires, bool8 sub, bool8 mosaic)
 			BG.TileShift        = 6;
 			BG.PaletteShift     = 0;
 			BG.PaletteMask      = 0;
-			BG.DirectColourMode = Memory.FillRAM[0x2130] & 1;
+			BG.DirectColourMode = RPPU.Reg2130 & 1;
 
 			break;
 
@@ -123,7 +123,7 @@ namespace TileImpl {
 				GFX.RealScreenColors = DirectColourMaps[(Tile >> 10) & 7];
 			}
 			else
-				GFX.RealScreenColors = &IPPU.ScreenColors[((Tile >> BG.PaletteShift) & BG.PaletteMask) + BG.StartPalette];
+				GFX.RealScreenColors = &RPPU.ScreenColors[((Tile >> BG.PaletteShift) & BG.PaletteMask) + BG.StartPalette];
 			GFX.ScreenColors = GFX.ClipColors ? BlackColourMap : GFX.RealScreenColors;
 		}
 
@@ -480,7 +480,7 @@ namespace TileImpl {
 		{
 			uint32	l, x;
 
-			GFX.RealScreenColors = IPPU.ScreenColors;
+			GFX.RealScreenColors = RPPU.ScreenColors;
 			GFX.ScreenColors = GFX.ClipColors ? BlackColourMap : GFX.RealScreenColors;
 			if (Settings.ForcedBackdrop)
 					GFX.ScreenColors = &Settings.ForcedBackdrop;
@@ -519,7 +519,7 @@ namespace TileImpl {
 		};
 		static uint8 Z1(int D, uint8 b) { return D + 7; }
 		static uint8 Z2(int D, uint8 b) { return D + 7; }
-		static uint8 DCMODE() { return Memory.FillRAM[0x2130] & 1; }
+		static uint8 DCMODE() { return RPPU.Reg2130 & 1; }
 	};
 	struct DrawMode7BG2_OP
 	{
@@ -546,7 +546,7 @@ namespace TileImpl {
 				GFX.RealScreenColors = DirectColourMaps[0];
 			}
 			else
-				GFX.RealScreenColors = IPPU.ScreenColors;
+				GFX.RealScreenColors = RPPU.ScreenColors;
 
 			GFX.ScreenColors = GFX.ClipColors ? BlackColourMap : GFX.RealScreenColors;
 
@@ -567,7 +567,7 @@ namespace TileImpl {
 				int32	CentreX = ((int32) l->CentreX << 19) >> 19;
 				int32	CentreY = ((int32) l->CentreY << 19) >> 19;
 
-				if (PPU.Mode7VFlip)
+				if (RPPU.Mode7VFlip)
 					starty = 255 - (int) (Line + 1);
 				else
 					starty = Line + 1;
@@ -577,7 +577,7 @@ namespace TileImpl {
 				int	BB = ((l->MatrixB * starty) & ~63) + ((l->MatrixB * yy) & ~63) + (CentreX << 8);
 				int	DD = ((l->MatrixD * starty) & ~63) + ((l->MatrixD * yy) & ~63) + (CentreY << 8);
 
-				if (PPU.Mode7HFlip)
+				if (RPPU.Mode7HFlip)
 				{
 					startx = Right - 1;
 					aa = -l->MatrixA;
@@ -596,7 +596,7 @@ namespace TileImpl {
 
 				uint8	Pix;
 
-				if (!PPU.Mode7Repeat)
+				if (!RPPU.Mode7Repeat)
 				{
 					for (uint32 x = Left; x < Right; x++, AA += aa, CC += cc)
 					{
@@ -624,7 +624,7 @@ namespace TileImpl {
 							b = *(TileData + ((Y & 7) << 4) + ((X & 7) << 1));
 						}
 						else
-						if (PPU.Mode7Repeat == 3)
+						if (RPPU.Mode7Repeat == 3)
 							b = *(VRAM1    + ((Y & 7) << 4) + ((X & 7) << 1));
 						else
 							continue;
@@ -655,7 +655,7 @@ namespace TileImpl {
 				GFX.RealScreenColors = DirectColourMaps[0];
 			}
 			else
-				GFX.RealScreenColors = IPPU.ScreenColors;
+				GFX.RealScreenColors = RPPU.ScreenColors;
 
 			GFX.ScreenColors = GFX.ClipColors ? BlackColourMap : GFX.RealScreenColors;
 
@@ -665,16 +665,16 @@ namespace TileImpl {
 			int		HMosaic = 1, VMosaic = 1, MosaicStart = 0;
 			int32	MLeft = Left, MRight = Right;
 
-			if (PPU.BGMosaic[0])
+			if (RPPU.BGMosaic[0])
 			{
-				VMosaic = PPU.Mosaic;
-				MosaicStart = ((uint32) GFX.StartY - PPU.MosaicStart) % VMosaic;
+				VMosaic = RPPU.Mosaic;
+				MosaicStart = ((uint32) GFX.StartY - RPPU.MosaicStart) % VMosaic;
 				StartY -= MosaicStart;
 			}
 
-			if (PPU.BGMosaic[OP::BG])
+			if (RPPU.BGMosaic[OP::BG])
 			{
-				HMosaic = PPU.Mosaic;
+				HMosaic = RPPU.Mosaic;
 				MLeft  -= MLeft  % HMosaic;
 				MRight += HMosaic - 1;
 				MRight -= MRight % HMosaic;
@@ -697,7 +697,7 @@ namespace TileImpl {
 				int32	CentreX = ((int32) l->CentreX << 19) >> 19;
 				int32	CentreY = ((int32) l->CentreY << 19) >> 19;
 
-				if (PPU.Mode7VFlip)
+				if (RPPU.Mode7VFlip)
 					starty = 255 - (int) (Line + 1);
 				else
 					starty = Line + 1;
@@ -707,7 +707,7 @@ namespace TileImpl {
 				int	BB = ((l->MatrixB * starty) & ~63) + ((l->MatrixB * yy) & ~63) + (CentreX << 8);
 				int	DD = ((l->MatrixD * starty) & ~63) + ((l->MatrixD * yy) & ~63) + (CentreY << 8);
 
-				if (PPU.Mode7HFlip)
+				if (RPPU.Mode7HFlip)
 				{
 					startx = MRight - 1;
 					aa = -l->MatrixA;
@@ -727,7 +727,7 @@ namespace TileImpl {
 				uint8	Pix;
 				uint8	ctr = 1;
 
-				if (!PPU.Mode7Repeat)
+				if (!RPPU.Mode7Repeat)
 				{
 					for (int32 x = MLeft; x < MRight; x++, AA += aa, CC += cc)
 					{
@@ -770,7 +770,7 @@ namespace TileImpl {
 							b = *(TileData + ((Y & 7) << 4) + ((X & 7) << 1));
 						}
 						else
-						if (PPU.Mode7Repeat == 3)
+						if (RPPU.Mode7Repeat == 3)
 							b = *(VRAM1    + ((Y & 7) << 4) + ((X & 7) << 1));
 						else
 							continue;
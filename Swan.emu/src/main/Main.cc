@@ -42,6 +42,7 @@ namespace EmuEx
 using namespace MDFN_IEN_WSWAN;
 
 const char *EmuSystem::creditsViewStr = CREDITS_INFO_STRING "(c) 2011-2024\nRobert Broglia\nwww.explusalpha.com\n\nPortions (c) the\nMednafen Team\nmednafen.github.io";
+bool EmuSystem::handlesCompressedStates = true;
 bool EmuApp::needsGlobalInstance = true;
 
 EmuSystem::NameFilterFunc EmuSystem::defaultFsFilter =
@@ -67,7 +68,7 @@ FS::FileString WsSystem::stateFilename(int slot, std::string_view name) const
 	return stateFilenameMDFN(*MDFNGameInfo, slot, name, 'a', noMD5InFilenames);
 }
 
-size_t WsSystem::stateSize() { return stateSizeMDFN(); }
+size_t WsSystem::stateSize() { return currStateSize; }
 void WsSystem::readState(EmuApp &app, std::span<uint8_t> buff) { readStateMDFN(app, buff); }
 size_t WsSystem::writeState(std::span<uint8_t> buff, SaveStateFlags flags) { return writeStateMDFN(buff, flags); }
 
@@ -112,6 +113,7 @@ void WsSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegate
 	EmuEx::loadContent(*this, mdfnGameInfo, io, maxRomSize);
 	setupInput(EmuApp::get(appContext()));
 	WSwan_SetPixelFormat(toMDFNSurface(mSurfacePix).format);
+	currStateSize = stateSizeMDFN();
 }
 
 bool WsSystem::onVideoRenderFormatChange(EmuVideo &, IG::PixelFormat fmt)
@@ -140,7 +142,7 @@ void WsSystem::configAudioRate(FrameTime outputFrameTime, int outputRate)
 void WsSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio)
 {
 	static constexpr size_t maxAudioFrames = 48000 / minFrameRate;
-	EmuEx::runFrame(*this, mdfnGameInfo, taskCtx, video, mSurfacePix, audio, maxAudioFrames);
+	EmuEx::runFrameDirect(*this, mdfnGameInfo, taskCtx, video, mSurfacePix, audio, maxAudioFrames);
 	if(configuredLCDVTotal != lcdVTotal()) [[unlikely]]
 	{
 		onFrameTimeChanged();
@@ -171,7 +173,8 @@ namespace Mednafen
 
 void MDFND_commitVideoFrame(EmulateSpecStruct *espec)
 {
-	espec->video->startFrameWithFormat(espec->taskCtx, static_cast<EmuEx::WsSystem&>(*espec->sys).mSurfacePix);
+	auto &sys = static_cast<EmuEx::WsSystem&>(*espec->sys);
+	espec->video->startFrameWithFormat(espec->taskCtx, EmuEx::toPixmapView(*espec->surface, sys.mSurfacePix.format()));
 }
 
 }
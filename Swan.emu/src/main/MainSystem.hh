@@ -86,6 +86,7 @@ class WsSystem final: public EmuSystem
 {
 public:
 	Mednafen::MDFNGI mdfnGameInfo{EmulatedWSwan};
+	size_t currStateSize{};
 	FileIO saveFileIO;
 	IG::MutablePixmapView mSurfacePix{};
 	static constexpr WSize vidBufferPx{224, 144};
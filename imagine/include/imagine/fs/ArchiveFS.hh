@@ -18,12 +18,20 @@
 #include <imagine/config/defs.hh>
 #include <imagine/fs/FSDefs.hh>
 #include <imagine/io/ArchiveIO.hh>
+#include <imagine/io/IO.hh>
 #include <imagine/util/string/CStringView.hh>
+#include <algorithm>
 #include <memory>
 #include <iterator>
+#include <span>
+#include <string>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 #include <concepts>
 
+struct z_stream_s;
+
 namespace IG::FS
 {
 
@@ -112,6 +120,88 @@ inline bool seekFileInArchive(ArchiveIO &arch, std::string_view path)
 	return seekFileInArchive(arch, [&](const ArchiveIO &entry){ return entry.name() == path; });
 }
 
+// Lists an archive's entries in one pass so finding & reading them doesn't rescan it from the start.
+// Zip entries that are stored or deflated are read directly at their offsets from the central directory,
+// other formats share a single libarchive reader that only rewinds when an earlier entry is requested.
+class ArchiveIndex
+{
+public:
+	struct Entry
+	{
+		std::string name;
+		file_type type{};
+		size_t size{};
+		uint32_t crc32{};
+		size_t ordinal{}; // position in the archive
+		// zip only
+		off_t headerOffset{};
+		size_t compressedSize{};
+		uint16_t method{};
+	};
+
+	// Reads an entry in pieces without decompressing all of it at once. Other entries of a
+	// non-zip archive can't be read until it's destroyed since they share the same reader.
+	class EntryReader
+	{
+	public:
+		EntryReader(ArchiveIndex &, const Entry &);
+		EntryReader(EntryReader &&) = delete;
+		~EntryReader();
+		ssize_t read(std::span<uint8_t> dest); // returns 0 at the end of the entry
+		size_t size() const { return entry.size; }
+
+	private:
+		ArchiveIndex &index;
+		const Entry &entry;
+		off_t srcOffset{};
+		size_t srcBytesLeft{};
+		size_t bytesLeft{};
+		uint32_t crc{};
+		std::unique_ptr<z_stream_s> stream;
+		std::unique_ptr<uint8_t[]> srcBuff;
+		const uint8_t *mappedSrc{};
+
+		void refillInput();
+	};
+
+	ArchiveIndex() = default;
+	ArchiveIndex(IO);
+	ArchiveIndex(ArchiveIO);
+	std::span<const Entry> entries() const { return entries_; }
+	const Entry *find(std::string_view name) const;
+
+	const Entry *find(std::predicate<const Entry &> auto &&pred) const
+	{
+		auto it = std::ranges::find_if(entries_, pred);
+		return it != entries_.end() ? &*it : nullptr;
+	}
+
+	const Entry *findFile(std::predicate<const Entry &> auto &&pred) const
+	{
+		return find([&](const Entry &e){ return e.type == file_type::regular && pred(e); });
+	}
+
+	void read(const Entry &, std::span<uint8_t> dest); // dest must be the entry's size
+	IOBuffer read(const Entry &);
+	IO open(const Entry &e) { return IO{read(e)}; }
+	bool hasDirectAccess() const { return bool(io); }
+	explicit operator bool() const { return io || arch.hasArchive(); }
+
+private:
+	IO io; // source of a directly accessed zip
+	ArchiveIO arch; // reader for other formats
+	size_t archOrdinal{};
+	std::vector<Entry> entries_;
+	std::unordered_map<std::string_view, size_t> nameIndex;
+
+	bool readZipDirectory(IO &);
+	void readArchiveEntries();
+	off_t zipDataOffset(const Entry &);
+	void readZipEntry(const Entry &, std::span<uint8_t> dest);
+	void seekArchiveEntry(const Entry &);
+	void readArchiveEntry(const Entry &, std::span<uint8_t> dest);
+};
+
 bool hasArchiveExtension(std::string_view name);
 
 };
@@ -42,6 +42,8 @@ public:
 	void clear();
 	LockedTextureBuffer lock(TextureBufferFlags bufferFlags = {});
 	void unlock(LockedTextureBuffer lockBuff, TextureWriteFlags writeFlags = {});
+	// Releases a locked buffer without uploading or swapping it
+	void cancelLock(LockedTextureBuffer lockBuff);
 	WSize size() const;
 	PixmapDesc pixmapDesc() const;
 	void setSampler(TextureSamplerConfig);
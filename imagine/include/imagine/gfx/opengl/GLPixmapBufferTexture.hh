@@ -44,6 +44,7 @@ public:
 	void writeAligned(PixmapView pixmap, int assumeAlign, TextureWriteFlags writeFlags = {});
 	LockedTextureBuffer lock(TextureBufferFlags bufferFlags = {});
 	void unlock(LockedTextureBuffer lockBuff, TextureWriteFlags writeFlags = {});
+	void cancelLock(LockedTextureBuffer) {} // buffers stay mapped, so nothing to release
 	bool isSingleBuffered() const { return bufferIdx == SINGLE_BUFFER_VALUE; }
 
 protected:
@@ -35,6 +35,7 @@ public:
 	bool setFormat(PixmapDesc desc, ColorSpace, TextureSamplerConfig);
 	LockedTextureBuffer lock(TextureBufferFlags bufferFlags);
 	void unlock(LockedTextureBuffer lockBuff, TextureWriteFlags writeFlags);
+	void cancelLock(LockedTextureBuffer lockBuff);
 
 protected:
 	jobject surfaceTex{};
@@ -42,6 +43,7 @@ protected:
 	ANativeWindow *nativeWin{};
 	uint8_t bpp = 0;
 	bool singleBuffered = false;
+	uint8_t cancelledImages = 0;
 
 	void deinit();
 };
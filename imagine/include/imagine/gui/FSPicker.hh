@@ -28,6 +28,7 @@
 #include <vector>
 #include <string>
 #include <string_view>
+#include <mutex>
 
 namespace IG::FS
 {
@@ -70,6 +71,9 @@ public:
 	void goUpDirectory(const Input::Event &);
 	void pushFileLocationsView(const Input::Event &);
 	void setShowHiddenFiles(bool);
+	// Saves directory listings in the app's cache directory and reuses them
+	// while the directory's modification time is unchanged
+	void setListingCache(bool);
 
 protected:
 	struct FileEntry
@@ -84,6 +88,14 @@ protected:
 		bool isDir() const { return text.flags.user & isDirFlag; }
 	};
 
+	// entries listed by the worker thread waiting to be merged into dir on the main thread
+	struct DirListBatch
+	{
+		std::vector<FileEntry> entries;
+		std::string message;
+		bool finished{};
+	};
+
 	enum class DepthMode { increment, decrement, reset };
 
 	FilterFunc filter{};
@@ -96,8 +108,11 @@ protected:
 	Gfx::Text msgText;
 	CustomEvent dirListEvent{"FSPicker::dirListEvent", {}};
 	TableUIState newFileUIState{};
+	std::mutex dirListMutex;
+	DirListBatch dirListBatch;
 	Mode mode_{};
 	bool showHiddenFiles_{};
+	bool useListingCache{};
 	WorkThread dirListThread{};
 
 	void changeDirByInput(CStringView path, FS::RootPathInfo, const Input::Event &,
@@ -107,6 +122,9 @@ protected:
 	TableView &fileTableView();
 	void startDirectoryListThread(CStringView path);
 	void listDirectory(CStringView path, ThreadStop &stop);
+	void publishEntries(std::vector<FileEntry> &, std::string_view message = {}, bool finished = false);
+	void mergeDirListBatch();
+	void selectEntry(size_t idx, const Input::Event &);
 	void setEmptyPath(std::string_view message);
 };
 
@@ -67,6 +67,8 @@ protected:
 	void drawScrollContent(Gfx::RendererCommands &cmds);
 	bool scrollInputEvent(const Input::MotionEvent &);
 	void stopScrollAnimation();
+	// called on the main thread after the scroll offset changes, before the next draw
+	virtual void onScroll() {}
 };
 
 }
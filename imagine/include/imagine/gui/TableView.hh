@@ -22,6 +22,8 @@
 #include <imagine/util/rectangle2.h>
 #include <imagine/util/concepts.hh>
 #include <string_view>
+#include <vector>
+#include <cstdint>
 
 namespace IG::Input
 {
@@ -88,9 +90,12 @@ public:
 
 protected:
 	static constexpr size_t maxSeparators = 30;
+	// cells are only compiled once they scroll near the visible area
+	enum class CellState : uint8_t { unplaced, placed, ready };
 	ItemsDelegate items{};
 	ItemDelegate item{};
 	SelectElementDelegate selectElementDel{};
+	std::vector<CellState> cellStates;
 	UTF16String nameStr{};
 	Gfx::IQuads selectQuads;
 	Gfx::IColQuads separatorQuads;
@@ -103,6 +108,8 @@ protected:
 	bool hasFocus = true;
 
 	void setYCellSize(int s);
+	void onScroll() override;
+	void prepareVisibleCells();
 	WRect focusRect();
 	void onSelectElement(const Input::Event &, size_t i, MenuItem &);
 	bool elementIsSelectable(MenuItem &item);
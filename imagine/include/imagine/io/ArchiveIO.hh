@@ -60,6 +60,7 @@ public:
 	bool hasEntry() const;
 	bool hasArchive() const { return arch.get(); }
 	void rewind();
+	IO releaseIO(); // closes the archive and returns its source IO rewound to the start
 	struct archive* archive() const { return arch.get(); }
 	ssize_t read(void *buff, size_t bytes, std::optional<off_t> offset = {});
 	ssize_t write(const void *buff, size_t bytes, std::optional<off_t> offset = {});
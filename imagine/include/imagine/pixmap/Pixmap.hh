@@ -22,6 +22,8 @@
 #include <imagine/util/ranges.hh>
 #include <imagine/util/mdspan.hh>
 #include <imagine/util/concepts.hh>
+#include <imagine/util/enum.hh>
+#include <span>
 #include <cstring>
 
 namespace IG
@@ -41,6 +43,27 @@ uint32_t transformRGB565ToBGRX8888(uint16_t p);
 uint32_t transformRGB888ToRGBX8888(RGBTripleArray p);
 uint32_t transformRGB888ToBGRX8888(RGBTripleArray p);
 
+WISE_ENUM_CLASS((PixelConversion, uint8_t),
+	RGB565ToRGBX8888,
+	RGB565ToBGRX8888,
+	RGB565ToRGB888,
+	RGB888ToRGBX8888,
+	RGB888ToBGRX8888,
+	RGB888ToRGB565,
+	RGBX8888ToRGB565,
+	BGRX8888ToRGB565,
+	RGBX8888ToRGB888,
+	BGRX8888ToRGB888,
+	RGBA8888ToBGRA8888);
+
+// Converts a run of pixels with SIMD code selected for the running CPU
+void convertPixels(PixelConversion, const void *src, void *dest, int pixels);
+// Reference implementation using the transform functions above
+void convertPixelsScalar(PixelConversion, const void *src, void *dest, int pixels);
+
+void writeIndexedPixels(uint16_t *dest, int destPitchPx, const uint8_t *src, int srcPitchPx, WSize size, std::span<const uint16_t> palette);
+void writeIndexedPixels(uint32_t *dest, int destPitchPx, const uint8_t *src, int srcPitchPx, WSize size, std::span<const uint32_t> palette);
+
 template <class Func>
 concept PixmapTransformFunc =
 		requires (Func &&f, unsigned data){ f(data); } ||
@@ -195,33 +218,33 @@ public:
 			case PIXEL_RGBA8888:
 				switch(srcFormatID)
 				{
-					case PIXEL_BGRA8888: return convertRGBA8888ToBGRA8888(*this, pixmap);
-					case PIXEL_RGB565: return convertRGB565ToRGBX8888(*this, pixmap);
-					case PIXEL_RGB888: return convertRGB888ToRGBX8888(*this, pixmap);
+					case PIXEL_BGRA8888: return convertPixmap(*this, pixmap, PixelConversion::RGBA8888ToBGRA8888);
+					case PIXEL_RGB565: return convertPixmap(*this, pixmap, PixelConversion::RGB565ToRGBX8888);
+					case PIXEL_RGB888: return convertPixmap(*this, pixmap, PixelConversion::RGB888ToRGBX8888);
 					default: return invalidFormatConversion(*this, pixmap);
 				}
 			case PIXEL_BGRA8888:
 				switch(srcFormatID)
 				{
-					case PIXEL_RGBA8888: return convertRGBA8888ToBGRA8888(*this, pixmap);
-					case PIXEL_RGB565: return convertRGB565ToBGRX8888(*this, pixmap);
-					case PIXEL_RGB888: return convertRGB888ToBGRX8888(*this, pixmap);
+					case PIXEL_RGBA8888: return convertPixmap(*this, pixmap, PixelConversion::RGBA8888ToBGRA8888);
+					case PIXEL_RGB565: return convertPixmap(*this, pixmap, PixelConversion::RGB565ToBGRX8888);
+					case PIXEL_RGB888: return convertPixmap(*this, pixmap, PixelConversion::RGB888ToBGRX8888);
 					default: return invalidFormatConversion(*this, pixmap);
 				}
 			case PIXEL_RGB888:
 				switch(srcFormatID)
 				{
-					case PIXEL_BGRA8888: return convertBGRX8888ToRGB888(*this, pixmap);
-					case PIXEL_RGBA8888: return convertRGBX8888ToRGB888(*this, pixmap);
-					case PIXEL_RGB565: return convertRGB565ToRGB888(*this, pixmap);
+					case PIXEL_BGRA8888: return convertPixmap(*this, pixmap, PixelConversion::BGRX8888ToRGB888);
+					case PIXEL_RGBA8888: return convertPixmap(*this, pixmap, PixelConversion::RGBX8888ToRGB888);
+					case PIXEL_RGB565: return convertPixmap(*this, pixmap, PixelConversion::RGB565ToRGB888);
 					default: return invalidFormatConversion(*this, pixmap);
 				}
 			case PIXEL_RGB565:
 				switch(srcFormatID)
 				{
-					case PIXEL_RGBA8888: return convertRGBX8888ToRGB565(*this, pixmap);
-					case PIXEL_BGRA8888: return convertBGRX8888ToRGB565(*this, pixmap);
-					case PIXEL_RGB888: return convertRGB888ToRGB565(*this, pixmap);
+					case PIXEL_RGBA8888: return convertPixmap(*this, pixmap, PixelConversion::RGBX8888ToRGB565);
+					case PIXEL_BGRA8888: return convertPixmap(*this, pixmap, PixelConversion::BGRX8888ToRGB565);
+					case PIXEL_RGB888: return convertPixmap(*this, pixmap, PixelConversion::RGB888ToRGB565);
 					default: return invalidFormatConversion(*this, pixmap);
 				}
 			default:
@@ -313,6 +336,22 @@ public:
 		subView(destPos, size() - destPos).writeTransformed(func, pixmap);
 	}
 
+	// Expands 8-bit indexed pixels through a color table of up to 256 entries with
+	// vectorized lookups (AVX2 gathers or AArch64 table lookups) when available
+	void writeIndexed(std::span<const uint16_t> palette, auto pixmap) requires(dataIsMutable)
+	{
+		assumeExpr(format().bytesPerPixel() == 2);
+		assumeExpr(pixmap.format().bytesPerPixel() == 1);
+		writeIndexedPixels((uint16_t*)data_, pitchPx(), (const uint8_t*)pixmap.data(), pixmap.pitchPx(), pixmap.size(), palette);
+	}
+
+	void writeIndexed(std::span<const uint32_t> palette, auto pixmap) requires(dataIsMutable)
+	{
+		assumeExpr(format().bytesPerPixel() == 4);
+		assumeExpr(pixmap.format().bytesPerPixel() == 1);
+		writeIndexedPixels((uint32_t*)data_, pitchPx(), (const uint8_t*)pixmap.data(), pixmap.pitchPx(), pixmap.size(), palette);
+	}
+
 	template <class Src, class Dest>
 	void writeTransformedDirect(PixmapTransformFunc auto &&func, auto pixmap) requires(dataIsMutable)
 	{
@@ -372,59 +411,21 @@ protected:
 		bug_unreachable("unimplemented conversion:%s -> %s", src.format().name(), dest.format().name());
 	}
 
-	static void convertRGB888ToRGBX8888(auto dest, auto src)
-	{
-		dest.template writeTransformedDirect<RGBTripleArray, uint32_t>(transformRGB888ToRGBX8888, src);
-	}
-
-	static void convertRGB888ToBGRX8888(auto dest, auto src)
-	{
-		dest.template writeTransformedDirect<RGBTripleArray, uint32_t>(transformRGB888ToBGRX8888, src);
-	}
-
-	static void convertRGB565ToRGBX8888(auto dest, auto src)
-	{
-		dest.writeTransformed(transformRGB565ToRGBX8888, src);
-	}
-
-	static void convertRGB565ToBGRX8888(auto dest, auto src)
-	{
-		dest.writeTransformed(transformRGB565ToBGRX8888, src);
-	}
-
-	static void convertRGBX8888ToRGB888(auto dest, auto src)
-	{
-		dest.template writeTransformedDirect<uint32_t, RGBTripleArray>(transformRGBX8888ToRGB888, src);
-	}
-
-	static void convertBGRX8888ToRGB888(auto dest, auto src)
-	{
-		dest.template writeTransformedDirect<uint32_t, RGBTripleArray>(transformBGRX8888ToRGB888, src);
-	}
-
-	static void convertRGB565ToRGB888(auto dest, auto src)
+	static void convertPixmap(auto dest, auto src, PixelConversion conv)
 	{
-		dest.template writeTransformedDirect<uint16_t, RGBTripleArray>(transformRGB565ToRGB888, src);
-	}
-
-	static void convertRGB888ToRGB565(auto dest, auto src)
-	{
-		dest.template writeTransformedDirect<RGBTripleArray, uint16_t>(transformRGB888ToRGB565, src);
-	}
-
-	static void convertRGBX8888ToRGB565(auto dest, auto src)
-	{
-		dest.writeTransformed(transformRGBX8888ToRGB565, src);
-	}
-
-	static void convertRGBA8888ToBGRA8888(auto dest, auto src)
-	{
-		dest.writeTransformed(transformRGBA8888ToBGRA8888, src);
-	}
-
-	static void convertBGRX8888ToRGB565(auto dest, auto src)
-	{
-		dest.template writeTransformed(transformBGRX8888ToRGB565, src);
+		auto srcData = (const char*)src.data();
+		auto destData = (char*)dest.data();
+		if(dest.w() == src.w() && !dest.isPadded() && !src.isPadded())
+		{
+			convertPixels(conv, srcData, destData, src.w() * src.h());
+			return;
+		}
+		for(auto i : iotaCount(src.h()))
+		{
+			convertPixels(conv, srcData, destData, src.w());
+			srcData += src.pitchBytes();
+			destData += dest.pitchBytes();
+		}
 	}
 };
 
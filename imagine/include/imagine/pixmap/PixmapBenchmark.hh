@@ -0,0 +1,37 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/pixmap/Pixmap.hh>
+#include <imagine/time/Time.hh>
+#include <vector>
+
+namespace IG
+{
+
+struct PixelConversionBenchmark
+{
+	PixelConversion conversion{};
+	bool bitExact{};
+	FloatSeconds simdTime{};
+	FloatSeconds scalarTime{};
+};
+
+// Times convertPixels() against the scalar reference over frames of random pixels,
+// checking the outputs are bit-exact. RGB565 sources also cover every input value.
+std::vector<PixelConversionBenchmark> benchmarkPixelConversions(WSize frameSize = {320, 240}, int iterations = 100);
+
+}
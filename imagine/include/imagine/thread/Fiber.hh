@@ -0,0 +1,57 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/util/DelegateFunc.hh>
+#include <cstddef>
+
+namespace IG
+{
+
+// Stackful coroutine that runs on whichever thread calls resume() until it calls yield().
+// Switching only saves the callee-saved registers and stack pointer in user space, so unlike
+// handing off work between threads or swapcontext() it never enters the kernel.
+// A suspended fiber's stack isn't unwound when it's destroyed.
+class Fiber
+{
+public:
+	using EntryDelegate = DelegateFunc<void()>;
+	static constexpr size_t defaultStackSize = 1024 * 1024;
+
+	constexpr Fiber() = default;
+	Fiber(EntryDelegate, size_t stackSize = defaultStackSize);
+	Fiber(const Fiber &) = delete;
+	Fiber &operator=(const Fiber &) = delete;
+	~Fiber();
+	void resume();
+	void yield();
+	bool isRunning() const { return running; }
+	bool hasFinished() const { return finished; }
+	explicit operator bool() const { return stack; }
+
+protected:
+	void *stack{};
+	size_t stackSize{};
+	void *fiberSP{};
+	void *callerSP{};
+	EntryDelegate entry;
+	bool running{};
+	bool finished{};
+
+	[[noreturn]] static void run(Fiber *);
+};
+
+}
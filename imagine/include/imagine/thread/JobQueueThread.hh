@@ -0,0 +1,146 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/thread/SPSCQueue.hh>
+#include <imagine/thread/Thread.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/util/utility.h>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <thread>
+
+namespace IG
+{
+
+// Runs jobs pushed from a single producer thread on a worker thread in the same order.
+// The worker blocks with std::atomic wait when idle and sync() returns once every pushed job
+// has finished, after which the producer can safely access anything the jobs use.
+template<class Job, size_t capacity>
+class JobQueueThread
+{
+public:
+	constexpr JobQueueThread() = default;
+	JobQueueThread(const JobQueueThread &) = delete;
+	JobQueueThread &operator=(const JobQueueThread &) = delete;
+	~JobQueueThread() { stop(); }
+
+	void start(std::invocable<const Job &> auto &&runJob)
+	{
+		stop();
+		pushCount.store(0, std::memory_order_relaxed);
+		doneCount.store(0, std::memory_order_relaxed);
+		busyTime.store(0, std::memory_order_relaxed);
+		quit.store(false, std::memory_order_relaxed);
+		thread = makeThreadSync([this, runJob = IG_forward(runJob)](std::binary_semaphore &sem) mutable
+		{
+			threadId_ = thisThreadId();
+			sem.release();
+			run(runJob);
+		});
+	}
+
+	void stop()
+	{
+		if(!thread.joinable())
+			return;
+		sync();
+		quit.store(true, std::memory_order_relaxed);
+		pushCount.fetch_add(1, std::memory_order_release);
+		pushCount.notify_one();
+		thread.join();
+		threadId_ = {};
+	}
+
+	// Returns without waking the worker if it's already busy, so pushing per job is cheap
+	void push(const Job &job)
+	{
+		while(true)
+		{
+			auto done = doneCount.load(std::memory_order_acquire);
+			if(queue.push(job))
+				break;
+			// queue is full, so the worker has a job and the done count must advance
+			doneCount.wait(done, std::memory_order_acquire);
+		}
+		pushCount.fetch_add(1, std::memory_order_release);
+		pushCount.notify_one();
+	}
+
+	void sync()
+	{
+		auto pushed = pushCount.load(std::memory_order_relaxed);
+		for(auto done = doneCount.load(std::memory_order_acquire); done != pushed;
+			done = doneCount.load(std::memory_order_acquire))
+		{
+			doneCount.wait(done, std::memory_order_acquire);
+		}
+	}
+
+	// Producer side check for jobs that haven't finished yet
+	bool hasPendingJobs() const
+	{
+		return doneCount.load(std::memory_order_acquire) != pushCount.load(std::memory_order_relaxed);
+	}
+
+	bool isRunning() const { return thread.joinable(); }
+	ThreadId threadId() const { return threadId_; }
+
+	// Time spent running jobs since the last call, only exact if called after sync()
+	Nanoseconds takeBusyTime() { return Nanoseconds{busyTime.exchange(0, std::memory_order_relaxed)}; }
+
+protected:
+	SPSCQueue<Job, capacity> queue;
+	alignas(cacheLineSize) std::atomic_uint32_t pushCount{};
+	alignas(cacheLineSize) std::atomic_uint32_t doneCount{};
+	std::atomic_int64_t busyTime{};
+	std::atomic_bool quit{};
+	ThreadId threadId_{};
+	std::thread thread;
+
+	void run(auto &runJob)
+	{
+		uint32_t done = 0;
+		auto busyStart = SteadyClock::now();
+		while(true)
+		{
+			if(pushCount.load(std::memory_order_acquire) == done)
+			{
+				do
+				{
+					pushCount.wait(done, std::memory_order_acquire);
+				} while(pushCount.load(std::memory_order_acquire) == done);
+				busyStart = SteadyClock::now();
+			}
+			if(quit.load(std::memory_order_relaxed))
+				return;
+			runJob(*queue.pop());
+			done++;
+			if(pushCount.load(std::memory_order_relaxed) == done)
+			{
+				// about to go idle, account the time before sync() can return
+				auto now = SteadyClock::now();
+				busyTime.fetch_add(duration_cast<Nanoseconds>(now - busyStart).count(), std::memory_order_relaxed);
+				busyStart = now;
+			}
+			doneCount.store(done, std::memory_order_release);
+			doneCount.notify_one();
+		}
+	}
+};
+
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <optional>
+#include <cstddef>
+
+namespace IG
+{
+
+constexpr size_t cacheLineSize = 64;
+
+// Hint to the CPU that the thread is in a spin-wait loop
+inline void cpuRelax()
+{
+	#if defined __i386__ || defined __x86_64__
+	__builtin_ia32_pause();
+	#elif defined __arm__ || defined __aarch64__
+	asm volatile("yield");
+	#endif
+}
+
+// Lock-free bounded queue for exactly one producer thread and one consumer thread
+template<class T, size_t capacity>
+class SPSCQueue
+{
+public:
+	static_assert(std::has_single_bit(capacity), "capacity must be a power of 2");
+
+	// producer thread only, returns false if full
+	bool push(const T &val)
+	{
+		auto tail = tail_.load(std::memory_order_relaxed);
+		if(tail - producerHeadCache == capacity)
+		{
+			producerHeadCache = head_.load(std::memory_order_acquire);
+			if(tail - producerHeadCache == capacity)
+				return false;
+		}
+		buff[tail % capacity] = val;
+		tail_.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	// consumer thread only
+	std::optional<T> pop()
+	{
+		auto head = head_.load(std::memory_order_relaxed);
+		if(head == consumerTailCache)
+		{
+			consumerTailCache = tail_.load(std::memory_order_acquire);
+			if(head == consumerTailCache)
+				return {};
+		}
+		T val = buff[head % capacity];
+		head_.store(head + 1, std::memory_order_release);
+		return val;
+	}
+
+	// consumer thread only
+	bool empty()
+	{
+		consumerTailCache = tail_.load(std::memory_order_acquire);
+		return head_.load(std::memory_order_relaxed) == consumerTailCache;
+	}
+
+private:
+	alignas(cacheLineSize) std::atomic_size_t head_{};
+	size_t consumerTailCache{};
+	alignas(cacheLineSize) std::atomic_size_t tail_{};
+	size_t producerHeadCache{};
+	alignas(cacheLineSize) std::array<T, capacity> buff{};
+};
+
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+// Minimal compressor/decompressor for the LZ4 block format, favoring speed over ratio
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <cstdint>
+#include <cstring>
+
+namespace IG
+{
+
+constexpr size_t lz4CompressBound(size_t size) { return size + size / 255 + 16; }
+
+inline size_t compressLZ4(std::span<uint8_t> dest, std::span<const uint8_t> src)
+{
+	constexpr size_t minMatch = 4;
+	constexpr size_t lastLiterals = 5; // the block always ends with at least this many literals
+	constexpr size_t matchFindLimit = 12; // no match may start within this many bytes of the end
+	constexpr size_t maxOffset = 0xFFFF;
+	constexpr int hashBits = 12;
+	if(dest.size() < lz4CompressBound(src.size()))
+		return 0;
+	auto in = src.data();
+	auto out = dest.data();
+	auto writeLength = [&](size_t len)
+	{
+		for(; len >= 255; len -= 255)
+			*out++ = 255;
+		*out++ = len;
+	};
+	auto writeLiterals = [&](uint8_t *token, size_t start, size_t len)
+	{
+		*token = std::min(len, size_t(15)) << 4;
+		if(len >= 15)
+			writeLength(len - 15);
+		std::memcpy(out, in + start, len);
+		out += len;
+	};
+	auto load32 = [&](size_t pos)
+	{
+		uint32_t v;
+		std::memcpy(&v, in + pos, sizeof(v));
+		return v;
+	};
+	size_t anchor = 0;
+	if(src.size() > matchFindLimit)
+	{
+		std::array<uint32_t, 1 << hashBits> table{};
+		const size_t matchEndLimit = src.size() - lastLiterals;
+		const size_t posLimit = src.size() - matchFindLimit;
+		size_t pos = 0;
+		while(pos <= posLimit)
+		{
+			auto seq = load32(pos);
+			auto &entry = table[(seq * 2654435761u) >> (32 - hashBits)];
+			size_t ref = entry;
+			entry = pos;
+			if(ref >= pos || pos - ref > maxOffset || load32(ref) != seq)
+			{
+				// step faster through data that isn't matching
+				pos += 1 + ((pos - anchor) >> 6);
+				continue;
+			}
+			size_t matchLen = minMatch;
+			while(pos + matchLen < matchEndLimit && in[ref + matchLen] == in[pos + matchLen])
+				matchLen++;
+			auto token = out++;
+			writeLiterals(token, anchor, pos - anchor);
+			size_t offset = pos - ref;
+			*out++ = offset & 0xFF;
+			*out++ = offset >> 8;
+			size_t extraLen = matchLen - minMatch;
+			*token |= std::min(extraLen, size_t(15));
+			if(extraLen >= 15)
+				writeLength(extraLen - 15);
+			pos += matchLen;
+			anchor = pos;
+		}
+	}
+	writeLiterals(out++, anchor, src.size() - anchor);
+	return out - dest.data();
+}
+
+// returns the uncompressed size, or 0 on malformed input or if dest is too small
+inline size_t uncompressLZ4(std::span<uint8_t> dest, std::span<const uint8_t> src)
+{
+	auto in = src.data();
+	auto inEnd = in + src.size();
+	auto out = dest.data();
+	auto outEnd = out + dest.size();
+	auto readLength = [&](size_t &len)
+	{
+		uint8_t b;
+		do
+		{
+			if(in == inEnd)
+				return false;
+			b = *in++;
+			len += b;
+		} while(b == 255);
+		return true;
+	};
+	while(in < inEnd)
+	{
+		auto token = *in++;
+		size_t litLen = token >> 4;
+		if(litLen == 15 && !readLength(litLen))
+			return 0;
+		if(litLen > size_t(inEnd - in) || litLen > size_t(outEnd - out))
+			return 0;
+		std::memcpy(out, in, litLen);
+		in += litLen;
+		out += litLen;
+		if(in == inEnd) // last sequence has no match
+			break;
+		if(inEnd - in < 2)
+			return 0;
+		size_t offset = in[0] | (in[1] << 8);
+		in += 2;
+		if(!offset || offset > size_t(out - dest.data()))
+			return 0;
+		size_t matchLen = token & 0xF;
+		if(matchLen == 15 && !readLength(matchLen))
+			return 0;
+		matchLen += 4;
+		if(matchLen > size_t(outEnd - out))
+			return 0;
+		auto match = out - offset;
+		if(offset >= matchLen)
+		{
+			std::memcpy(out, match, matchLen);
+		}
+		else
+		{
+			// overlapping copy repeats the previous bytes
+			for(size_t i = 0; i < matchLen; i++)
+				out[i] = match[i];
+		}
+		out += matchLen;
+	}
+	return out - dest.data();
+}
+
+}
@@ -19,6 +19,12 @@
 #include <imagine/io/FileIO.hh>
 #include <imagine/util/utility.h>
 #include <imagine/util/string.h>
+#include <imagine/logger/logger.h>
+#include <zlib.h>
+#include <array>
+#include <format>
+#include <limits>
+#include <stdexcept>
 
 namespace IG::FS
 {
@@ -71,6 +77,339 @@ void ArchiveIterator::rewind()
 	impl->rewind();
 }
 
+static uint16_t readLE16(const uint8_t *p) { return p[0] | (p[1] << 8); }
+static uint32_t readLE32(const uint8_t *p) { return readLE16(p) | (uint32_t(readLE16(p + 2)) << 16); }
+static uint64_t readLE64(const uint8_t *p) { return readLE32(p) | (uint64_t(readLE32(p + 4)) << 32); }
+
+constexpr uint32_t zipLocalHeaderSig = 0x04034b50;
+constexpr uint32_t zipCentralHeaderSig = 0x02014b50;
+constexpr uint32_t zipEndSig = 0x06054b50;
+constexpr uint32_t zip64EndSig = 0x06064b50;
+constexpr uint32_t zip64EndLocatorSig = 0x07064b50;
+constexpr size_t zipLocalHeaderSize = 30;
+constexpr size_t zipCentralHeaderSize = 46;
+constexpr size_t zipEndSize = 22;
+constexpr size_t zip64EndSize = 56;
+constexpr size_t zip64EndLocatorSize = 20;
+constexpr uint16_t zipMethodStored = 0;
+constexpr uint16_t zipMethodDeflated = 8;
+constexpr size_t zipReadBufferSize = 0x10000;
+constexpr size_t maxZlibLength = std::numeric_limits<uInt>::max();
+
+ArchiveIndex::ArchiveIndex(IO src)
+{
+	if(readZipDirectory(src))
+	{
+		logMsg("indexed %zu zip entries", entries_.size());
+		io = std::move(src);
+	}
+	else
+	{
+		entries_.clear();
+		src.rewind();
+		arch = ArchiveIO{std::move(src)};
+		readArchiveEntries();
+	}
+	for(const auto &e : entries_)
+	{
+		nameIndex.try_emplace(e.name, e.ordinal);
+	}
+}
+
+ArchiveIndex::ArchiveIndex(ArchiveIO a):
+	ArchiveIndex{a.releaseIO()} {}
+
+const ArchiveIndex::Entry *ArchiveIndex::find(std::string_view name) const
+{
+	auto it = nameIndex.find(name);
+	return it != nameIndex.end() ? &entries_[it->second] : nullptr;
+}
+
+void ArchiveIndex::read(const Entry &e, std::span<uint8_t> dest)
+{
+	assert(dest.size() == e.size);
+	if(io)
+		readZipEntry(e, dest);
+	else
+		readArchiveEntry(e, dest);
+}
+
+IOBuffer ArchiveIndex::read(const Entry &e)
+{
+	IOBuffer buff{e.size};
+	read(e, buff);
+	return buff;
+}
+
+bool ArchiveIndex::readZipDirectory(IO &src)
+{
+	size_t fileSize = src.size();
+	if(fileSize < zipEndSize)
+		return false;
+	// end of central directory record is followed by at most a 64KB comment
+	auto tailSize = std::min(fileSize, zipEndSize + 0xFFFF);
+	auto tailOffset = fileSize - tailSize;
+	std::vector<uint8_t> tail(tailSize);
+	if(src.read(tail.data(), tailSize, tailOffset) != ssize_t(tailSize))
+		return false;
+	ssize_t endPos = tailSize - zipEndSize;
+	while(endPos >= 0 && readLE32(&tail[endPos]) != zipEndSig)
+		endPos--;
+	if(endPos < 0)
+		return false;
+	const uint8_t *end = &tail[endPos];
+	uint64_t entryCount = readLE16(end + 10);
+	uint64_t dirSize = readLE32(end + 12);
+	uint64_t dirOffset = readLE32(end + 16);
+	if(entryCount == 0xFFFF || dirSize == 0xFFFFFFFF || dirOffset == 0xFFFFFFFF)
+	{
+		if(endPos < ssize_t(zip64EndLocatorSize))
+			return false;
+		const uint8_t *locator = end - zip64EndLocatorSize;
+		if(readLE32(locator) != zip64EndLocatorSig)
+			return false;
+		std::array<uint8_t, zip64EndSize> end64;
+		if(src.read(end64.data(), end64.size(), readLE64(locator + 8)) != ssize_t(end64.size()) ||
+			readLE32(end64.data()) != zip64EndSig)
+			return false;
+		entryCount = readLE64(&end64[32]);
+		dirSize = readLE64(&end64[40]);
+		dirOffset = readLE64(&end64[48]);
+	}
+	if(dirOffset + dirSize > fileSize)
+		return false;
+	std::vector<uint8_t> dir(dirSize);
+	if(src.read(dir.data(), dirSize, dirOffset) != ssize_t(dirSize))
+		return false;
+	// don't trust the count for the allocation, each entry needs at least a fixed size header
+	entries_.reserve(std::min(entryCount, dirSize / zipCentralHeaderSize));
+	size_t pos = 0;
+	for(uint64_t i = 0; i < entryCount; i++)
+	{
+		if(pos + zipCentralHeaderSize > dir.size())
+			return false;
+		const uint8_t *h = &dir[pos];
+		if(readLE32(h) != zipCentralHeaderSig)
+			return false;
+		auto flags = readLE16(h + 8);
+		auto method = readLE16(h + 10);
+		uint32_t crc = readLE32(h + 16);
+		uint64_t compressedSize = readLE32(h + 20);
+		uint64_t size = readLE32(h + 24);
+		size_t nameLen = readLE16(h + 28);
+		size_t extraLen = readLE16(h + 30);
+		size_t commentLen = readLE16(h + 32);
+		uint64_t headerOffset = readLE32(h + 42);
+		if(pos + zipCentralHeaderSize + nameLen + extraLen + commentLen > dir.size())
+			return false;
+		if((flags & 1) || (method != zipMethodStored && method != zipMethodDeflated))
+		{
+			// encrypted or using a method only libarchive supports
+			return false;
+		}
+		std::string_view name{reinterpret_cast<const char*>(h + zipCentralHeaderSize), nameLen};
+		// sizes & offset that don't fit in 32 bits are in the zip64 extra field
+		const uint8_t *extra = h + zipCentralHeaderSize + nameLen;
+		for(size_t extraPos = 0; extraPos + 4 <= extraLen;)
+		{
+			auto id = readLE16(extra + extraPos);
+			size_t fieldSize = readLE16(extra + extraPos + 2);
+			const uint8_t *field = extra + extraPos + 4;
+			const uint8_t *fieldEnd = field + std::min(fieldSize, extraLen - extraPos - 4);
+			if(id == 0x0001)
+			{
+				for(auto val : {&size, &compressedSize, &headerOffset})
+				{
+					if(*val != 0xFFFFFFFF)
+						continue;
+					if(field + 8 > fieldEnd)
+						return false;
+					*val = readLE64(field);
+					field += 8;
+				}
+				break;
+			}
+			extraPos += 4 + fieldSize;
+		}
+		entries_.emplace_back(std::string{name}, name.ends_with('/') ? file_type::directory : file_type::regular,
+			size, crc, i, off_t(headerOffset), compressedSize, method);
+		pos += zipCentralHeaderSize + nameLen + extraLen + commentLen;
+	}
+	return true;
+}
+
+void ArchiveIndex::readArchiveEntries()
+{
+	size_t ordinal = 0;
+	for(; arch.hasEntry(); ordinal++)
+	{
+		entries_.emplace_back(std::string{arch.name()}, arch.type(), arch.size(), arch.crc32(), ordinal);
+		arch.readNextEntry();
+	}
+	archOrdinal = ordinal;
+	logMsg("indexed %zu archive entries", entries_.size());
+}
+
+off_t ArchiveIndex::zipDataOffset(const Entry &e)
+{
+	std::array<uint8_t, zipLocalHeaderSize> header;
+	if(io.read(header.data(), header.size(), e.headerOffset) != ssize_t(header.size()) ||
+		readLE32(header.data()) != zipLocalHeaderSig)
+	{
+		throw std::runtime_error{std::format("Bad local header for archive entry: {}", e.name)};
+	}
+	return e.headerOffset + zipLocalHeaderSize + readLE16(&header[26]) + readLE16(&header[28]);
+}
+
+void ArchiveIndex::readZipEntry(const Entry &e, std::span<uint8_t> buff)
+{
+	if(EntryReader{*this, e}.read(buff) != ssize_t(e.size))
+		throw std::runtime_error{std::format("Error reading archive entry: {}", e.name)};
+}
+
+void ArchiveIndex::seekArchiveEntry(const Entry &e)
+{
+	if(e.ordinal < archOrdinal)
+	{
+		arch.rewind();
+		archOrdinal = 0;
+	}
+	for(; archOrdinal < e.ordinal && arch.hasEntry(); archOrdinal++)
+	{
+		arch.readNextEntry();
+	}
+	if(!arch.hasEntry())
+		throw std::runtime_error{std::format("Error seeking to archive entry: {}", e.name)};
+}
+
+void ArchiveIndex::readArchiveEntry(const Entry &e, std::span<uint8_t> buff)
+{
+	seekArchiveEntry(e);
+	auto bytesRead = arch.read(buff.data(), buff.size());
+	// the entry's data can only be read once, so move past it
+	arch.readNextEntry();
+	archOrdinal++;
+	if(bytesRead != ssize_t(e.size))
+		throw std::runtime_error{std::format("Error reading archive entry: {}", e.name)};
+}
+
+ArchiveIndex::EntryReader::EntryReader(ArchiveIndex &index, const Entry &e):
+	index{index}, entry{e}, bytesLeft{e.size}
+{
+	if(!index.io)
+	{
+		index.seekArchiveEntry(e);
+		return;
+	}
+	srcOffset = index.zipDataOffset(e);
+	srcBytesLeft = e.compressedSize;
+	if(e.method == zipMethodStored)
+	{
+		if(e.compressedSize != e.size)
+			throw std::runtime_error{std::format("Error reading archive entry: {}", e.name)};
+		return;
+	}
+	stream = std::make_unique<z_stream>();
+	// inflate straight from the mapped file if possible
+	if(auto map = index.io.map(); map.size() >= size_t(srcOffset) + srcBytesLeft)
+		mappedSrc = &map[srcOffset];
+	else
+		srcBuff = std::make_unique<uint8_t[]>(zipReadBufferSize);
+	if(inflateInit2(stream.get(), -MAX_WBITS) != Z_OK)
+	{
+		stream.reset();
+		throw std::runtime_error{std::format("Error decompressing archive entry: {}", e.name)};
+	}
+}
+
+ArchiveIndex::EntryReader::~EntryReader()
+{
+	if(stream)
+		inflateEnd(stream.get());
+	if(!index.io)
+	{
+		// the entry's data can only be read once, so move past it
+		index.arch.readNextEntry();
+		index.archOrdinal++;
+	}
+}
+
+void ArchiveIndex::EntryReader::refillInput()
+{
+	if(!srcBytesLeft)
+		return;
+	auto bytes = std::min(srcBytesLeft, mappedSrc ? maxZlibLength : zipReadBufferSize);
+	if(mappedSrc)
+	{
+		stream->next_in = const_cast<z_const Bytef*>(mappedSrc);
+		mappedSrc += bytes;
+	}
+	else
+	{
+		if(index.io.read(srcBuff.get(), bytes, srcOffset) != ssize_t(bytes))
+			throw std::runtime_error{std::format("Error reading archive entry: {}", entry.name)};
+		stream->next_in = srcBuff.get();
+	}
+	srcOffset += bytes;
+	srcBytesLeft -= bytes;
+	stream->avail_in = bytes;
+}
+
+ssize_t ArchiveIndex::EntryReader::read(std::span<uint8_t> dest)
+{
+	dest = dest.first(std::min(dest.size(), bytesLeft));
+	if(dest.empty())
+		return 0;
+	if(!index.io)
+	{
+		for(size_t pos = 0; pos < dest.size();)
+		{
+			auto bytesRead = index.arch.read(&dest[pos], dest.size() - pos);
+			if(bytesRead <= 0)
+				throw std::runtime_error{std::format("Error reading archive entry: {}", entry.name)};
+			pos += bytesRead;
+		}
+	}
+	else if(!stream)
+	{
+		if(index.io.read(dest.data(), dest.size(), srcOffset) != ssize_t(dest.size()))
+			throw std::runtime_error{std::format("Error reading archive entry: {}", entry.name)};
+		srcOffset += dest.size();
+	}
+	else
+	{
+		// zlib's lengths are 32-bit, so larger spans are passed in pieces
+		for(auto out = dest; out.size();)
+		{
+			auto outSize = std::min(out.size(), maxZlibLength);
+			stream->next_out = out.data();
+			stream->avail_out = outSize;
+			while(stream->avail_out)
+			{
+				if(!stream->avail_in)
+					refillInput();
+				auto res = inflate(stream.get(), Z_NO_FLUSH);
+				if(res != Z_OK && !(res == Z_STREAM_END && !stream->avail_out && outSize == out.size()))
+					throw std::runtime_error{std::format("Error decompressing archive entry: {}", entry.name)};
+			}
+			out = out.subspan(outSize);
+		}
+	}
+	bytesLeft -= dest.size();
+	if(index.io)
+	{
+		for(auto data = dest; data.size();)
+		{
+			auto size = std::min(data.size(), maxZlibLength);
+			crc = ::crc32(crc, data.data(), size);
+			data = data.subspan(size);
+		}
+		if(!bytesLeft && crc != entry.crc32)
+			throw std::runtime_error{std::format("CRC mismatch in archive entry: {}", entry.name)};
+	}
+	return dest.size();
+}
+
 bool hasArchiveExtension(std::string_view name)
 {
 	return endsWithAnyCaseless(name, ".7z", ".rar", ".zip");
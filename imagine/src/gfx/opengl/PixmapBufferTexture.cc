@@ -188,6 +188,11 @@ void PixmapBufferTexture::unlock(LockedTextureBuffer lockBuff, TextureWriteFlags
 	visit([&](auto &t){ t.unlock(lockBuff, writeFlags); }, directTex);
 }
 
+void PixmapBufferTexture::cancelLock(LockedTextureBuffer lockBuff)
+{
+	visit([&](auto &t){ t.cancelLock(lockBuff); }, directTex);
+}
+
 WSize PixmapBufferTexture::size() const
 {
 	return visit([&](auto &t){ return t.size(0); }, directTex);
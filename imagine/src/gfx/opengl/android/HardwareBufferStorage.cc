@@ -79,6 +79,12 @@ void HardwareSingleBufferStorage<Buffer>::unlock(LockedTextureBuffer, TextureWri
 	buffer.unlock();
 }
 
+template<class Buffer>
+void HardwareSingleBufferStorage<Buffer>::cancelLock(LockedTextureBuffer)
+{
+	buffer.unlock();
+}
+
 template<class Buffer>
 HardwareBufferStorage<Buffer>::HardwareBufferStorage(RendererTask &r, TextureConfig config):
 	Texture{r}
@@ -136,6 +142,12 @@ void HardwareBufferStorage<Buffer>::unlock(LockedTextureBuffer, TextureWriteFlag
 	swapBuffer();
 }
 
+template<class Buffer>
+void HardwareBufferStorage<Buffer>::cancelLock(LockedTextureBuffer)
+{
+	bufferInfo[bufferIdx].buffer.unlock();
+}
+
 template<class Buffer>
 void HardwareBufferStorage<Buffer>::swapBuffer()
 {
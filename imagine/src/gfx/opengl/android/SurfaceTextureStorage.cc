@@ -92,6 +92,7 @@ SurfaceTextureStorage &SurfaceTextureStorage::operator=(SurfaceTextureStorage &&
 	nativeWin = std::exchange(o.nativeWin, {});
 	bpp = o.bpp;
 	singleBuffered = o.singleBuffered;
+	cancelledImages = o.cancelledImages;
 	return *this;
 }
 
@@ -184,10 +185,26 @@ void SurfaceTextureStorage::unlock(LockedTextureBuffer, TextureWriteFlags)
 	}
 	ANativeWindow_unlockAndPost(nativeWin);
 	task().run(
-		[tex = surfaceTex, app = task().appContext()]()
+		[tex = surfaceTex, app = task().appContext(), skipImages = std::exchange(cancelledImages, 0)]()
 		{
-			updateSurfaceTextureImage(app.thisThreadJniEnv(), tex);
+			auto env = app.thisThreadJniEnv();
+			// images are latched in queue order, so consume any cancelled ones first
+			for(int i = 0; i <= skipImages; i++)
+				updateSurfaceTextureImage(env, tex);
 		});
 }
 
+void SurfaceTextureStorage::cancelLock(LockedTextureBuffer)
+{
+	if(!nativeWin) [[unlikely]]
+	{
+		logErr("called cancelLock when uninitialized");
+		return;
+	}
+	// a locked window buffer can only be released by queuing it, the next unlock()
+	// skips past it so the texture never shows it
+	ANativeWindow_unlockAndPost(nativeWin);
+	cancelledImages++;
+}
+
 }
@@ -25,6 +25,11 @@
 #include <imagine/util/math.hh>
 #include <imagine/util/format.hh>
 #include <imagine/util/string.h>
+#include <imagine/io/FileIO.hh>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iterator>
 #include <string>
 #include <system_error>
 
@@ -32,6 +37,127 @@ namespace IG
 {
 
 constexpr SystemLogger log{"FSPicker"};
+constexpr size_t dirListBatchSize = 256;
+constexpr uint8_t listingCacheVersion = 1;
+constexpr size_t maxCachedListings = 256;
+constexpr uint64_t maxListingCacheSize = 16 * 1024 * 1024;
+
+struct CachedDirEntry
+{
+	std::string path;
+	FS::FileString name;
+	FS::file_type type;
+};
+
+static FS::PathString listingCachePath(ApplicationContext ctx, std::string_view path)
+{
+	return FS::pathString(ctx.cachePath(), std::format("dirlist/{:016x}", std::hash<std::string_view>{}(path)));
+}
+
+static bool readListingCache(CStringView cachePath, std::string_view path, FS::file_time_type mtime,
+	std::invocable<const FS::directory_entry &> auto &&onEntry)
+{
+	FileIO io{cachePath, {.test = true, .accessHint = IOAccessHint::All}};
+	if(!io)
+		return false;
+	if(io.get<uint8_t>() != listingCacheVersion ||
+		io.get<int64_t>() != mtime.time_since_epoch().count())
+		return false;
+	std::string cachedPath;
+	if(io.readSized(cachedPath, io.get<uint16_t>()) == -1 || cachedPath != path)
+		return false;
+	// read everything first so a truncated file is treated as a miss
+	auto count = io.get<uint32_t>();
+	std::vector<CachedDirEntry> entries;
+	entries.reserve(count);
+	for(auto i : iotaCount(count))
+	{
+		auto type = io.getExpected<uint8_t>();
+		if(!type)
+			return false;
+		auto &e = entries.emplace_back();
+		e.type = FS::file_type(*type);
+		std::string name;
+		if(io.readSized(e.path, io.get<uint16_t>()) == -1 ||
+			io.readSized(name, io.get<uint8_t>()) == -1)
+			return false;
+		e.name = name;
+	}
+	log.info("using cached listing of:{}", path);
+	for(const auto &e : entries)
+	{
+		if(!onEntry(FS::directory_entry{e.path, e.name, e.type}))
+			break;
+	}
+	return true;
+}
+
+// removes the oldest listings so there's room for one more
+static void trimListingCache(CStringView cacheDir)
+{
+	struct CachedListing
+	{
+		FS::PathString path;
+		uint64_t size;
+		FS::file_time_type lastWrite;
+	};
+	std::vector<CachedListing> files;
+	uint64_t totalSize{};
+	for(auto &e : FS::directory_iterator{cacheDir})
+	{
+		if(e.type() != FS::file_type::regular)
+			continue;
+		auto status = FS::status(e.path());
+		files.emplace_back(e.path(), status.size(), status.lastWriteTime());
+		totalSize += status.size();
+	}
+	if(files.size() < maxCachedListings && totalSize <= maxListingCacheSize)
+		return;
+	std::ranges::sort(files, {}, &CachedListing::lastWrite);
+	auto count = files.size();
+	for(const auto &f : files)
+	{
+		FS::remove(f.path);
+		totalSize -= f.size;
+		if(--count < maxCachedListings && totalSize <= maxListingCacheSize)
+			break;
+	}
+	log.info("trimmed listing cache to {} files", count);
+}
+
+static void writeListingCache(CStringView cachePath, std::string_view path,
+	FS::file_time_type mtime, std::span<const CachedDirEntry> entries)
+{
+	try
+	{
+		auto cacheDir = FS::dirname(cachePath);
+		FS::create_directory(cacheDir);
+		trimListingCache(cacheDir);
+		FileIO io{cachePath, OpenFlags::testNewFile()};
+		if(!io)
+		{
+			log.error("can't create listing cache for:{}", path);
+			return;
+		}
+		io.put(listingCacheVersion);
+		io.put(int64_t(mtime.time_since_epoch().count()));
+		io.put(uint16_t(path.size()));
+		io.write(path.data(), path.size());
+		io.put(uint32_t(entries.size()));
+		for(const auto &e : entries)
+		{
+			io.put(uint8_t(e.type));
+			io.put(uint16_t(e.path.size()));
+			io.write(e.path.data(), e.path.size());
+			io.put(uint8_t(e.name.size()));
+			io.write(e.name.data(), e.name.size());
+		}
+	}
+	catch(std::system_error &)
+	{
+		log.error("error writing listing cache for:{}", path);
+	}
+}
 
 FSPicker::FSPicker(ViewAttachParams attach, Gfx::TextureSpan backRes, Gfx::TextureSpan closeRes,
 	FilterFunc filter, Mode mode, Gfx::GlyphTextureSet *face_):
@@ -74,6 +200,10 @@ FSPicker::FSPicker(ViewAttachParams attach, Gfx::TextureSpan backRes, Gfx::Textu
 	controller.setNavView(std::move(nav));
 	controller.push(makeView<TableView>([](const TableView &) { return 0; },
 		[&d = dir](const TableView &, size_t idx) -> MenuItem& { return d[idx].text; }));
+	fileTableView().setOnSelectElement([this](const Input::Event &e, int i, MenuItem &)
+	{
+		selectEntry(i, e);
+	});
 	controller.navView()->showLeftBtn(true);
 	dir.reserve(16); // start with some initial capacity to avoid small reallocations
 }
@@ -81,8 +211,6 @@ FSPicker::FSPicker(ViewAttachParams attach, Gfx::TextureSpan backRes, Gfx::Textu
 void FSPicker::place()
 {
 	controller.place(viewRect(), displayRect());
-	if(dirListThread.isWorking())
-		return;
 	msgText.compile();
 }
 
@@ -173,25 +301,20 @@ void FSPicker::prepareDraw()
 {
 	controller.navView()->prepareDraw();
 	controller.top().prepareDraw();
-	if(dirListThread.isWorking())
-		return;
 	msgText.makeGlyphs();
 }
 
 void FSPicker::draw(Gfx::RendererCommands &__restrict__ cmds)
 {
-	if(!dirListThread.isWorking())
+	if(dir.size())
 	{
-		if(dir.size())
-		{
-			controller.top().draw(cmds);
-		}
-		else
-		{
-			using namespace IG::Gfx;
-			cmds.basicEffect().enableAlphaTexture(cmds);
-			msgText.draw(cmds, controller.top().viewRect().pos(C2DO), C2DO, ColorName::WHITE);
-		}
+		controller.top().draw(cmds);
+	}
+	else
+	{
+		using namespace IG::Gfx;
+		cmds.basicEffect().enableAlphaTexture(cmds);
+		msgText.draw(cmds, controller.top().viewRect().pos(C2DO), C2DO, ColorName::WHITE);
 	}
 	controller.navView()->draw(cmds);
 }
@@ -210,6 +333,7 @@ void FSPicker::setEmptyPath(std::string_view message)
 	newFileUIState = {};
 	fileUIStates.clear();
 	dir.clear();
+	dirListBatch = {};
 	msgText.resetString(message);
 	if(mode_ == Mode::FILE_IN_DIR)
 	{
@@ -446,6 +570,11 @@ void FSPicker::setShowHiddenFiles(bool on)
 	showHiddenFiles_ = on;
 }
 
+void FSPicker::setListingCache(bool on)
+{
+	useListingCache = on;
+}
+
 void FSPicker::startDirectoryListThread(CStringView path)
 {
 	if(dirListThread.isWorking())
@@ -459,13 +588,12 @@ void FSPicker::startDirectoryListThread(CStringView path)
 		return;
 	}
 	dir.clear();
-	fileTableView().setItemsDelegate();
+	dirListBatch = {};
+	msgText.resetString();
+	fileTableView().setItemsDelegate([&d = dir](const TableView &) { return d.size(); });
 	dirListEvent.setCallback([this]()
 	{
-		fileTableView().setItemsDelegate([&d = dir](const TableView &) { return d.size(); });
-		place();
-		fileTableView().restoreUIState(std::exchange(newFileUIState, {}));
-		postDraw();
+		mergeDirListBatch();
 	});
 	dirListEvent.cancel();
 	dirListThread.reset([this](WorkThread::Context ctx, const std::string &path)
@@ -480,89 +608,153 @@ void FSPicker::startDirectoryListThread(CStringView path)
 
 void FSPicker::listDirectory(CStringView path, ThreadStop &stop)
 {
-	try
+	std::vector<FileEntry> entries;
+	entries.reserve(dirListBatchSize);
+	size_t listedEntries{};
+	auto addEntry = [&](const FS::directory_entry &entry)
 	{
-		appContext().forEachInDirectoryUri(path,
-			[this, &stop](auto &entry)
-			{
-				//log.info("entry:{}", entry.path());
-				if(stop) [[unlikely]]
-				{
-					log.info("interrupted listing directory");
-					return false;
-				}
-				bool isDir = entry.type() == FS::file_type::directory;
-				if(mode_ == Mode::FILE_IN_DIR) // filter directories
-				{
-					if(isDir)
-						return true;
-				}
-				if(!showHiddenFiles_ && entry.name().starts_with('.'))
-				{
-					return true;
-				}
-				if(filter && !filter(entry))
-				{
-					return true;
-				}
-				auto &item = dir.emplace_back(attachParams(), std::string{entry.path()}, entry.name());
-				if(isDir)
-					item.text.flags.user |= FileEntry::isDirFlag;
-				if(mode_ == Mode::DIR && !isDir)
-					item.text.setActive(false);
+		//log.info("entry:{}", entry.path());
+		if(stop) [[unlikely]]
+		{
+			log.info("interrupted listing directory");
+			return false;
+		}
+		bool isDir = entry.type() == FS::file_type::directory;
+		if(mode_ == Mode::FILE_IN_DIR) // filter directories
+		{
+			if(isDir)
 				return true;
-			});
-		std::sort(dir.begin(), dir.end(),
-			[](const FileEntry &e1, const FileEntry &e2)
-			{
-				if(e1.isDir() && !e2.isDir())
-					return true;
-				else if(!e1.isDir() && e2.isDir())
-					return false;
-				else
-					return caselessLexCompare(e1.path, e2.path);
-			});
-		if(dir.size())
+		}
+		if(!showHiddenFiles_ && entry.name().starts_with('.'))
+		{
+			return true;
+		}
+		if(filter && !filter(entry))
+		{
+			return true;
+		}
+		auto &item = entries.emplace_back(attachParams(), std::string{entry.path()}, entry.name());
+		if(isDir)
+			item.text.flags.user |= FileEntry::isDirFlag;
+		if(mode_ == Mode::DIR && !isDir)
+			item.text.setActive(false);
+		listedEntries++;
+		if(entries.size() == dirListBatchSize)
+			publishEntries(entries);
+		return true;
+	};
+	try
+	{
+		if(useListingCache)
 		{
-			for(auto &d : dir)
+			auto ctx = appContext();
+			auto cachePath = listingCachePath(ctx, path);
+			auto mtime = ctx.fileUriLastWriteTime(path);
+			if(mtime == FS::file_time_type{} || !readListingCache(cachePath, path, mtime, addEntry))
 			{
-				if(!d.text.active())
-					continue;
-				if(d.isDir())
-				{
-					d.text.onSelect =
-						[this, &dirPath = d.path](const Input::Event &e)
-						{
-							assert(!isSingleDirectoryMode());
-							auto path = std::move(dirPath);
-							log.info("entering dir:{}", path);
-							changeDirByInput(path, root.info, e);
-						};
-				}
-				else
+				std::vector<CachedDirEntry> listing;
+				ctx.forEachInDirectoryUri(path,
+					[&listing, &addEntry](auto &entry)
+					{
+						listing.emplace_back(std::string{entry.path()}, FS::FileString{entry.name()}, entry.type());
+						return addEntry(entry);
+					});
+				// skip caching if the directory could still change within the same timestamp
+				if(!stop && mtime != FS::file_time_type{} &&
+					std::chrono::system_clock::now() - mtime > std::chrono::seconds{2})
 				{
-					d.text.onSelect =
-						[this, &dirPath = d.path](const Input::Event &e)
-						{
-							onSelectPath_.callCopy(*this, dirPath, appContext().fileUriDisplayName(dirPath), e);
-						};
+					writeListingCache(cachePath, path, mtime, listing);
 				}
 			}
-			msgText.resetString();
 		}
-		else // no entries, show a message instead
+		else
 		{
-			msgText.resetString("Empty Directory");
-			msgText.compile();
+			appContext().forEachInDirectoryUri(path,
+				[&addEntry](auto &entry) { return addEntry(entry); });
 		}
+		if(stop)
+			return;
+		publishEntries(entries, listedEntries ? "" : "Empty Directory", true);
 	}
 	catch(std::system_error &err)
 	{
 		log.error("can't open:{}", path);
 		auto ec = err.code();
 		std::string_view extraMsg = mode_ == Mode::FILE_IN_DIR ? "" : "\nPick a path from the top bar";
-		msgText.resetString(std::format("Can't open directory:\n{}{}", ec.message(), extraMsg));
-		msgText.compile();
+		entries.clear();
+		publishEntries(entries, std::format("Can't open directory:\n{}{}", ec.message(), extraMsg), true);
+	}
+}
+
+void FSPicker::publishEntries(std::vector<FileEntry> &entries, std::string_view message, bool finished)
+{
+	{
+		std::scoped_lock lock{dirListMutex};
+		std::ranges::move(entries, std::back_inserter(dirListBatch.entries));
+		dirListBatch.message = message;
+		dirListBatch.finished = finished;
+	}
+	entries.clear();
+	dirListEvent.notify();
+}
+
+void FSPicker::mergeDirListBatch()
+{
+	DirListBatch batch;
+	{
+		std::scoped_lock lock{dirListMutex};
+		batch = std::exchange(dirListBatch, {});
+	}
+	if(batch.entries.size())
+	{
+		auto entryIsLess = [](const FileEntry &e1, const FileEntry &e2)
+		{
+			if(e1.isDir() && !e2.isDir())
+				return true;
+			else if(!e1.isDir() && e2.isDir())
+				return false;
+			else
+				return caselessLexCompare(e1.path, e2.path);
+		};
+		// each batch is sorted then merged so the list stays ordered while it streams in
+		std::ranges::sort(batch.entries, entryIsLess);
+		auto mergedSize = dir.size();
+		std::ranges::move(batch.entries, std::back_inserter(dir));
+		std::inplace_merge(dir.begin(), dir.begin() + mergedSize, dir.end(), entryIsLess);
+	}
+	else if(!batch.finished)
+	{
+		return;
+	}
+	if(batch.finished)
+	{
+		if(!batch.message.empty())
+			dir.clear();
+		msgText.resetString(batch.message);
+	}
+	place();
+	if(batch.finished)
+		fileTableView().restoreUIState(std::exchange(newFileUIState, {}));
+	postDraw();
+}
+
+void FSPicker::selectEntry(size_t idx, const Input::Event &e)
+{
+	if(idx >= dir.size())
+		return;
+	auto &entry = dir[idx];
+	if(!entry.text.active())
+		return;
+	if(entry.isDir())
+	{
+		assert(!isSingleDirectoryMode());
+		FS::PathString path{entry.path};
+		log.info("entering dir:{}", path);
+		changeDirByInput(path, root.info, e);
+	}
+	else
+	{
+		onSelectPath_.callCopy(*this, entry.path, appContext().fileUriDisplayName(entry.path), e);
 	}
 }
 
@@ -60,7 +60,10 @@ ScrollView::ScrollView(ViewAttachParams attach):
 				if(scrollVel || isOverScrolled())
 				{
 					if(offset != prevOffset)
+					{
+						onScroll();
 						postDraw();
+					}
 					return true;
 				}
 			}
@@ -83,12 +86,18 @@ ScrollView::ScrollView(ViewAttachParams attach):
 				else
 				{
 					if(offset != prevOffset)
+					{
+						onScroll();
 						postDraw();
+					}
 					return true;
 				}
 			}
 			if(offset != prevOffset)
+			{
+				onScroll();
 				postDraw();
+			}
 			lastFrameTimestamp = {};
 			return false;
 		}
@@ -184,7 +193,10 @@ bool ScrollView::scrollInputEvent(const Input::MotionEvent &e)
 		offset += e.scrolledVertical() < 0 ? -vel : vel;
 		offset = std::clamp(offset, 0, offsetMax);
 		if(offset != prevOffset)
+		{
+			onScroll();
 			postDraw();
+		}
 		return true;
 	}
 	// click & drag scroll
@@ -228,7 +240,10 @@ bool ScrollView::scrollInputEvent(const Input::MotionEvent &e)
 					}
 				}
 				if(offset != prevOffset)
+				{
+					onScroll();
 					postDraw();
+				}
 			}
 		},
 		[&](Input::DragTrackerState state, auto)
@@ -261,6 +276,7 @@ void ScrollView::setScrollOffset(int o)
 	dragTracker.reset();
 	stopScrollAnimation();
 	offset = std::clamp(o, 0, offsetMax);
+	onScroll();
 }
 
 void ScrollView::stopScrollAnimation()
@@ -60,10 +60,43 @@ void TableView::setAlign(_2DOrigin align)
 
 void TableView::prepareDraw()
 {
-	for(auto i : iotaCount(items(*this)))
+	// glyphs may have been freed, so re-make them as cells come into view
+	for(auto &state : cellStates)
 	{
-		item(*this, i).prepareDraw();
+		if(state == CellState::ready)
+			state = CellState::placed;
 	}
+	prepareVisibleCells();
+}
+
+void TableView::prepareVisibleCells()
+{
+	size_t cells_ = items(*this);
+	if(!cells_ || !yCellSize)
+		return;
+	if(cellStates.size() != cells_)
+		cellStates.resize(cells_);
+	// include a screen of cells above & below to cover scroll animation between frames
+	int firstVisible = scrollOffset() / yCellSize;
+	auto start = std::clamp(firstVisible - visibleCells, 0, int(cells_));
+	auto end = std::clamp(firstVisible + visibleCells * 2, 0, int(cells_));
+	for(int i = start; i < end; i++)
+	{
+		auto &state = cellStates[i];
+		if(state == CellState::ready)
+			continue;
+		auto &it = item(*this, i);
+		if(state == CellState::unplaced)
+			it.compile();
+		else
+			it.prepareDraw();
+		state = CellState::ready;
+	}
+}
+
+void TableView::onScroll()
+{
+	prepareVisibleCells();
 }
 
 void TableView::draw(Gfx::RendererCommands &__restrict__ cmds)
@@ -152,8 +185,11 @@ void TableView::draw(Gfx::RendererCommands &__restrict__ cmds)
 	auto xIndent = manager().tableXIndentPx;
 	for(size_t i = startYCell; i < endYCell; i++)
 	{
-		auto rect = IG::makeWindowRectRel({x, y}, {viewRect().xSize(), yCellSize});
-		drawElement(cmds, i, item(*this, i), rect, xIndent);
+		if(i < cellStates.size() && cellStates[i] != CellState::unplaced)
+		{
+			auto rect = IG::makeWindowRectRel({x, y}, {viewRect().xSize(), yCellSize});
+			drawElement(cmds, i, item(*this, i), rect, xIndent);
+		}
 		y += yCellSize;
 	}
 	cmds.setClipTest(false);
@@ -162,17 +198,14 @@ void TableView::draw(Gfx::RendererCommands &__restrict__ cmds)
 void TableView::place()
 {
 	auto cells_ = items(*this);
-	for(auto i : iotaCount(cells_))
-	{
-		//logMsg("compile item %d", i);
-		item(*this, i).compile();
-	}
+	cellStates.assign(cells_, CellState::unplaced);
 	if(cells_)
 	{
 		setYCellSize(IG::makeEvenRoundedUp(item(*this, 0).ySize()*2));
 		visibleCells = IG::divRoundUp(displayRect().ySize(), yCellSize) + 1;
 		scrollToFocusRect();
 		selectQuads.write(0, {.bounds = WRect{{}, {viewRect().xSize(), yCellSize-1}}.as<int16_t>()});
+		prepareVisibleCells();
 	}
 	else
 		visibleCells = 0;
@@ -252,6 +252,18 @@ void ArchiveIO::rewind()
 	init(std::move(io));
 }
 
+IO ArchiveIO::releaseIO()
+{
+	if(!arch) [[unlikely]]
+		return {};
+	auto io = std::move(ctrlBlock->io);
+	io.rewind();
+	ptr = {};
+	arch = {};
+	ctrlBlock = {};
+	return io;
+}
+
 ssize_t ArchiveIO::read(void *buff, size_t bytes, std::optional<off_t> offset)
 {
 	if(!*this) [[unlikely]]
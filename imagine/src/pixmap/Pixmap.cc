@@ -13,13 +13,36 @@
 	You should have received a copy of the GNU General Public License
 	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
 
+#include <imagine/pixmap/Pixmap.hh>
+#include <algorithm>
 #include <array>
 #include <cstdint>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#define IG_PIXMAP_X86_SIMD
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#define IG_PIXMAP_NEON_SIMD
+#include <arm_neon.h>
+#endif
 
 namespace IG
 {
 
-using RGBTripleArray = std::array<unsigned char, 3>;
+#ifdef IG_PIXMAP_X86_SIMD
+// SSE2 is part of the baseline, later extensions are checked at runtime
+static bool cpuHasSSSE3()
+{
+	static const bool hasSSSE3 = __builtin_cpu_supports("ssse3");
+	return hasSSSE3;
+}
+
+static bool cpuHasAVX2()
+{
+	static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+	return hasAVX2;
+}
+#endif
 
 RGBTripleArray transformRGB565ToRGB888(uint16_t p)
 {
@@ -109,4 +132,651 @@ static uint32_t transformRGB888ToRGBX8888Impl(RGBTripleArray p)
 uint32_t transformRGB888ToRGBX8888(RGBTripleArray p) { return transformRGB888ToRGBX8888Impl(p); }
 uint32_t transformRGB888ToBGRX8888(RGBTripleArray p) { return transformRGB888ToRGBX8888Impl<true>(p); }
 
+// Format conversion
+
+template <class Src, class Dest>
+static void convertLineScalar(const uint8_t *src, uint8_t *dest, int n, auto &&func)
+{
+	for(auto i : iotaCount(n))
+	{
+		Src p;
+		std::memcpy(&p, src + i * sizeof(Src), sizeof(Src));
+		Dest out = func(p);
+		std::memcpy(dest + i * sizeof(Dest), &out, sizeof(Dest));
+	}
+}
+
+template <PixelConversion conv>
+static void convertLineScalar(const uint8_t *src, uint8_t *dest, int n)
+{
+	using enum PixelConversion;
+	if constexpr(conv == RGB565ToRGBX8888) convertLineScalar<uint16_t, uint32_t>(src, dest, n, transformRGB565ToRGBX8888);
+	else if constexpr(conv == RGB565ToBGRX8888) convertLineScalar<uint16_t, uint32_t>(src, dest, n, transformRGB565ToBGRX8888);
+	else if constexpr(conv == RGB565ToRGB888) convertLineScalar<uint16_t, RGBTripleArray>(src, dest, n, transformRGB565ToRGB888);
+	else if constexpr(conv == RGB888ToRGBX8888) convertLineScalar<RGBTripleArray, uint32_t>(src, dest, n, transformRGB888ToRGBX8888);
+	else if constexpr(conv == RGB888ToBGRX8888) convertLineScalar<RGBTripleArray, uint32_t>(src, dest, n, transformRGB888ToBGRX8888);
+	else if constexpr(conv == RGB888ToRGB565) convertLineScalar<RGBTripleArray, uint16_t>(src, dest, n, transformRGB888ToRGB565);
+	else if constexpr(conv == RGBX8888ToRGB565) convertLineScalar<uint32_t, uint16_t>(src, dest, n, transformRGBX8888ToRGB565);
+	else if constexpr(conv == BGRX8888ToRGB565) convertLineScalar<uint32_t, uint16_t>(src, dest, n, transformBGRX8888ToRGB565);
+	else if constexpr(conv == RGBX8888ToRGB888) convertLineScalar<uint32_t, RGBTripleArray>(src, dest, n, transformRGBX8888ToRGB888);
+	else if constexpr(conv == BGRX8888ToRGB888) convertLineScalar<uint32_t, RGBTripleArray>(src, dest, n, transformBGRX8888ToRGB888);
+	else convertLineScalar<uint32_t, uint32_t>(src, dest, n, transformRGBA8888ToBGRA8888);
+}
+
+// The vector paths compute the same rounded divisions as the transform functions:
+// (x * 255 + 15) / 31, (x * 255 + 31) / 63, and (x * 31 + 127) / 255 or (x * 63 + 127) / 255
+// replaced by multiplies by the reciprocal, which are exact over the input ranges used
+
+#ifdef IG_PIXMAP_X86_SIMD
+template <int size>
+using ShuffleMask = std::array<int8_t, size>;
+
+// pshufb control from a function mapping each output byte to an input byte, or -1 for zero
+template <int size = 16>
+static constexpr auto makeShuffleMask(auto &&func)
+{
+	ShuffleMask<size> mask{};
+	for(auto i : iotaCount(size))
+	{
+		int idx = func(i);
+		mask[i] = idx < 0 ? int8_t(0x80) : int8_t(idx);
+	}
+	return mask;
+}
+
+static __m128i expand5SSE2(__m128i x)
+{
+	auto v = _mm_add_epi16(_mm_mullo_epi16(x, _mm_set1_epi16(255)), _mm_set1_epi16(15));
+	return _mm_srli_epi16(_mm_mulhi_epu16(v, _mm_set1_epi16(4229)), 1);
+}
+
+static __m128i expand6SSE2(__m128i x)
+{
+	auto v = _mm_add_epi16(_mm_mullo_epi16(x, _mm_set1_epi16(255)), _mm_set1_epi16(31));
+	return _mm_srli_epi16(_mm_mulhi_epu16(v, _mm_set1_epi16(8323)), 3);
+}
+
+template <int bits>
+static __m128i reduceSSE2(__m128i x)
+{
+	constexpr short max = (1 << bits) - 1;
+	auto v = _mm_add_epi16(_mm_mullo_epi16(x, _mm_set1_epi16(max)), _mm_set1_epi16(127));
+	return _mm_srli_epi16(_mm_mulhi_epu16(v, _mm_set1_epi16(short(0x8081))), 7);
+}
+
+// Expands 8 RGB565 pixels into 16-bit lanes of the 8-bit components
+static void expand565SSE2(__m128i p, __m128i &r, __m128i &g, __m128i &b)
+{
+	r = expand5SSE2(_mm_srli_epi16(p, 11));
+	g = expand6SSE2(_mm_and_si128(_mm_srli_epi16(p, 5), _mm_set1_epi16(0x3F)));
+	b = expand5SSE2(_mm_and_si128(p, _mm_set1_epi16(0x1F)));
+}
+
+static __m128i pack565SSE2(__m128i r, __m128i g, __m128i b)
+{
+	return _mm_or_si128(_mm_or_si128(_mm_slli_epi16(reduceSSE2<5>(r), 11),
+		_mm_slli_epi16(reduceSSE2<6>(g), 5)), reduceSSE2<5>(b));
+}
+
+template <PixelConversion conv>
+static void convertRGB565ToRGBX8888SSE2(const uint8_t *src, uint8_t *dest, int n)
+{
+	int i = 0;
+	for(; i + 8 <= n; i += 8)
+	{
+		__m128i r, g, b;
+		expand565SSE2(_mm_loadu_si128((const __m128i*)(src + i * 2)), r, g, b);
+		if constexpr(conv == PixelConversion::RGB565ToBGRX8888)
+			std::swap(r, b);
+		auto lo = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+		auto d = (__m128i*)(dest + i * 4);
+		_mm_storeu_si128(d, _mm_unpacklo_epi16(lo, b));
+		_mm_storeu_si128(d + 1, _mm_unpackhi_epi16(lo, b));
+	}
+	convertLineScalar<conv>(src + i * 2, dest + i * 4, n - i);
+}
+
+template <PixelConversion conv>
+static void convertRGBX8888ToRGB565SSE2(const uint8_t *src, uint8_t *dest, int n)
+{
+	constexpr int rShift = conv == PixelConversion::BGRX8888ToRGB565 ? 16 : 0;
+	constexpr int bShift = 16 - rShift;
+	const auto byteMask = _mm_set1_epi32(0xFF);
+	int i = 0;
+	for(; i + 8 <= n; i += 8)
+	{
+		auto s = (const __m128i*)(src + i * 4);
+		auto p0 = _mm_loadu_si128(s), p1 = _mm_loadu_si128(s + 1);
+		auto component = [&](int shift)
+		{
+			return _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(p0, shift), byteMask),
+				_mm_and_si128(_mm_srli_epi32(p1, shift), byteMask));
+		};
+		_mm_storeu_si128((__m128i*)(dest + i * 2), pack565SSE2(component(rShift), component(8), component(bShift)));
+	}
+	convertLineScalar<conv>(src + i * 4, dest + i * 2, n - i);
+}
+
+static void convertRGBA8888ToBGRA8888SSE2(const uint8_t *src, uint8_t *dest, int n)
+{
+	const auto agMask = _mm_set1_epi32(0xFF00FF00);
+	int i = 0;
+	for(; i + 4 <= n; i += 4)
+	{
+		auto p = _mm_loadu_si128((const __m128i*)(src + i * 4));
+		auto rb = _mm_andnot_si128(agMask, p);
+		// swapping the 16-bit halves of each pixel exchanges the R & B bytes
+		rb = _mm_shufflehi_epi16(_mm_shufflelo_epi16(rb, 0xB1), 0xB1);
+		_mm_storeu_si128((__m128i*)(dest + i * 4), _mm_or_si128(_mm_and_si128(p, agMask), rb));
+	}
+	convertLineScalar<PixelConversion::RGBA8888ToBGRA8888>(src + i * 4, dest + i * 4, n - i);
+}
+
+template <PixelConversion conv>
+[[gnu::target("ssse3")]]
+static void convertRGB888ToRGBX8888SSSE3(const uint8_t *src, uint8_t *dest, int n)
+{
+	static constexpr bool swapRB = conv == PixelConversion::RGB888ToBGRX8888;
+	static constexpr auto maskVals = makeShuffleMask([](int i)
+	{
+		int px = i / 4, c = i % 4;
+		if(c == 3)
+			return -1;
+		return px * 3 + (swapRB ? c : 2 - c);
+	});
+	const auto mask = _mm_loadu_si128((const __m128i*)maskVals.data());
+	int i = 0;
+	// 16 byte loads of 4 pixels can't read past the end of the line
+	for(; i + 6 <= n; i += 4)
+	{
+		_mm_storeu_si128((__m128i*)(dest + i * 4), _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src + i * 3)), mask));
+	}
+	convertLineScalar<conv>(src + i * 3, dest + i * 4, n - i);
+}
+
+template <PixelConversion conv>
+[[gnu::target("ssse3")]]
+static void convertRGBX8888ToRGB888SSSE3(const uint8_t *src, uint8_t *dest, int n)
+{
+	static constexpr bool swapRB = conv == PixelConversion::BGRX8888ToRGB888;
+	static constexpr auto maskVals = makeShuffleMask([](int i)
+	{
+		if(i >= 12)
+			return -1;
+		int px = i / 3, c = i % 3;
+		return px * 4 + (swapRB ? 2 - c : c);
+	});
+	const auto mask = _mm_loadu_si128((const __m128i*)maskVals.data());
+	int i = 0;
+	for(; i + 4 <= n; i += 4)
+	{
+		auto v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src + i * 4)), mask);
+		auto d = dest + i * 3;
+		_mm_storel_epi64((__m128i*)d, v);
+		uint32_t last = _mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+		std::memcpy(d + 8, &last, 4);
+	}
+	convertLineScalar<conv>(src + i * 4, dest + i * 3, n - i);
+}
+
+[[gnu::target("ssse3")]]
+static void convertRGB565ToRGB888SSSE3(const uint8_t *src, uint8_t *dest, int n)
+{
+	// components are packed as bytes R0-7 G0-7 in the first vector and B0-7 in the second
+	static constexpr auto rgMaskVals = makeShuffleMask<32>([](int i)
+	{
+		int px = i / 3, c = i % 3;
+		return i >= 24 || c == 2 ? -1 : c * 8 + px;
+	});
+	static constexpr auto bMaskVals = makeShuffleMask<32>([](int i)
+	{
+		int px = i / 3, c = i % 3;
+		return i < 24 && c == 2 ? px : -1;
+	});
+	const __m128i rgMask[2]{_mm_loadu_si128((const __m128i*)rgMaskVals.data()), _mm_loadu_si128((const __m128i*)(rgMaskVals.data() + 16))};
+	const __m128i bMask[2]{_mm_loadu_si128((const __m128i*)bMaskVals.data()), _mm_loadu_si128((const __m128i*)(bMaskVals.data() + 16))};
+	int i = 0;
+	for(; i + 8 <= n; i += 8)
+	{
+		__m128i r, g, b;
+		expand565SSE2(_mm_loadu_si128((const __m128i*)(src + i * 2)), r, g, b);
+		auto rg = _mm_packus_epi16(r, g);
+		b = _mm_packus_epi16(b, b);
+		auto d = dest + i * 3;
+		_mm_storeu_si128((__m128i*)d, _mm_or_si128(_mm_shuffle_epi8(rg, rgMask[0]), _mm_shuffle_epi8(b, bMask[0])));
+		_mm_storel_epi64((__m128i*)(d + 16), _mm_or_si128(_mm_shuffle_epi8(rg, rgMask[1]), _mm_shuffle_epi8(b, bMask[1])));
+	}
+	convertLineScalar<PixelConversion::RGB565ToRGB888>(src + i * 2, dest + i * 3, n - i);
+}
+
+[[gnu::target("ssse3")]]
+static void convertRGB888ToRGB565SSSE3(const uint8_t *src, uint8_t *dest, int n)
+{
+	// 8 pixels span 24 bytes, loaded as bytes 0-15 and 8-23
+	constexpr auto componentMask = [](int c, bool second)
+	{
+		return makeShuffleMask([=](int i)
+		{
+			int idx = (i / 2) * 3 + c;
+			if(i % 2 || (idx < 16) == second)
+				return -1;
+			return second ? idx - 8 : idx;
+		});
+	};
+	static constexpr std::array<ShuffleMask<16>, 6> maskVals
+	{
+		componentMask(0, false), componentMask(0, true),
+		componentMask(1, false), componentMask(1, true),
+		componentMask(2, false), componentMask(2, true),
+	};
+	__m128i masks[6];
+	for(auto m : iotaCount(6))
+		masks[m] = _mm_loadu_si128((const __m128i*)maskVals[m].data());
+	int i = 0;
+	for(; i + 8 <= n; i += 8)
+	{
+		auto s = src + i * 3;
+		auto p0 = _mm_loadu_si128((const __m128i*)s), p1 = _mm_loadu_si128((const __m128i*)(s + 8));
+		auto r = _mm_or_si128(_mm_shuffle_epi8(p0, masks[0]), _mm_shuffle_epi8(p1, masks[1]));
+		auto g = _mm_or_si128(_mm_shuffle_epi8(p0, masks[2]), _mm_shuffle_epi8(p1, masks[3]));
+		auto b = _mm_or_si128(_mm_shuffle_epi8(p0, masks[4]), _mm_shuffle_epi8(p1, masks[5]));
+		_mm_storeu_si128((__m128i*)(dest + i * 2), pack565SSE2(r, g, b));
+	}
+	convertLineScalar<PixelConversion::RGB888ToRGB565>(src + i * 3, dest + i * 2, n - i);
+}
+
+// lambdas don't inherit the target attribute, so AVX2 helpers are separate functions
+template <short add, short mul, int shift>
+[[gnu::target("avx2")]]
+static __m256i expandAVX2(__m256i x)
+{
+	auto v = _mm256_add_epi16(_mm256_mullo_epi16(x, _mm256_set1_epi16(255)), _mm256_set1_epi16(add));
+	return _mm256_srli_epi16(_mm256_mulhi_epu16(v, _mm256_set1_epi16(mul)), shift);
+}
+
+template <short max>
+[[gnu::target("avx2")]]
+static __m256i reduceAVX2(__m256i x)
+{
+	auto v = _mm256_add_epi16(_mm256_mullo_epi16(x, _mm256_set1_epi16(max)), _mm256_set1_epi16(127));
+	return _mm256_srli_epi16(_mm256_mulhi_epu16(v, _mm256_set1_epi16(short(0x8081))), 7);
+}
+
+// packs one byte of 16 RGBX8888 pixels into 16-bit lanes
+template <int shift>
+[[gnu::target("avx2")]]
+static __m256i componentAVX2(__m256i p0, __m256i p1)
+{
+	const auto byteMask = _mm256_set1_epi32(0xFF);
+	return _mm256_packs_epi32(_mm256_and_si256(_mm256_srli_epi32(p0, shift), byteMask),
+		_mm256_and_si256(_mm256_srli_epi32(p1, shift), byteMask));
+}
+
+template <PixelConversion conv>
+[[gnu::target("avx2")]]
+static void convertRGB565ToRGBX8888AVX2(const uint8_t *src, uint8_t *dest, int n)
+{
+	int i = 0;
+	for(; i + 16 <= n; i += 16)
+	{
+		auto p = _mm256_loadu_si256((const __m256i*)(src + i * 2));
+		auto r = expandAVX2<15, 4229, 1>(_mm256_srli_epi16(p, 11));
+		auto g = expandAVX2<31, 8323, 3>(_mm256_and_si256(_mm256_srli_epi16(p, 5), _mm256_set1_epi16(0x3F)));
+		auto b = expandAVX2<15, 4229, 1>(_mm256_and_si256(p, _mm256_set1_epi16(0x1F)));
+		if constexpr(conv == PixelConversion::RGB565ToBGRX8888)
+			std::swap(r, b);
+		auto lo = _mm256_or_si256(r, _mm256_slli_epi16(g, 8));
+		// unpacks work within each 128-bit lane, so the lanes are put back in order when storing
+		auto q0 = _mm256_unpacklo_epi16(lo, b), q1 = _mm256_unpackhi_epi16(lo, b);
+		auto d = (__m256i*)(dest + i * 4);
+		_mm256_storeu_si256(d, _mm256_permute2x128_si256(q0, q1, 0x20));
+		_mm256_storeu_si256(d + 1, _mm256_permute2x128_si256(q0, q1, 0x31));
+	}
+	convertLineScalar<conv>(src + i * 2, dest + i * 4, n - i);
+}
+
+template <PixelConversion conv>
+[[gnu::target("avx2")]]
+static void convertRGBX8888ToRGB565AVX2(const uint8_t *src, uint8_t *dest, int n)
+{
+	constexpr int rShift = conv == PixelConversion::BGRX8888ToRGB565 ? 16 : 0;
+	constexpr int bShift = 16 - rShift;
+	int i = 0;
+	for(; i + 16 <= n; i += 16)
+	{
+		auto s = (const __m256i*)(src + i * 4);
+		auto p0 = _mm256_loadu_si256(s), p1 = _mm256_loadu_si256(s + 1);
+		auto r = reduceAVX2<31>(componentAVX2<rShift>(p0, p1));
+		auto g = reduceAVX2<63>(componentAVX2<8>(p0, p1));
+		auto b = reduceAVX2<31>(componentAVX2<bShift>(p0, p1));
+		auto p = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(r, 11), _mm256_slli_epi16(g, 5)), b);
+		// packs interleave the 64-bit halves of each source
+		_mm256_storeu_si256((__m256i*)(dest + i * 2), _mm256_permute4x64_epi64(p, 0xD8));
+	}
+	convertLineScalar<conv>(src + i * 4, dest + i * 2, n - i);
+}
+
+[[gnu::target("avx2")]]
+static void convertRGBA8888ToBGRA8888AVX2(const uint8_t *src, uint8_t *dest, int n)
+{
+	const auto agMask = _mm256_set1_epi32(0xFF00FF00);
+	int i = 0;
+	for(; i + 8 <= n; i += 8)
+	{
+		auto p = _mm256_loadu_si256((const __m256i*)(src + i * 4));
+		auto rb = _mm256_andnot_si256(agMask, p);
+		rb = _mm256_or_si256(_mm256_slli_epi32(rb, 16), _mm256_srli_epi32(rb, 16));
+		_mm256_storeu_si256((__m256i*)(dest + i * 4), _mm256_or_si256(_mm256_and_si256(p, agMask), rb));
+	}
+	convertLineScalar<PixelConversion::RGBA8888ToBGRA8888>(src + i * 4, dest + i * 4, n - i);
+}
+#endif
+
+#ifdef IG_PIXMAP_NEON_SIMD
+// saturating doubling multiply high gives the same results as an unsigned multiply high,
+// plus one more bit, since the inputs stay below 2^15
+template <uint16_t add, int16_t mul, int shift>
+static uint8x8_t expand565ComponentNEON(uint16x8_t x)
+{
+	auto v = vreinterpretq_s16_u16(vmlaq_n_u16(vdupq_n_u16(add), x, 255));
+	return vmovn_u16(vshrq_n_u16(vreinterpretq_u16_s16(vqdmulhq_n_s16(v, mul)), shift));
+}
+
+static uint8x8x3_t expand565NEON(uint16x8_t p)
+{
+	return
+	{{
+		expand565ComponentNEON<15, 4229, 2>(vshrq_n_u16(p, 11)),
+		expand565ComponentNEON<31, 8323, 4>(vandq_u16(vshrq_n_u16(p, 5), vdupq_n_u16(0x3F))),
+		expand565ComponentNEON<15, 4229, 2>(vandq_u16(p, vdupq_n_u16(0x1F))),
+	}};
+}
+
+// v / 255 computed as (v + (v >> 8) + 1) >> 8
+static uint16x8_t reduceNEON(uint8x8_t x, uint8_t max)
+{
+	auto v = vmlal_u8(vdupq_n_u16(127), x, vdup_n_u8(max));
+	return vshrq_n_u16(vaddq_u16(vsraq_n_u16(v, v, 8), vdupq_n_u16(1)), 8);
+}
+
+static uint16x8_t pack565NEON(uint8x8_t r, uint8x8_t g, uint8x8_t b)
+{
+	return vorrq_u16(vorrq_u16(vshlq_n_u16(reduceNEON(r, 31), 11), vshlq_n_u16(reduceNEON(g, 63), 5)), reduceNEON(b, 31));
+}
+
+template <PixelConversion conv>
+static void convertLineNEON(const uint8_t *src, uint8_t *dest, int n)
+{
+	using enum PixelConversion;
+	constexpr bool srcIs565 = conv == RGB565ToRGBX8888 || conv == RGB565ToBGRX8888 || conv == RGB565ToRGB888;
+	constexpr bool srcIs888 = conv == RGB888ToRGBX8888 || conv == RGB888ToBGRX8888 || conv == RGB888ToRGB565;
+	constexpr int srcBytes = srcIs565 ? 2 : srcIs888 ? 3 : 4;
+	constexpr bool destIs565 = conv == RGB888ToRGB565 || conv == RGBX8888ToRGB565 || conv == BGRX8888ToRGB565;
+	constexpr bool destIs888 = conv == RGB565ToRGB888 || conv == RGBX8888ToRGB888 || conv == BGRX8888ToRGB888;
+	constexpr int destBytes = destIs565 ? 2 : destIs888 ? 3 : 4;
+	[[maybe_unused]] const auto zero = vdup_n_u8(0);
+	int i = 0;
+	for(; i + 8 <= n; i += 8)
+	{
+		auto s = src + i * srcBytes;
+		auto d = dest + i * destBytes;
+		if constexpr(conv == RGB565ToRGBX8888 || conv == RGB565ToBGRX8888)
+		{
+			auto c = expand565NEON(vld1q_u16((const uint16_t*)s));
+			if constexpr(conv == RGB565ToBGRX8888)
+				std::swap(c.val[0], c.val[2]);
+			vst4_u8(d, uint8x8x4_t{{c.val[0], c.val[1], c.val[2], zero}});
+		}
+		else if constexpr(conv == RGB565ToRGB888)
+		{
+			vst3_u8(d, expand565NEON(vld1q_u16((const uint16_t*)s)));
+		}
+		else if constexpr(conv == RGB888ToRGBX8888 || conv == RGB888ToBGRX8888)
+		{
+			auto c = vld3_u8(s);
+			if constexpr(conv == RGB888ToRGBX8888)
+				std::swap(c.val[0], c.val[2]);
+			vst4_u8(d, uint8x8x4_t{{c.val[0], c.val[1], c.val[2], zero}});
+		}
+		else if constexpr(conv == RGB888ToRGB565)
+		{
+			auto c = vld3_u8(s);
+			vst1q_u16((uint16_t*)d, pack565NEON(c.val[0], c.val[1], c.val[2]));
+		}
+		else if constexpr(conv == RGBX8888ToRGB565 || conv == BGRX8888ToRGB565)
+		{
+			auto c = vld4_u8(s);
+			if constexpr(conv == BGRX8888ToRGB565)
+				std::swap(c.val[0], c.val[2]);
+			vst1q_u16((uint16_t*)d, pack565NEON(c.val[0], c.val[1], c.val[2]));
+		}
+		else if constexpr(conv == RGBX8888ToRGB888 || conv == BGRX8888ToRGB888)
+		{
+			auto c = vld4_u8(s);
+			if constexpr(conv == BGRX8888ToRGB888)
+				std::swap(c.val[0], c.val[2]);
+			vst3_u8(d, uint8x8x3_t{{c.val[0], c.val[1], c.val[2]}});
+		}
+		else if constexpr(conv == RGBA8888ToBGRA8888)
+		{
+			auto c = vld4_u8(s);
+			std::swap(c.val[0], c.val[2]);
+			vst4_u8(d, c);
+		}
+	}
+	convertLineScalar<conv>(src + i * srcBytes, dest + i * destBytes, n - i);
+}
+#endif
+
+using ConvertLineFunc = void(*)(const uint8_t *src, uint8_t *dest, int n);
+
+template <PixelConversion conv>
+static ConvertLineFunc convertLineFunc()
+{
+	using enum PixelConversion;
+	#if defined IG_PIXMAP_X86_SIMD
+	if constexpr(conv == RGB565ToRGBX8888 || conv == RGB565ToBGRX8888)
+		return cpuHasAVX2() ? convertRGB565ToRGBX8888AVX2<conv> : convertRGB565ToRGBX8888SSE2<conv>;
+	else if constexpr(conv == RGBX8888ToRGB565 || conv == BGRX8888ToRGB565)
+		return cpuHasAVX2() ? convertRGBX8888ToRGB565AVX2<conv> : convertRGBX8888ToRGB565SSE2<conv>;
+	else if constexpr(conv == RGBA8888ToBGRA8888)
+		return cpuHasAVX2() ? convertRGBA8888ToBGRA8888AVX2 : convertRGBA8888ToBGRA8888SSE2;
+	else if(cpuHasSSSE3())
+	{
+		if constexpr(conv == RGB888ToRGBX8888 || conv == RGB888ToBGRX8888)
+			return convertRGB888ToRGBX8888SSSE3<conv>;
+		else if constexpr(conv == RGBX8888ToRGB888 || conv == BGRX8888ToRGB888)
+			return convertRGBX8888ToRGB888SSSE3<conv>;
+		else if constexpr(conv == RGB565ToRGB888)
+			return convertRGB565ToRGB888SSSE3;
+		else if constexpr(conv == RGB888ToRGB565)
+			return convertRGB888ToRGB565SSSE3;
+	}
+	#elif defined IG_PIXMAP_NEON_SIMD
+	return convertLineNEON<conv>;
+	#endif
+	return convertLineScalar<conv>;
+}
+
+static void visitConversion(PixelConversion conv, auto &&func)
+{
+	switch(conv)
+	{
+		#define CASE(c) case PixelConversion::c: return func.template operator()<PixelConversion::c>();
+		CASE(RGB565ToRGBX8888) CASE(RGB565ToBGRX8888) CASE(RGB565ToRGB888)
+		CASE(RGB888ToRGBX8888) CASE(RGB888ToBGRX8888) CASE(RGB888ToRGB565)
+		CASE(RGBX8888ToRGB565) CASE(BGRX8888ToRGB565) CASE(RGBX8888ToRGB888)
+		CASE(BGRX8888ToRGB888) CASE(RGBA8888ToBGRA8888)
+		#undef CASE
+	}
+	bug_unreachable("invalid PixelConversion:%d", int(conv));
+}
+
+void convertPixels(PixelConversion conv, const void *src, void *dest, int pixels)
+{
+	visitConversion(conv, [&]<PixelConversion c>(){ convertLineFunc<c>()((const uint8_t*)src, (uint8_t*)dest, pixels); });
+}
+
+void convertPixelsScalar(PixelConversion conv, const void *src, void *dest, int pixels)
+{
+	visitConversion(conv, [&]<PixelConversion c>(){ convertLineScalar<c>((const uint8_t*)src, (uint8_t*)dest, pixels); });
+}
+
+// Indexed color expansion
+
+template <class T>
+static void lookupLine(T *dest, const uint8_t *src, int n, const T *palette)
+{
+	int i = 0;
+	// unrolled so the table loads can overlap
+	for(; i + 4 <= n; i += 4)
+	{
+		T p0 = palette[src[i]];
+		T p1 = palette[src[i + 1]];
+		T p2 = palette[src[i + 2]];
+		T p3 = palette[src[i + 3]];
+		dest[i] = p0;
+		dest[i + 1] = p1;
+		dest[i + 2] = p2;
+		dest[i + 3] = p3;
+	}
+	for(; i < n; i++)
+	{
+		dest[i] = palette[src[i]];
+	}
+}
+
+#ifdef IG_PIXMAP_X86_SIMD
+// 32-bit gathers from a full 256 entry table so any index stays in bounds,
+// 16-bit palettes are widened and the results packed back down
+[[gnu::target("avx2")]]
+static __m256i gather8AVX2(const uint32_t *table, const uint8_t *src)
+{
+	return _mm256_i32gather_epi32((const int*)table, _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)src)), 4);
+}
+
+template <class T>
+[[gnu::target("avx2")]]
+static void lookupLineAVX2(T *dest, const uint8_t *src, int n, const uint32_t *table, const T *palette)
+{
+	int i = 0;
+	for(; i + 16 <= n; i += 16)
+	{
+		auto p0 = gather8AVX2(table, src + i);
+		auto p1 = gather8AVX2(table, src + i + 8);
+		auto d = (__m256i*)(dest + i);
+		if constexpr(sizeof(T) == 2)
+		{
+			// packing works within each 128-bit lane, so the 64-bit quarters are put back in order
+			_mm256_storeu_si256(d, _mm256_permute4x64_epi64(_mm256_packus_epi32(p0, p1), 0xD8));
+		}
+		else
+		{
+			_mm256_storeu_si256(d, p0);
+			_mm256_storeu_si256(d + 1, p1);
+		}
+	}
+	lookupLine(dest + i, src + i, n - i, palette);
+}
+#endif
+
+#if defined IG_PIXMAP_NEON_SIMD && defined __aarch64__
+// Palette split into per-byte planes of the output pixels for use as tbl tables
+template <class T>
+struct LookupPlanes
+{
+	alignas(16) std::array<std::array<uint8_t, 256>, sizeof(T)> planes{};
+
+	constexpr LookupPlanes(std::span<const T> palette)
+	{
+		for(auto i : iotaCount(palette.size()))
+		{
+			for(auto b : iotaCount(sizeof(T)))
+			{
+				planes[b][i] = palette[i] >> (b * 8);
+			}
+		}
+	}
+};
+
+// Full 256 entry lookup by chaining 64 byte table lookups, each returning 0 or leaving the
+// previous result for indices out of its range
+template <class T>
+static void lookupLineNEON(T *dest, const uint8_t *src, int n, const LookupPlanes<T> &t, const T *palette)
+{
+	auto lookupPlane = [&](int plane, uint8x16_t idx0)
+	{
+		const auto offset = vdupq_n_u8(64);
+		auto table = t.planes[plane].data();
+		auto v = vqtbl4q_u8(vld1q_u8_x4(table), idx0);
+		auto idx = vsubq_u8(idx0, offset);
+		v = vqtbx4q_u8(v, vld1q_u8_x4(table + 64), idx);
+		idx = vsubq_u8(idx, offset);
+		v = vqtbx4q_u8(v, vld1q_u8_x4(table + 128), idx);
+		idx = vsubq_u8(idx, offset);
+		return vqtbx4q_u8(v, vld1q_u8_x4(table + 192), idx);
+	};
+	int i = 0;
+	for(; i + 16 <= n; i += 16)
+	{
+		auto idx = vld1q_u8(src + i);
+		if constexpr(sizeof(T) == 2)
+		{
+			vst2q_u8((uint8_t*)(dest + i), uint8x16x2_t{{lookupPlane(0, idx), lookupPlane(1, idx)}});
+		}
+		else
+		{
+			vst4q_u8((uint8_t*)(dest + i), uint8x16x4_t{{lookupPlane(0, idx), lookupPlane(1, idx),
+				lookupPlane(2, idx), lookupPlane(3, idx)}});
+		}
+	}
+	lookupLine(dest + i, src + i, n - i, palette);
+}
+#endif
+
+template <class T>
+static void forEachIndexedLine(T *dest, int destPitchPx, const uint8_t *src, int srcPitchPx, WSize size, auto &&lineFunc)
+{
+	if(size.x == destPitchPx && size.x == srcPitchPx)
+	{
+		lineFunc(dest, src, size.x * size.y);
+		return;
+	}
+	for(auto y : iotaCount(size.y))
+	{
+		lineFunc(dest, src, size.x);
+		dest += destPitchPx;
+		src += srcPitchPx;
+	}
+}
+
+template <class T>
+static void writeIndexedPixelsImpl(T *dest, int destPitchPx, const uint8_t *src, int srcPitchPx, WSize size, std::span<const T> palette)
+{
+	assumeExpr(palette.size() <= 256);
+	auto forEachLine = [&](auto &&lineFunc){ forEachIndexedLine(dest, destPitchPx, src, srcPitchPx, size, lineFunc); };
+	#if defined IG_PIXMAP_X86_SIMD
+	if(cpuHasAVX2())
+	{
+		alignas(32) std::array<uint32_t, 256> table{};
+		std::ranges::copy(palette, table.begin());
+		return forEachLine([&](T *d, const uint8_t *s, int n){ lookupLineAVX2(d, s, n, table.data(), palette.data()); });
+	}
+	#elif defined IG_PIXMAP_NEON_SIMD && defined __aarch64__
+	const LookupPlanes<T> planes{palette};
+	return forEachLine([&](T *d, const uint8_t *s, int n){ lookupLineNEON(d, s, n, planes, palette.data()); });
+	#endif
+	forEachLine([&](T *d, const uint8_t *s, int n){ lookupLine(d, s, n, palette.data()); });
+}
+
+void writeIndexedPixels(uint16_t *dest, int destPitchPx, const uint8_t *src, int srcPitchPx, WSize size, std::span<const uint16_t> palette)
+{
+	writeIndexedPixelsImpl(dest, destPitchPx, src, srcPitchPx, size, palette);
+}
+
+void writeIndexedPixels(uint32_t *dest, int destPitchPx, const uint8_t *src, int srcPitchPx, WSize size, std::span<const uint32_t> palette)
+{
+	writeIndexedPixelsImpl(dest, destPitchPx, src, srcPitchPx, size, palette);
+}
+
 }
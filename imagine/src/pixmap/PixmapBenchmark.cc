@@ -0,0 +1,94 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/pixmap/PixmapBenchmark.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <random>
+
+namespace IG
+{
+
+constexpr SystemLogger log{"PixmapBench"};
+
+static int srcPixelBytes(PixelConversion conv)
+{
+	using enum PixelConversion;
+	switch(conv)
+	{
+		case RGB565ToRGBX8888:
+		case RGB565ToBGRX8888:
+		case RGB565ToRGB888: return 2;
+		case RGB888ToRGBX8888:
+		case RGB888ToBGRX8888:
+		case RGB888ToRGB565: return 3;
+		default: return 4;
+	}
+}
+
+static FloatSeconds timeConversion(auto &&convertFunc, PixelConversion conv, const uint8_t *src, uint8_t *dest, int pixels, int iterations)
+{
+	auto start = SteadyClock::now();
+	for([[maybe_unused]] auto i : iotaCount(iterations))
+	{
+		convertFunc(conv, src, dest, pixels);
+	}
+	return duration_cast<FloatSeconds>(SteadyClock::now() - start) / iterations;
+}
+
+std::vector<PixelConversionBenchmark> benchmarkPixelConversions(WSize frameSize, int iterations)
+{
+	const int pixels = std::max(frameSize.x * frameSize.y, 0x10000);
+	constexpr int maxPixelBytes = 4;
+	std::minstd_rand rng;
+	std::vector<uint8_t> src(pixels * maxPixelBytes);
+	std::ranges::generate(src, [&]{ return uint8_t(rng()); });
+	std::vector<uint8_t> simdDest(pixels * maxPixelBytes), scalarDest(pixels * maxPixelBytes);
+	std::vector<PixelConversionBenchmark> results;
+	for(auto [conv, name] : wise_enum::range<PixelConversion>)
+	{
+		auto convSrc = src;
+		if(srcPixelBytes(conv) == 2)
+		{
+			for(auto i : iotaCount(0x10000))
+				reinterpret_cast<uint16_t*>(convSrc.data())[i] = i;
+		}
+		// compare full runs and ones offset & shortened to exercise unaligned data and tail handling
+		bool bitExact = true;
+		for(auto offset : {0, 1})
+		{
+			std::ranges::fill(simdDest, 0);
+			std::ranges::fill(scalarDest, 0);
+			auto bytes = srcPixelBytes(conv) * offset;
+			convertPixels(conv, convSrc.data() + bytes, simdDest.data() + offset, pixels - offset * 3);
+			convertPixelsScalar(conv, convSrc.data() + bytes, scalarDest.data() + offset, pixels - offset * 3);
+			bitExact &= simdDest == scalarDest;
+		}
+		PixelConversionBenchmark result
+		{
+			.conversion = conv,
+			.bitExact = bitExact,
+			.simdTime = timeConversion(convertPixels, conv, convSrc.data(), simdDest.data(), frameSize.x * frameSize.y, iterations),
+			.scalarTime = timeConversion(convertPixelsScalar, conv, convSrc.data(), scalarDest.data(), frameSize.x * frameSize.y, iterations),
+		};
+		if(!bitExact)
+			log.error("{} output doesn't match scalar reference", name);
+		log.info("{}: {:.2f}us SIMD, {:.2f}us scalar", name, result.simdTime.count() * 1e6, result.scalarTime.count() * 1e6);
+		results.emplace_back(result);
+	}
+	return results;
+}
+
+}
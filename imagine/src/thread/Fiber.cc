@@ -0,0 +1,283 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/thread/Fiber.hh>
+#include <imagine/vmem/memory.hh>
+#include <imagine/util/utility.h>
+#include <imagine/logger/logger.h>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+
+// Saves the callee-saved registers on the current stack, stores the stack pointer in *saveSP,
+// then loads the registers saved on loadSP and returns to the code that saved them
+extern "C" void IG_switchFiber(void **saveSP, void *loadSP);
+// Initial return address of a new fiber, calls the entry function in one callee-saved register
+// with the argument in another, which is never expected to return
+extern "C" void IG_startFiber();
+
+#if defined __APPLE__ || (defined _WIN32 && defined __i386__)
+#define IG_FIBER_SYM(name) "_" #name
+#else
+#define IG_FIBER_SYM(name) #name
+#endif
+
+#if defined __ELF__
+#define IG_FIBER_FUNC(name) \
+	".globl " IG_FIBER_SYM(name) "\n" \
+	".hidden " IG_FIBER_SYM(name) "\n" \
+	".type " IG_FIBER_SYM(name) ", %function\n" \
+	IG_FIBER_THUMB_FUNC \
+	IG_FIBER_SYM(name) ":\n"
+#define IG_FIBER_FUNC_END(name) ".size " IG_FIBER_SYM(name) ", .-" IG_FIBER_SYM(name) "\n"
+#elif defined __APPLE__
+#define IG_FIBER_FUNC(name) \
+	".globl " IG_FIBER_SYM(name) "\n" \
+	".private_extern " IG_FIBER_SYM(name) "\n" \
+	IG_FIBER_THUMB_FUNC \
+	IG_FIBER_SYM(name) ":\n"
+#define IG_FIBER_FUNC_END(name) ""
+#else
+#define IG_FIBER_FUNC(name) ".globl " IG_FIBER_SYM(name) "\n" IG_FIBER_SYM(name) ":\n"
+#define IG_FIBER_FUNC_END(name) ""
+#endif
+
+#if defined __arm__ && defined __thumb__
+#define IG_FIBER_THUMB_FUNC ".thumb_func\n"
+#else
+#define IG_FIBER_THUMB_FUNC ""
+#endif
+
+#if defined __x86_64__
+asm(
+	".text\n"
+	".p2align 4\n"
+	IG_FIBER_FUNC(IG_switchFiber)
+	"pushq %rbp\n"
+	"pushq %rbx\n"
+	"pushq %r12\n"
+	"pushq %r13\n"
+	"pushq %r14\n"
+	"pushq %r15\n"
+	"movq %rsp, (%rdi)\n"
+	"movq %rsi, %rsp\n"
+	"popq %r15\n"
+	"popq %r14\n"
+	"popq %r13\n"
+	"popq %r12\n"
+	"popq %rbx\n"
+	"popq %rbp\n"
+	"retq\n"
+	IG_FIBER_FUNC_END(IG_switchFiber)
+	".p2align 4\n"
+	IG_FIBER_FUNC(IG_startFiber)
+	"movq %rbx, %rdi\n"
+	"andq $-16, %rsp\n"
+	"callq *%r12\n"
+	"ud2\n"
+	IG_FIBER_FUNC_END(IG_startFiber)
+);
+
+// registers in the order IG_switchFiber() pops them, followed by the return address
+struct FiberStackFrame
+{
+	std::array<uintptr_t, 3> r15To13{};
+	uintptr_t func{}; // r12
+	uintptr_t arg{}; // rbx
+	uintptr_t rbp{};
+	uintptr_t returnAddr{};
+};
+#elif defined __i386__
+asm(
+	".text\n"
+	".p2align 4\n"
+	IG_FIBER_FUNC(IG_switchFiber)
+	"movl 4(%esp), %eax\n"
+	"movl 8(%esp), %edx\n"
+	"pushl %ebp\n"
+	"pushl %ebx\n"
+	"pushl %esi\n"
+	"pushl %edi\n"
+	"movl %esp, (%eax)\n"
+	"movl %edx, %esp\n"
+	"popl %edi\n"
+	"popl %esi\n"
+	"popl %ebx\n"
+	"popl %ebp\n"
+	"retl\n"
+	IG_FIBER_FUNC_END(IG_switchFiber)
+	".p2align 4\n"
+	IG_FIBER_FUNC(IG_startFiber)
+	"andl $-16, %esp\n"
+	"subl $12, %esp\n"
+	"pushl %ebx\n"
+	"calll *%esi\n"
+	"ud2\n"
+	IG_FIBER_FUNC_END(IG_startFiber)
+);
+
+struct FiberStackFrame
+{
+	uintptr_t edi{};
+	uintptr_t func{}; // esi
+	uintptr_t arg{}; // ebx
+	uintptr_t ebp{};
+	uintptr_t returnAddr{};
+};
+#elif defined __aarch64__
+asm(
+	".text\n"
+	".p2align 2\n"
+	IG_FIBER_FUNC(IG_switchFiber)
+	"sub sp, sp, #160\n"
+	"stp x19, x20, [sp, #0]\n"
+	"stp x21, x22, [sp, #16]\n"
+	"stp x23, x24, [sp, #32]\n"
+	"stp x25, x26, [sp, #48]\n"
+	"stp x27, x28, [sp, #64]\n"
+	"stp x29, x30, [sp, #80]\n"
+	"stp d8, d9, [sp, #96]\n"
+	"stp d10, d11, [sp, #112]\n"
+	"stp d12, d13, [sp, #128]\n"
+	"stp d14, d15, [sp, #144]\n"
+	"mov x2, sp\n"
+	"str x2, [x0]\n"
+	"mov sp, x1\n"
+	"ldp x19, x20, [sp, #0]\n"
+	"ldp x21, x22, [sp, #16]\n"
+	"ldp x23, x24, [sp, #32]\n"
+	"ldp x25, x26, [sp, #48]\n"
+	"ldp x27, x28, [sp, #64]\n"
+	"ldp x29, x30, [sp, #80]\n"
+	"ldp d8, d9, [sp, #96]\n"
+	"ldp d10, d11, [sp, #112]\n"
+	"ldp d12, d13, [sp, #128]\n"
+	"ldp d14, d15, [sp, #144]\n"
+	"add sp, sp, #160\n"
+	"ret\n"
+	IG_FIBER_FUNC_END(IG_switchFiber)
+	".p2align 2\n"
+	IG_FIBER_FUNC(IG_startFiber)
+	"mov x0, x19\n"
+	"blr x20\n"
+	"brk #0\n"
+	IG_FIBER_FUNC_END(IG_startFiber)
+);
+
+struct FiberStackFrame
+{
+	uintptr_t arg{}; // x19
+	uintptr_t func{}; // x20
+	std::array<uintptr_t, 8> x21To28{};
+	uintptr_t fp{};
+	uintptr_t returnAddr{}; // x30
+	std::array<uint64_t, 8> d8To15{};
+};
+#elif defined __arm__
+// r3 is pushed only to keep the stack 8-byte aligned
+asm(
+	".text\n"
+	".syntax unified\n"
+	#ifdef __thumb__
+	".thumb\n"
+	#else
+	".arm\n"
+	#endif
+	".p2align 2\n"
+	IG_FIBER_FUNC(IG_switchFiber)
+	"push {r3-r11, lr}\n"
+	"vpush {d8-d15}\n"
+	"mov r2, sp\n"
+	"str r2, [r0]\n"
+	"mov sp, r1\n"
+	"vpop {d8-d15}\n"
+	"pop {r3-r11, pc}\n"
+	IG_FIBER_FUNC_END(IG_switchFiber)
+	".p2align 2\n"
+	IG_FIBER_FUNC(IG_startFiber)
+	"mov r0, r4\n"
+	"blx r5\n"
+	"bkpt #0\n"
+	IG_FIBER_FUNC_END(IG_startFiber)
+);
+
+struct FiberStackFrame
+{
+	std::array<uint64_t, 8> d8To15{};
+	uintptr_t r3{};
+	uintptr_t arg{}; // r4
+	uintptr_t func{}; // r5
+	std::array<uintptr_t, 6> r6To11{};
+	uintptr_t returnAddr{}; // lr
+};
+#else
+#error "Fiber context switching not implemented for this CPU architecture"
+#endif
+
+namespace IG
+{
+
+constexpr SystemLogger log{"Fiber"};
+
+Fiber::Fiber(EntryDelegate entry, size_t stackSize_):
+	stackSize{adjustVMemAllocSize(stackSize_)},
+	entry{entry}
+{
+	stack = allocVMem(stackSize);
+	if(!stack) [[unlikely]]
+		throw std::runtime_error("Error allocating fiber stack");
+	auto stackTop = (reinterpret_cast<uintptr_t>(stack) + stackSize) & ~uintptr_t(15);
+	auto frame = reinterpret_cast<FiberStackFrame*>(stackTop) - 1;
+	*frame = {};
+	frame->arg = reinterpret_cast<uintptr_t>(this);
+	frame->func = reinterpret_cast<uintptr_t>(&Fiber::run);
+	frame->returnAddr = reinterpret_cast<uintptr_t>(&IG_startFiber);
+	fiberSP = frame;
+	log.info("created fiber with {} byte stack", stackSize);
+}
+
+Fiber::~Fiber()
+{
+	assert(!running);
+	freeVMem(stack, stackSize);
+}
+
+void Fiber::resume()
+{
+	assert(stack);
+	assert(!running);
+	if(finished)
+		return;
+	running = true;
+	IG_switchFiber(&callerSP, fiberSP);
+}
+
+void Fiber::yield()
+{
+	assert(running);
+	running = false;
+	IG_switchFiber(&fiberSP, callerSP);
+}
+
+void Fiber::run(Fiber *fiber)
+{
+	fiber->entry();
+	fiber->finished = true;
+	fiber->yield();
+	bug_unreachable("resumed finished fiber");
+}
+
+}
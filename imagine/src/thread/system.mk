@@ -1,6 +1,8 @@
 ifndef inc_thread
 inc_thread := 1
 
-SRC += thread/thread.cc
+include $(imagineSrcDir)/vmem/system.mk
+
+SRC += thread/thread.cc thread/Fiber.cc
 
 endif